@@ -0,0 +1,330 @@
+// 적재·열 너비·목록 출력·검색·순위 검색·상세 조회·의존 관계 벤치마크 (가상 터미널, 네트워크 불필요)
+// 사용법: app_bench STATUS LISTS_DIR [ROUNDS]
+// 측정 항목마다 JSON 한 줄을 출력 (시간 단위는 마이크로초):
+//   {"bench":"load","packages":10000,"runs":21,"median_us":...,"p99_us":...}
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <ncurses.h>
+#include "../src/package_manager.h"
+#include "../src/package_list.h"
+#include "../src/apt_index.h"
+#include "../src/detail_cache.h"
+#include "../src/dep_graph.h"
+#include "../src/config.h"
+#include "../src/utils.h"
+#include "../src/ui.h"
+
+#define DEFAULT_ROUNDS 21
+#define RENDER_FRAMES 200         // 커서 이동 프레임 수
+#define DETAIL_ENTRIES 2048       // 캐시에 넣어 둘 상세 정보 수
+#define DETAIL_BATCH 256
+#define TEXT_BUILD_ROUNDS 3       // 전문 색인 구성은 목록 파일을 다시 읽으므로 몇 번만
+#define DEP_QUERIES 64            // 라운드마다 삭제 영향·설치 이유를 묻는 패키지 수          // 시간 측정 한 번에 조회하는 수 (타이머 해상도보다 길게)
+#define BENCH_ROWS 50
+#define BENCH_COLS 160
+
+static const char *queries[] = { "lib", "python3", "gtk-dev", "documentation", "a", "zzzz" };
+static const char *rankedQueries[] = { "python", "text editor", "compression library", "network daemon", "zzzz" };
+
+static uint64_t rngState = 0x853c49e6748fea9bull;
+
+static uint32_t nextRandom(void) {
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return (uint32_t)((rngState * 2685821657736338717ull) >> 32);
+}
+
+static double nowUs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static int compareDouble(const void *a, const void *b) {
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+// 표본을 정렬해 중앙값과 99번째 백분위수(최근접 순위)를 출력
+static void report(const char *bench, int packages, double *samples, int count) {
+    qsort(samples, count, sizeof(double), compareDouble);
+    int p99 = (count * 99 + 99) / 100 - 1;
+    printf("{\"bench\":\"%s\",\"packages\":%d,\"runs\":%d,\"median_us\":%.2f,\"p99_us\":%.2f}\n",
+           bench, packages, count, samples[count / 2], samples[p99 < 0 ? 0 : p99]);
+    fflush(stdout);
+}
+
+static void benchLoad(PackageStore *store, int rounds, double *samples) {
+    for (int r = 0; r < rounds; r++) {
+        storeFree(store);
+        storeInit(store);
+        double start = nowUs();
+        loadPackages(store);
+        samples[r] = nowUs() - start;
+    }
+    report("load", store->count, samples, rounds);
+}
+
+// 열 너비 히스토그램을 처음부터 다시 계산 (적재 시 하는 일과 같음)
+static void benchLayout(PackageStore *store, int rounds, double *samples) {
+    for (int r = 0; r < rounds; r++) {
+        double start = nowUs();
+        memset(&store->layout, 0, sizeof(store->layout));
+        for (int i = 0; i < store->count; i++) storeTrackWidths(store, &store->items[i]);
+        samples[r] = nowUs() - start;
+    }
+    report("layout", store->count, samples, rounds);
+}
+
+// 출력을 /dev/null로 보내는 가상 터미널에 목록을 그림
+static void benchRender(PackageStore *store, int rounds, double *samples) {
+    PackageList list;
+    double *steps = (double *)malloc(RENDER_FRAMES * sizeof(double));
+    if (!steps) return;
+
+    listInit(&list, store);
+    for (int r = 0; r < rounds; r++) {
+        // 화면 전체 (검색 결과·필터 변경 후와 같은 경우)
+        invalidateFrame();
+        double start = nowUs();
+        displayPackages(&list);
+        samples[r] = nowUs() - start;
+    }
+    report("render_full", store->count, samples, rounds);
+
+    // 커서 이동: 처음 화면 안에서는 두 줄, 이후에는 한 줄 스크롤
+    invalidateFrame();
+    list.currIndex = list.startIndex = 0;
+    displayPackages(&list);
+    int frames = 0;
+    for (; frames < RENDER_FRAMES && list.currIndex + 1 < list.viewCount; frames++) {
+        double start = nowUs();
+        list.currIndex++;
+        listScrollToCursor(&list, listVisibleRows());
+        displayPackages(&list);
+        steps[frames] = nowUs() - start;
+    }
+    if (frames > 0) report("render_step", store->count, steps, frames);
+
+    listFree(&list);
+    free(steps);
+}
+
+static void benchSearch(const char *listsDir, const PackageStore *installed, int rounds, double *samples,
+                        AptIndex *index) {
+    int queryCount = (int)(sizeof(queries) / sizeof(queries[0]));
+    double *all = (double *)malloc((size_t)rounds * queryCount * sizeof(double));
+    if (!all) return;
+
+    // 색인 구성은 처음 검색할 때 한 번 (같은 목록으로 rounds번 다시 만들어 측정)
+    for (int r = 0; r < rounds; r++) {
+        if (r > 0) aptIndexFree(index);
+        double start = nowUs();
+        aptIndexLoad(index, listsDir, NULL);
+        samples[r] = nowUs() - start;
+    }
+    report("index_load", index->packages.count, samples, rounds);
+
+    int count = 0;
+    for (int r = 0; r < rounds; r++) {
+        for (int q = 0; q < queryCount; q++) {
+            PackageStore results;
+            storeInit(&results);
+            double start = nowUs();
+            aptIndexSearch(index, installed, queries[q], &results);
+            all[count++] = nowUs() - start;
+            storeFree(&results);
+        }
+    }
+    report("search", index->packages.count, all, count);
+    free(all);
+}
+
+// 전문 색인 구성·저장본 적재·순위 검색 (저장본은 목록 디렉터리에 씀, 목록 파일로는 읽히지 않는 이름)
+static void benchRankedSearch(const char *listsDir, const PackageStore *installed, int rounds, double *samples,
+                              AptIndex *index) {
+    int queryCount = (int)(sizeof(rankedQueries) / sizeof(rankedQueries[0]));
+    int buildRounds = rounds < TEXT_BUILD_ROUNDS ? rounds : TEXT_BUILD_ROUNDS;
+    char cachePath[PATH_BUFFER_SIZE];
+    double *all = (double *)malloc((size_t)rounds * queryCount * sizeof(double));
+    if (!all || index->packages.count == 0) {
+        free(all);
+        return;
+    }
+
+    for (int r = 0; r < buildRounds; r++) {
+        double start = nowUs();
+        aptIndexBuildText(index, listsDir, NULL);
+        samples[r] = nowUs() - start;
+    }
+    report("fulltext_build", index->packages.count, samples, buildRounds);
+
+    snprintf(cachePath, sizeof(cachePath), "%s/%s", listsDir, FULLTEXT_FILE_NAME);
+    unlink(cachePath);
+    aptIndexBuildText(index, listsDir, cachePath);
+    for (int r = 0; r < rounds; r++) {
+        double start = nowUs();
+        aptIndexBuildText(index, listsDir, cachePath);
+        samples[r] = nowUs() - start;
+    }
+    report(index->text.mapping ? "fulltext_load" : "fulltext_load_failed", index->packages.count, samples, rounds);
+    unlink(cachePath);
+
+    int count = 0;
+    for (int r = 0; r < rounds; r++) {
+        for (int q = 0; q < queryCount; q++) {
+            PackageStore results;
+            storeInit(&results);
+            double start = nowUs();
+            aptIndexRankedSearch(index, installed, rankedQueries[q], &results);
+            all[count++] = nowUs() - start;
+            storeFree(&results);
+        }
+    }
+    report("ranked_search", index->packages.count, all, count);
+    free(all);
+}
+
+// 상세 정보 조회 중 프로세스 실행이 없는 부분: 이름 색인 + 캐시 적중
+// (캐시에 없으면 apt-cache를 실행하므로 오프라인 측정 대상에서 뺌)
+static void benchDetail(const PackageStore *packages, int rounds, double *samples) {
+    int entries = packages->count < DETAIL_ENTRIES ? packages->count : DETAIL_ENTRIES;
+    int *picked = (int *)malloc((entries > 0 ? entries : 1) * sizeof(int));
+    if (!picked || entries == 0) {
+        free(picked);
+        return;
+    }
+
+    detailCacheInit((size_t)DETAIL_CACHE_DEFAULT_MB * 1024 * 1024);
+    for (int i = 0; i < entries; i++) {
+        const Package *package = &packages->items[nextRandom() % packages->count];
+        char stanza[BUFFER_SIZE];
+        int length = snprintf(stanza, sizeof(stanza), "Package: %s\nVersion: %s\nDescription: %s\n\n",
+                              package->name, package->version, package->description);
+        TextBuffer text;
+        textInit(&text);
+        textAppend(&text, stanza, (size_t)length < sizeof(stanza) ? (size_t)length : sizeof(stanza) - 1);
+        textShrink(&text);
+        detailCachePut(package->name, package->version, &text);
+        textFree(&text);
+        picked[i] = (int)(package - packages->items);
+    }
+
+    int found = 0;
+    for (int r = 0; r < rounds; r++) {
+        double start = nowUs();
+        for (int i = 0; i < DETAIL_BATCH; i++) {
+            const Package *package = &packages->items[picked[nextRandom() % entries]];
+            int slot = storeLookup(packages, package->name, strlen(package->name));
+            if (slot >= 0 && detailCacheGet(package->name, packages->items[slot].version)) found++;
+        }
+        samples[r] = (nowUs() - start) / DETAIL_BATCH;
+    }
+    report("detail_lookup", packages->count, samples, rounds);
+
+    detailCacheFree();
+    free(picked);
+    if (found == 0) fprintf(stderr, "detail_lookup: no cache hits\n");
+}
+
+// 의존 관계 그래프 구성과 질의 (자동 설치 정보 없이: 설치 이유는 역방향으로 끝까지 올라감)
+static void benchDependencies(const char *statusPath, int rounds, double *samples) {
+    DepGraph graph;
+    int path[DEP_WHY_PATH_MAX];
+
+    for (int r = 0; r < rounds; r++) {
+        if (r > 0) depGraphFree(&graph);
+        double start = nowUs();
+        if (!depGraphBuild(&graph, statusPath, NULL)) return;
+        samples[r] = nowUs() - start;
+    }
+    report("dep_graph_build", graph.nodes.count, samples, rounds);
+
+    double *impacts = (double *)malloc((size_t)rounds * DEP_QUERIES * sizeof(double));
+    double *whys = (double *)malloc((size_t)rounds * DEP_QUERIES * sizeof(double));
+    int count = 0;
+    for (int r = 0; impacts && whys && graph.nodes.count > 0 && r < rounds; r++) {
+        for (int q = 0; q < DEP_QUERIES; q++, count++) {
+            int node = (int)(nextRandom() % (uint32_t)graph.nodes.count);
+            DepImpact impact;
+
+            double start = nowUs();
+            depGraphRemovalImpact(&graph, &node, 1, &impact);
+            impacts[count] = nowUs() - start;
+            depImpactFree(&impact);
+
+            start = nowUs();
+            depGraphWhy(&graph, node, path, DEP_WHY_PATH_MAX);
+            whys[count] = nowUs() - start;
+        }
+    }
+    if (count > 0) {
+        report("removal_impact", graph.nodes.count, impacts, count);
+        report("why_installed", graph.nodes.count, whys, count);
+    }
+
+    free(impacts);
+    free(whys);
+    depGraphFree(&graph);
+}
+
+int main(int argc, char *argv[]) {
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s STATUS LISTS_DIR [ROUNDS]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    int rounds = argc > 3 ? atoi(argv[3]) : DEFAULT_ROUNDS;
+    if (rounds <= 0) rounds = DEFAULT_ROUNDS;
+
+    config.statusPath = argv[1];
+    config.useCache = false;
+
+    // 실제 터미널 없이 ncurses 화면을 만듦 (출력은 버림)
+    FILE *out = fopen("/dev/null", "w");
+    FILE *in = fopen("/dev/null", "r");
+    SCREEN *screen = out && in ? newterm("xterm", out, in) : NULL;
+    if (!screen) {
+        fprintf(stderr, "Cannot create a headless terminal\n");
+        return EXIT_FAILURE;
+    }
+    set_term(screen);
+    resizeterm(BENCH_ROWS, BENCH_COLS);
+    ROWS = BENCH_ROWS;
+    COLS = BENCH_COLS;
+    start_color();
+    init_pair(1, COLOR_BLACK, COLOR_WHITE);
+
+    double *samples = (double *)malloc(rounds * sizeof(double));
+    PackageStore store;
+    AptIndex index;
+    if (!samples) return EXIT_FAILURE;
+
+    storeInit(&store);
+    benchLoad(&store, rounds, samples);
+    if (store.count == 0) {
+        endwin();
+        fprintf(stderr, "No packages loaded from %s\n", config.statusPath);
+        return EXIT_FAILURE;
+    }
+    benchLayout(&store, rounds, samples);
+    benchRender(&store, rounds, samples);
+    benchSearch(argv[2], &store, rounds, samples, &index);
+    benchRankedSearch(argv[2], &store, rounds, samples, &index);
+    benchDetail(&index.packages, rounds, samples);
+    benchDependencies(argv[1], rounds, samples);
+
+    endwin();
+    delscreen(screen);
+    freeFrameCache();
+    aptIndexFree(&index);
+    storeFree(&store);
+    free(samples);
+    fclose(out);
+    fclose(in);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,42 @@
+#!/bin/sh
+# apt-get 대역: 실제 시스템을 건드리지 않고 작업 실행·취소·출력 창을 확인할 때 사용
+#   ./package_manager --apt-get bench/apt-get-stub.sh --no-sudo
+# 패키지 이름에 "fail"이 들어 있으면 100으로 종료 (apt-get의 실패 코드)
+# APT_STUB_DELAY로 단계 사이 지연(초)을 조절
+
+delay=${APT_STUB_DELAY:-0.3}
+command=$1
+shift
+
+case "$command" in
+    update)
+        for source in main contrib non-free; do
+            printf 'Get: http://deb.example.org stable/%s amd64 Packages\n' "$source"
+            sleep "$delay"
+        done
+        echo "Reading package lists... Done"
+        ;;
+    upgrade|install|remove)
+        status=0
+        echo "Reading package lists... Done"
+        echo "Building dependency tree... Done"
+        for arg in "$@"; do
+            case "$arg" in
+                -*) continue ;;
+                *fail*) echo "E: Unable to locate package $arg"; status=100; continue ;;
+                # install 명령에서 이름 뒤의 '-'는 삭제
+                *-) printf 'Removing %s ...\n' "${arg%-}"; sleep "$delay"; continue ;;
+            esac
+            for percent in 0 25 50 75 100; do
+                printf '\rProgress: [%3d%%] %s' "$percent" "$arg"
+                sleep "$delay"
+            done
+            printf '\nSetting up %s (%s) ...\n' "$arg" "$command"
+        done
+        exit $status
+        ;;
+    *)
+        echo "E: Invalid operation $command"
+        exit 100
+        ;;
+esac
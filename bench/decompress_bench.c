@@ -0,0 +1,117 @@
+// 압축된 목록 파일 스트리밍 벤치마크: 형식별 해제·파싱 처리량과 최대 RSS
+// 파일마다 자식 프로세스에서 읽어 RSS가 섞이지 않게 하고, 모든 파일의 스탠자 수와 이름 해시가
+// 첫 파일(보통 압축하지 않은 원본)과 같은지 확인함. 다르면 실패로 끝남
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include "../src/stanza.h"
+
+typedef struct ScanResult {
+    int format;
+    uint64_t compressedBytes;
+    uint64_t bytes;
+    long stanzas;
+    uint64_t checksum;      // 패키지 이름·버전의 FNV-1a (순서 포함)
+    double ms;
+    int ok;
+} ScanResult;
+
+static double nowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static uint64_t hashBytes(uint64_t hash, const char *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+static ScanResult scanFile(const char *path) {
+    ScanResult result = { .checksum = 14695981039346656037ull };
+    StanzaStream stream;
+    Stanza stanza;
+
+    double start = nowMs();
+    if (!stanzaStreamOpen(&stream, path)) return result;
+    while (stanzaStreamNext(&stream, &stanza)) {
+        size_t nameLen, versionLen;
+        const char *name = stanzaGet(&stanza, "Package", &nameLen);
+        const char *version = stanzaGet(&stanza, "Version", &versionLen);
+        if (!name) continue;
+        result.checksum = hashBytes(result.checksum, name, nameLen);
+        if (version) result.checksum = hashBytes(result.checksum, version, versionLen);
+        result.stanzas++;
+    }
+    result.ms = nowMs() - start;
+
+    if (stream.mapped) {
+        result.format = FORMAT_PLAIN;
+        result.compressedBytes = result.bytes = stream.file.size;
+    } else {
+        result.format = stream.source.format;
+        result.compressedBytes = stream.source.compressedBytes;
+        result.bytes = stream.source.outputBytes;
+    }
+    result.ok = !stream.failed;
+    stanzaStreamClose(&stream);
+    return result;
+}
+
+int main(int argc, char **argv) {
+    ScanResult first = { 0 };
+    int failures = 0;
+
+    if (argc < 2) {
+        fprintf(stderr, "usage: %s PACKAGES_FILE...\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    for (int i = 1; i < argc; i++) {
+        int fds[2];
+        if (pipe(fds) < 0) return EXIT_FAILURE;
+
+        pid_t pid = fork();
+        if (pid < 0) return EXIT_FAILURE;
+        if (pid == 0) {
+            ScanResult result = scanFile(argv[i]);
+            _exit(write(fds[1], &result, sizeof(result)) == (ssize_t)sizeof(result) ? 0 : 1);
+        }
+        close(fds[1]);
+
+        ScanResult result = { 0 };
+        ssize_t got = read(fds[0], &result, sizeof(result));
+        close(fds[0]);
+
+        int status;
+        struct rusage usage;
+        if (wait4(pid, &status, 0, &usage) < 0 || got != (ssize_t)sizeof(result) || !result.ok) {
+            fprintf(stderr, "decompress bench: failed to read %s\n", argv[i]);
+            failures++;
+            continue;
+        }
+
+        if (i == 1) first = result;
+        bool same = result.stanzas == first.stanzas && result.checksum == first.checksum;
+        if (!same) {
+            fprintf(stderr, "decompress bench: %s differs from %s (%ld stanzas)\n", argv[i], argv[1], result.stanzas);
+            failures++;
+        }
+
+        // ru_maxrss는 KiB 단위
+        printf("{\"bench\":\"list_decompress\",\"format\":\"%s\",\"compressed_bytes\":%llu,\"bytes\":%llu,"
+               "\"stanzas\":%ld,\"ms\":%.2f,\"mb_per_s\":%.1f,\"peak_rss_kb\":%ld,\"matches_first\":%s}\n",
+               formatName((DecompressFormat)result.format), (unsigned long long)result.compressedBytes,
+               (unsigned long long)result.bytes, result.stanzas, result.ms,
+               result.ms > 0 ? result.bytes / 1e6 / (result.ms / 1e3) : 0.0, usage.ru_maxrss,
+               same ? "true" : "false");
+    }
+    return failures > 0 ? EXIT_FAILURE : EXIT_SUCCESS;
+}
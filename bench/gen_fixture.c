@@ -0,0 +1,215 @@
+// 벤치마크용 가짜 apt Packages 목록·dpkg status 파일 생성기 (고정 시드, 네트워크 불필요)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <stdbool.h>
+
+static uint64_t rngState = 0x9e3779b97f4a7c15ull;
+
+// xorshift64* : 실행마다 같은 결과가 나오도록 고정 시드 사용
+static uint32_t nextRandom(void) {
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return (uint32_t)((rngState * 2685821657736338717ull) >> 32);
+}
+
+#define FIXTURE_NAME_SIZE 64
+
+#define PICK(array) (array[nextRandom() % (sizeof(array) / sizeof(array[0]))])
+
+static const char *prefixes[] = {
+    "", "", "", "lib", "lib", "python3-", "golang-", "r-cran-", "node-", "ruby-",
+    "libghc-", "fonts-", "gir1.2-", "liblua5.4-", "texlive-", "xserver-xorg-",
+};
+static const char *stems[] = {
+    "gtk", "qt", "xml", "json", "ssl", "curl", "boost", "sdl", "glib", "pango",
+    "cairo", "vim", "emacs", "nginx", "apache", "postgres", "mysql", "sqlite", "redis",
+    "zlib", "png", "jpeg", "tiff", "webp", "ffmpeg", "gstreamer", "pulse", "alsa",
+    "kde", "gnome", "xfce", "mate", "systemd", "dbus", "udev", "pam", "krb5",
+    "ldap", "sasl", "gnutls", "nettle", "gmp", "mpfr", "llvm", "clang", "gcc",
+    "rust", "perl", "tcl", "tk", "yaml", "toml", "http", "socket", "thread",
+};
+static const char *suffixes[] = {
+    "", "", "", "-dev", "-doc", "-data", "-common", "-bin", "-utils", "-dbg",
+    "1", "2", "3", "6", "-tools", "-plugins",
+};
+static const char *words[] = {
+    "library", "development", "files", "for", "the", "toolkit", "bindings",
+    "interface", "runtime", "support", "module", "plugin", "server", "client",
+    "utilities", "documentation", "parser", "network", "graphics", "audio",
+    "video", "editor", "database", "compression", "encryption", "terminal",
+    "shared", "static", "headers", "python", "perl", "command-line", "daemon",
+    "framework", "extension", "fonts", "desktop", "kernel", "driver", "engine",
+};
+static const char *sections[] = {
+    "libs", "libdevel", "python", "utils", "admin", "net", "web", "doc", "x11",
+    "graphics", "sound", "video", "editors", "devel", "text", "fonts", "misc",
+};
+
+static void writeSentence(FILE *fp, int wordCount) {
+    for (int i = 0; i < wordCount; i++) {
+        fprintf(fp, "%s%s", i ? " " : "", PICK(words));
+    }
+}
+
+// 앞쪽 번호일수록 자주 뽑음 (libc처럼 많은 패키지가 의존하는 기반 패키지를 흉내 냄)
+static long pickEarlier(long i) {
+    uint64_t a = nextRandom() % (uint64_t)i, b = nextRandom() % (uint64_t)i;
+    return (long)(a * b / (uint64_t)i);
+}
+
+// dpkg status의 관계 필드: 앞서 나온 패키지에 대한 Depends (가끔 대안·가상 패키지), Pre-Depends, Recommends
+// 처음 몇 개는 Essential, 일부는 가상 패키지를 Provides
+static void writeRelations(FILE *fp, char (*names)[FIXTURE_NAME_SIZE], long i) {
+    if (i < 8) fprintf(fp, "Essential: yes\n");
+    if (i > 0 && nextRandom() % 20 == 0) {
+        fprintf(fp, "Provides: virtual-%s\n", PICK(stems));
+    }
+    if (i == 0) return;
+
+    if (nextRandom() % 25 == 0) fprintf(fp, "Pre-Depends: %s (>= 1.0)\n", names[pickEarlier(i)]);
+
+    int groups = (int)(nextRandom() % 5);
+    for (int g = 0; g < groups; g++) {
+        fprintf(fp, "%s", g == 0 ? "Depends: " : ", ");
+        if (nextRandom() % 30 == 0) {
+            fprintf(fp, "virtual-%s", PICK(stems));
+        } else {
+            fprintf(fp, "%s (>= 0.%u)", names[pickEarlier(i)], nextRandom() % 10);
+        }
+        if (nextRandom() % 8 == 0) fprintf(fp, " | %s", names[pickEarlier(i)]);
+    }
+    if (groups > 0) fprintf(fp, "\n");
+
+    if (nextRandom() % 5 == 0) fprintf(fp, "Recommends: %s\n", names[nextRandom() % i]);
+}
+
+// Description-md5 자리에 넣는 16진수 32자. 색인은 Packages와 Translation의 값이 같은지만 보므로
+// 진짜 MD5 대신 설명 본문의 FNV-1a 두 개를 이어 붙임
+static void writeDigest(FILE *fp, const char *text, size_t length) {
+    uint64_t a = 14695981039346656037ull, b = 0x84222325cbf29ce4ull;
+    for (size_t i = 0; i < length; i++) {
+        a = (a ^ (unsigned char)text[i]) * 1099511628211ull;
+        b = (b ^ (unsigned char)text[i]) * 1099511628211ull;
+    }
+    fprintf(fp, "%016llx%016llx", (unsigned long long)a, (unsigned long long)b);
+}
+
+int main(int argc, char *argv[]) {
+    // --status: dpkg status 형식 (Status 줄, 저장소 전용 필드 없음)
+    bool status = argc > 1 && strcmp(argv[1], "--status") == 0;
+    if (status) {
+        argc--;
+        argv++;
+    }
+    // --translation FILE: 요즘 미러처럼 Packages에는 요약과 Description-md5만 두고 긴 설명은
+    // FILE(i18n Translation-en 형식)에 씀. 난수 순서는 같으므로 패키지는 한 파일에 쓴 것과 같음
+    FILE *translation = NULL;
+    if (!status && argc > 2 && strcmp(argv[1], "--translation") == 0) {
+        translation = fopen(argv[2], "w");
+        if (!translation) {
+            fprintf(stderr, "Cannot write %s\n", argv[2]);
+            return EXIT_FAILURE;
+        }
+        argc -= 2;
+        argv += 2;
+    }
+    if (argc < 3) {
+        fprintf(stderr, "Usage: %s [--status | --translation FILE] COUNT OUTPUT\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    long count = strtol(argv[1], NULL, 10);
+    FILE *fp = fopen(argv[2], "w");
+    if (!fp || count <= 0) {
+        fprintf(stderr, "Cannot write %s\n", argv[2]);
+        return EXIT_FAILURE;
+    }
+
+    char *description = NULL;
+    size_t descriptionSize = 0;
+
+    // status 파일은 앞서 나온 패키지에 의존하도록 이름을 모두 기억
+    char single[FIXTURE_NAME_SIZE];
+    char (*names)[FIXTURE_NAME_SIZE] = status ? malloc((size_t)count * FIXTURE_NAME_SIZE) : NULL;
+    if (status && !names) {
+        fprintf(stderr, "Out of memory\n");
+        return EXIT_FAILURE;
+    }
+
+    for (long i = 0; i < count; i++) {
+        // 번호를 붙여 이름이 겹치지 않도록 함
+        char *name = names ? names[i] : single;
+        snprintf(name, FIXTURE_NAME_SIZE, "%s%s%ld%s", PICK(prefixes), PICK(stems), i, PICK(suffixes));
+        fprintf(fp, "Package: %s\n", name);
+        if (status) {
+            // 일부는 삭제 후 설정 파일만 남은 항목 (설치 목록에서 빠져야 함)
+            fprintf(fp, "Status: %s\n", nextRandom() % 50 == 0 ? "deinstall ok config-files" : "install ok installed");
+        }
+        fprintf(fp, "Architecture: amd64\n");
+        if (nextRandom() % 5 == 0) {
+            fprintf(fp, "Version: %u:%u.%u.%u-%u\n", nextRandom() % 3, nextRandom() % 10,
+                    nextRandom() % 30, nextRandom() % 100, nextRandom() % 5 + 1);
+        } else {
+            fprintf(fp, "Version: %u.%u-%u%s\n", nextRandom() % 10, nextRandom() % 30,
+                    nextRandom() % 5 + 1, nextRandom() % 4 == 0 ? "+b1" : "");
+        }
+        fprintf(fp, "Maintainer: Debian Maintainers <maint%ld@lists.debian.org>\n", i % 500);
+        fprintf(fp, "Installed-Size: %u\n", nextRandom() % 20000 + 10);
+        if (status) {
+            writeRelations(fp, names, i);
+        } else {
+            fprintf(fp, "Depends: libc6 (>= 2.34), %s%s\n", PICK(prefixes), PICK(stems));
+        }
+        fprintf(fp, "Section: %s\n", PICK(sections));
+        fprintf(fp, "Priority: optional\n");
+        if (!status) {
+            fprintf(fp, "Filename: pool/main/x/pkg%ld/pkg%ld_1.0_amd64.deb\n", i, i);
+            fprintf(fp, "Size: %u\n", nextRandom() % 5000000 + 1000);
+            fprintf(fp, "SHA256: %08x%08x%08x%08x%08x%08x%08x%08x\n",
+                    nextRandom(), nextRandom(), nextRandom(), nextRandom(),
+                    nextRandom(), nextRandom(), nextRandom(), nextRandom());
+        }
+
+        // 요약 줄과 긴 설명을 모아 두었다가 한 파일 또는 두 파일에 나눠 씀
+        FILE *text = open_memstream(&description, &descriptionSize);
+        if (!text) {
+            fprintf(stderr, "Out of memory\n");
+            return EXIT_FAILURE;
+        }
+        writeSentence(text, 3 + nextRandom() % 5);
+        fprintf(text, "\n");
+        int paragraphs = 1 + nextRandom() % 3;
+        for (int p = 0; p < paragraphs; p++) {
+            if (p) fprintf(text, " .\n");
+            int lines = 1 + nextRandom() % 4;
+            for (int l = 0; l < lines; l++) {
+                fprintf(text, " ");
+                writeSentence(text, 6 + nextRandom() % 6);
+                fprintf(text, "\n");
+            }
+        }
+        fclose(text);
+
+        if (translation) {
+            size_t summaryLen = strcspn(description, "\n");
+            fprintf(fp, "Description: %.*s\nDescription-md5: ", (int)summaryLen, description);
+            writeDigest(fp, description, descriptionSize);
+            fprintf(translation, "Package: %s\nDescription-md5: ", name);
+            writeDigest(translation, description, descriptionSize);
+            fprintf(translation, "\nDescription-en: %s\n", description);
+            fprintf(fp, "\n");
+        } else {
+            fprintf(fp, "Description: %s", description);
+        }
+        fprintf(fp, "\n");
+    }
+
+    fclose(fp);
+    if (translation) fclose(translation);
+    free(description);
+    free(names);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,31 @@
+#!/bin/sh
+# 상세 정보 도우미 대역: apt 없이 도우미 프로토콜과 미리 가져오기를 확인할 때 사용
+#   ./package_manager --helper-path bench/helper-stub.sh
+# 이름에 "missing"이 들어 있으면 없는 패키지로 응답
+# HELPER_STUB_DELAY로 묶음마다 지연(초)을 조절, HELPER_STUB_LOG에 받은 묶음 크기를 기록
+
+delay=${HELPER_STUB_DELAY:-0}
+
+while read -r command count; do
+    [ "$command" = batch ] || exit 1
+    [ -n "$HELPER_STUB_LOG" ] && echo "batch $count" >> "$HELPER_STUB_LOG"
+    sleep "$delay"
+
+    i=0
+    while [ "$i" -lt "$count" ]; do
+        read -r name version
+        i=$((i + 1))
+        case "$name" in
+            *missing*)
+                echo "missing"
+                continue
+                ;;
+        esac
+        [ "$version" = "-" ] && version="1.0"
+
+        body=$(printf 'Package: %s\nVersion: %s\nDescription: stand-in details for %s\n Served by bench/helper-stub.sh.\n\n.' \
+            "$name" "$version" "$name")
+        body=${body%.}
+        printf 'ok %s\n%s' "$(printf '%s' "$body" | wc -c)" "$body"
+    done
+done
@@ -0,0 +1,123 @@
+// 상세 정보 조회 지연 비교: 요청마다 popen(apt-cache show) vs 상주 도우미 (한 건씩 / 묶음)
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "../src/helper.h"
+#include "../src/config.h"
+#include "../src/constants.h"
+
+#define MAX_QUERIES 256
+
+static char names[MAX_QUERIES][PACKAGE_NAME_SIZE];
+static char versions[MAX_QUERIES][PACKAGE_NAME_SIZE];
+static DetailRequest requests[MAX_QUERIES];
+static TextBuffer popenTexts[MAX_QUERIES];
+static TextBuffer helperTexts[MAX_QUERIES];
+
+static double nowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static bool popenShow(const DetailRequest *request, TextBuffer *text) {
+    char command[COMMAND_SIZE];
+    snprintf(command, sizeof(command), "apt-cache show %s=%s 2>/dev/null", request->name, request->version);
+
+    FILE *fp = popen(command, "r");
+    if (!fp) return false;
+    bool ok = textReadStream(text, fp);
+    pclose(fp);
+    return ok;
+}
+
+static bool sameText(const TextBuffer *a, const TextBuffer *b) {
+    if (a->lineCount != b->lineCount) return false;
+    for (int i = 0; i < a->lineCount; i++) {
+        if (strcmp(textLine(a, i), textLine(b, i)) != 0) return false;
+    }
+    return true;
+}
+
+// 한 번에 batch개씩 도우미에 요청한 평균 지연 (ms/건)
+static double helperRun(int count, int batch, bool keep) {
+    double start = nowMs();
+
+    for (int first = 0; first < count; first += batch) {
+        int n = count - first < batch ? count - first : batch;
+        TextBuffer texts[MAX_QUERIES];
+        for (int i = 0; i < n; i++) textInit(&texts[i]);
+
+        if (!helperShow(NULL, requests + first, n, texts)) {
+            fprintf(stderr, "helper failed (%s --helper)\n", config.helperPath);
+            exit(EXIT_FAILURE);
+        }
+        for (int i = 0; i < n; i++) {
+            if (keep) helperTexts[first + i] = texts[i];
+            else textFree(&texts[i]);
+        }
+    }
+    return (nowMs() - start) / count;
+}
+
+int main(int argc, char *argv[]) {
+    int count = argc > 2 ? atoi(argv[2]) : 32;
+    int loaded = 0;
+
+    config.helperPath = argc > 1 ? argv[1] : "./package_manager";
+    if (count <= 0 || count > MAX_QUERIES) count = MAX_QUERIES;
+
+    // 설치된 패키지의 이름과 버전을 질의로 사용
+    FILE *fp = popen("dpkg-query -W -f='${Package} ${Version}\\n' 2>/dev/null", "r");
+    char line[BUFFER_SIZE];
+    while (fp && loaded < count && fgets(line, sizeof(line), fp)) {
+        if (sscanf(line, "%255s %255s", names[loaded], versions[loaded]) == 2) {
+            requests[loaded] = (DetailRequest){ names[loaded], versions[loaded] };
+            loaded++;
+        }
+    }
+    if (fp) pclose(fp);
+    if (loaded == 0) {
+        printf("helper bench skipped: no installed packages from dpkg-query\n");
+        return EXIT_SUCCESS;
+    }
+    count = loaded;
+
+    // 첫 실행의 디스크 읽기가 어느 한쪽에만 들어가지 않도록 한 번씩 미리 실행
+    TextBuffer warm;
+    textInit(&warm);
+    popenShow(&requests[0], &warm);
+    textFree(&warm);
+    helperRun(1, 1, false);
+
+    double start = nowMs();
+    for (int i = 0; i < count; i++) {
+        textInit(&popenTexts[i]);
+        popenShow(&requests[i], &popenTexts[i]);
+    }
+    double popenMs = (nowMs() - start) / count;
+
+    double singleMs = helperRun(count, 1, false);
+    double prefetchMs = helperRun(count, PREFETCH_BATCH, false);
+    double batchMs = helperRun(count, count, true);
+
+    int identical = 0;
+    for (int i = 0; i < count; i++) {
+        identical += sameText(&popenTexts[i], &helperTexts[i]);
+        textFree(&popenTexts[i]);
+        textFree(&helperTexts[i]);
+    }
+    helperStop(NULL);
+
+    printf("detail queries: %d installed packages (apt-cache show name=version)\n", count);
+    char label[64];
+    printf("  %-26s %8.2f ms/query\n", "popen per query", popenMs);
+    printf("  %-26s %8.2f ms/query\n", "helper, 1 per request", singleMs);
+    snprintf(label, sizeof(label), "helper, %d per request", PREFETCH_BATCH);
+    printf("  %-26s %8.2f ms/query\n", label, prefetchMs);
+    snprintf(label, sizeof(label), "helper, %d per request", count);
+    printf("  %-26s %8.2f ms/query\n", label, batchMs);
+    printf("  %-26s %5d/%d\n", "identical output", identical, count);
+    return EXIT_SUCCESS;
+}
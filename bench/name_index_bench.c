@@ -0,0 +1,98 @@
+// 이름 → 번호 해시 색인 마이크로벤치마크: 구성 시간과 검색 지연을 이진 탐색과 비교
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include "../src/package_store.h"
+
+#define LOOKUPS 1000000
+#define ROUNDS 5
+
+static uint64_t rngState = 0x2545f4914f6cdd1dull;
+
+static uint32_t nextRandom(void) {
+    rngState ^= rngState >> 12;
+    rngState ^= rngState << 25;
+    rngState ^= rngState >> 27;
+    return (uint32_t)((rngState * 2685821657736338717ull) >> 32);
+}
+
+static double nowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+static const char *stems[] = {
+    "lib", "python3-", "golang-", "node-", "ruby-", "fonts-", "libghc-", "r-cran-", "", "",
+};
+
+// 검색 대상 이름 (절반은 존재, 절반은 존재하지 않음)
+static void lookupRun(const PackageStore *store, char **queries, int count, const char *label) {
+    double best = 1e30;
+    long found = 0;
+
+    for (int round = 0; round < ROUNDS; round++) {
+        double start = nowMs();
+        found = 0;
+        for (int i = 0; i < LOOKUPS; i++) {
+            found += storeFind(store, queries[i % count]) != NULL;
+        }
+        double elapsed = nowMs() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    printf("  %-22s %8.1f ns/lookup  (%ld hits)\n", label, best * 1e6 / LOOKUPS, found);
+}
+
+int main(int argc, char *argv[]) {
+    int count = argc > 1 ? atoi(argv[1]) : 100000;
+    char name[64];
+    PackageStore store;
+
+    if (count <= 0) {
+        fprintf(stderr, "usage: %s [COUNT]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    storeInit(&store);
+    for (int i = 0; i < count; i++) {
+        int length = snprintf(name, sizeof(name), "%s%x-%u",
+                              stems[nextRandom() % 10], (unsigned)i * 2654435761u, nextRandom() % 100);
+        storeAdd(&store, name, length, "1.0", 3, "bench", 5);
+    }
+    storeSortByName(&store, true);
+
+    // 존재하는 이름과 존재하지 않는 이름을 번갈아 질의
+    int queryCount = 4096;
+    char **queries = (char **)malloc(queryCount * sizeof(char *));
+    for (int i = 0; i < queryCount; i++) {
+        if (i % 2 == 0) {
+            queries[i] = strdup(store.items[nextRandom() % store.count].name);
+        } else {
+            snprintf(name, sizeof(name), "missing-%u", nextRandom());
+            queries[i] = strdup(name);
+        }
+    }
+
+    printf("names: %d\n", store.count);
+    lookupRun(&store, queries, queryCount, "binary search");
+
+    double best = 1e30;
+    for (int round = 0; round < ROUNDS; round++) {
+        free(store.names.slots);
+        memset(&store.names, 0, sizeof(store.names));
+        double start = nowMs();
+        storeBuildIndex(&store);
+        double elapsed = nowMs() - start;
+        if (elapsed < best) best = elapsed;
+    }
+    printf("  %-22s %8.2f ms  (%zu slots, %zu bytes)\n", "hash index build", best,
+           store.names.capacity, store.names.capacity * sizeof(NameSlot));
+    lookupRun(&store, queries, queryCount, "hash index");
+
+    for (int i = 0; i < queryCount; i++) free(queries[i]);
+    free(queries);
+    storeFree(&store);
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,108 @@
+// Debian 버전 비교 적합성 표 검사와 비교 속도 측정
+// 표의 기대값은 dpkg --compare-versions와 같음. 하나라도 다르면 실패로 끝남 (make bench가 멈춤)
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <time.h>
+#include "../src/version.h"
+
+#define COMPARES 2000000
+
+typedef struct {
+    const char *a;
+    const char *b;
+    int expected;   // -1: a < b, 0: 같음, 1: a > b
+} VersionCase;
+
+static const VersionCase cases[] = {
+    // 기본 숫자·문자
+    { "1.0", "1.0", 0 },
+    { "1.0", "1.1", -1 },
+    { "1.10", "1.9", 1 },
+    { "9", "10", -1 },
+    { "1.09", "1.9", 0 },
+    { "1.0.1", "1.0", 1 },
+    { "1.2.3", "1.2-3", 1 },
+    { "1.3", "1.2.2-2", 1 },
+    { "1.0a", "1.0", 1 },
+    { "1.2a", "1.2A", 1 },
+    { "a", "b", -1 },
+    { "7.6p2-4", "7.6-0", 1 },
+    { "0.9+git20200101", "0.9.1", -1 },
+    { "1.0+b1", "1.0", 1 },
+    { "1.0", "1.0+~", -1 },
+    // 에포크
+    { "1:0.1", "2.0", 1 },
+    { "0:1.0", "1.0", 0 },
+    { "2:0.1", "1:9.9", 1 },
+    { "1:1.2.3-1", "1:1.2.3-1+deb11u1", -1 },
+    { "10:1.0", "9:2.0", 1 },
+    // 리비전
+    { "1.0", "1.0-0", 0 },
+    { "1.0-1", "1.0-2", -1 },
+    { "1.0-1", "1.0-1.1", -1 },
+    { "1.0-0ubuntu1", "1.0-1", -1 },
+    { "2.30-1", "2.30-1ubuntu1", -1 },
+    { "3.0-1+b1", "3.0-1", 1 },
+    { "1.0-1", "1.0-1~bpo1", 1 },
+    { "1.2-3-4", "1.2-3-5", -1 },
+    { "1.2-3-4", "1.2-4", 1 },
+    // 물결표: 끝보다도 앞
+    { "1.0~rc1", "1.0", -1 },
+    { "1.0~rc1", "1.0~rc2", -1 },
+    { "1.0~", "1.0", -1 },
+    { "1.0~~", "1.0~", -1 },
+    { "1.0~~a", "1.0~", -1 },
+    { "1.0~", "1.0~a", -1 },
+    { "~~", "~~a", -1 },
+    { "~~a", "~", -1 },
+    { "~", "1", -1 },
+    // 빈 버전 (설치되지 않음)은 무엇보다도 앞
+    { "", "~", -1 },
+    { "", "a", -1 },
+    { "1.2.3~rc1-1", "1.2.3-1", -1 },
+    { "2.0~beta1+dfsg-1", "2.0~beta1-1", 1 },
+    // 긴 숫자 (자릿수가 많으면 큼, 넘침 없이)
+    { "20240101120000", "20231231235959", 1 },
+    { "1.000000000000000000000001", "1.1", 0 },
+    { "1.123456789012345678901234567890", "1.123456789012345678901234567891", -1 },
+};
+
+static double nowUs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e6 + ts.tv_nsec / 1e3;
+}
+
+static int sign(int value) {
+    return (value > 0) - (value < 0);
+}
+
+int main(void) {
+    int count = (int)(sizeof(cases) / sizeof(cases[0]));
+    int failures = 0;
+
+    for (int i = 0; i < count; i++) {
+        int forward = sign(versionCompare(cases[i].a, cases[i].b));
+        int backward = sign(versionCompare(cases[i].b, cases[i].a));
+        if (forward != cases[i].expected || backward != -cases[i].expected) {
+            fprintf(stderr, "version mismatch: '%s' vs '%s': got %d/%d, expected %d\n",
+                    cases[i].a, cases[i].b, forward, backward, cases[i].expected);
+            failures++;
+        }
+    }
+    printf("{\"bench\":\"version_conformance\",\"cases\":%d,\"failures\":%d}\n", count, failures);
+    if (failures > 0) return EXIT_FAILURE;
+
+    // 표의 쌍을 돌려 가며 비교 (결과를 합산해 최적화로 사라지지 않게 함)
+    long total = 0;
+    double start = nowUs();
+    for (int i = 0; i < COMPARES; i++) {
+        const VersionCase *pair = &cases[i % count];
+        total += sign(versionCompare(pair->a, pair->b));
+    }
+    double elapsed = nowUs() - start;
+    printf("{\"bench\":\"version_compare\",\"compares\":%d,\"ns_per_compare\":%.1f,\"checksum\":%ld}\n",
+           COMPARES, elapsed * 1e3 / COMPARES, total);
+    return EXIT_SUCCESS;
+}
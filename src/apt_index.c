@@ -0,0 +1,481 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <sys/stat.h>
+#include "apt_index.h"
+#include "stanza.h"
+#include "filter.h"
+#include "constants.h"
+#include "trace.h"
+#include "version.h"
+#include "apt_policy.h"
+
+// apt가 내려받은 Packages 인덱스 파일인지 확인 (Acquire::GzipIndexes 등으로 압축된 채 둔 것 포함)
+// 압축 형식은 이름이 아니라 내용의 매직 바이트로 판별
+static bool isPackagesList(const char *fileName) {
+    static const char *const suffixes[] = { "_Packages", "_Packages.gz", "_Packages.xz", "_Packages.lz4" };
+    size_t length = strlen(fileName);
+
+    for (size_t i = 0; i < sizeof(suffixes) / sizeof(suffixes[0]); i++) {
+        size_t suffixLen = strlen(suffixes[i]);
+        if (length > suffixLen && strcmp(fileName + length - suffixLen, suffixes[i]) == 0) return true;
+    }
+    return false;
+}
+
+// 긴 설명을 Packages에서 떼어 둔 Translation 파일 (host_dists_suite_main_i18n_Translation-en 등, 압축 포함)
+// language가 있으면 그 언어 파일만
+static bool isTranslationList(const char *fileName, const char *language) {
+    const char *marker = strstr(fileName, "_i18n_Translation-");
+    if (!marker) return false;
+
+    const char *name = marker + 18;
+    size_t nameLen = strcspn(name, ".");
+    const char *suffix = name + nameLen;
+    if (nameLen == 0 || (*suffix && strcmp(suffix, ".gz") != 0 && strcmp(suffix, ".xz") != 0
+                         && strcmp(suffix, ".lz4") != 0)) {
+        return false;
+    }
+    return !language || (strlen(language) == nameLen && strncmp(name, language, nameLen) == 0);
+}
+
+// Packages 파일 하나의 스탠자를 차례로 넘김 (압축된 파일은 읽는 대로 풂). visit이 false를 돌려주면 false
+// 손상된 압축 파일은 풀린 앞부분까지만 사용. policy가 있으면 다른 아키텍처 스탠자는 건너뛰고
+// 핀 우선순위를 매김 (없으면 모두 기본 우선순위)
+static bool scanListFile(const char *path, const AptPolicy *policy, const AptListSource *source,
+                         PackageVisitor visit, void *context) {
+    StanzaStream stream;
+    Stanza stanza;
+    bool more = true;
+
+    if (!stanzaStreamOpen(&stream, path)) return true;
+
+    while (more && stanzaStreamNext(&stream, &stanza)) {
+        PackageFields fields;
+        size_t architectureLen;
+        const char *architecture = stanzaGet(&stanza, "Architecture", &architectureLen);
+        if (!aptPolicyArchitecture(policy, architecture, architectureLen)) continue;
+
+        fields.name = stanzaGet(&stanza, "Package", &fields.nameLen);
+        fields.version = stanzaGet(&stanza, "Version", &fields.versionLen);
+        fields.description = stanzaGet(&stanza, "Description", &fields.descLen);
+        const char *newline = fields.description ? memchr(fields.description, '\n', fields.descLen) : NULL;
+        fields.details = newline ? newline + 1 : NULL;
+        fields.detailsLen = newline ? (size_t)(fields.description + fields.descLen - fields.details) : 0;
+        fields.descLen = firstLineLength(fields.description, fields.descLen);
+        fields.descriptionMd5 = stanzaGet(&stanza, "Description-md5", &fields.descriptionMd5Len);
+
+        if (!fields.name || fields.nameLen == 0) continue;
+        fields.priority = aptPolicyPriority(policy, source, fields.name, fields.nameLen,
+                                            fields.version, fields.versionLen);
+        more = visit(&fields, context);
+    }
+    stanzaStreamClose(&stream);
+    return more;
+}
+
+// 목록 디렉터리의 모든 Packages 파일을 차례로 훑음. 읽은 파일 수, 디렉터리를 열 수 없으면 -1
+// policy가 있으면 다른 아키텍처의 목록은 건너뛰고, 파일마다 Release 파일에서 출처를 읽음
+static int scanLists(const char *listsDir, const AptPolicy *policy, PackageVisitor visit, void *context) {
+    char path[PATH_BUFFER_SIZE];
+    AptListSource source;
+    int files = 0;
+
+    DIR *dir = opendir(listsDir);
+    if (!dir) return -1;
+
+    struct dirent *entry;
+    while ((entry = readdir(dir)) != NULL) {
+        if (!isPackagesList(entry->d_name)) continue;
+        if (policy && !aptPolicyWantsList(policy, entry->d_name)) continue;
+        if (snprintf(path, sizeof(path), "%s/%s", listsDir, entry->d_name) >= (int)sizeof(path)) continue;
+        if (policy) aptListSourceRead(&source, listsDir, entry->d_name);
+        files++;
+        if (!scanListFile(path, policy, policy ? &source : NULL, visit, context)) break;
+    }
+    closedir(dir);
+    return files;
+}
+
+// Translation 파일 하나의 스탠자를 차례로 넘김. Description-LANG의 첫 줄이 요약, 나머지가 긴 설명
+static bool scanTranslationFile(const char *path, PackageVisitor visit, void *context) {
+    StanzaStream stream;
+    Stanza stanza;
+    bool more = true;
+
+    if (!stanzaStreamOpen(&stream, path)) return true;
+
+    while (more && stanzaStreamNext(&stream, &stanza)) {
+        PackageFields fields = { .priority = APT_PRIORITY_DEFAULT };
+        fields.name = stanzaGet(&stanza, "Package", &fields.nameLen);
+        fields.descriptionMd5 = stanzaGet(&stanza, "Description-md5", &fields.descriptionMd5Len);
+        for (int i = 0; i < stanza.fieldCount; i++) {
+            const StanzaField *field = &stanza.fields[i];
+            if (field->nameLen > 12 && strncasecmp(field->name, "Description-", 12) == 0
+                && !(field->nameLen == 15 && strncasecmp(field->name, "Description-md5", 15) == 0)) {
+                fields.description = field->value;
+                fields.descLen = field->valueLen;
+                break;
+            }
+        }
+        if (!fields.name || fields.nameLen == 0 || !fields.description) continue;
+
+        const char *newline = memchr(fields.description, '\n', fields.descLen);
+        fields.details = newline ? newline + 1 : NULL;
+        fields.detailsLen = newline ? (size_t)(fields.description + fields.descLen - fields.details) : 0;
+        fields.descLen = firstLineLength(fields.description, fields.descLen);
+        more = visit(&fields, context);
+    }
+    stanzaStreamClose(&stream);
+    return more;
+}
+
+// 목록 디렉터리의 Translation 파일을 영어(-en) 파일부터 훑음. 읽은 파일 수, 디렉터리를 열 수 없으면 -1
+static int scanTranslations(const char *listsDir, PackageVisitor visit, void *context) {
+    char path[PATH_BUFFER_SIZE];
+    int files = 0;
+    bool more = true;
+
+    DIR *dir = opendir(listsDir);
+    if (!dir) return -1;
+
+    for (int pass = 0; pass < 2 && more; pass++) {
+        struct dirent *entry;
+        rewinddir(dir);
+        while (more && (entry = readdir(dir)) != NULL) {
+            if (!isTranslationList(entry->d_name, NULL)) continue;
+            if (isTranslationList(entry->d_name, "en") != (pass == 0)) continue;
+            if (snprintf(path, sizeof(path), "%s/%s", listsDir, entry->d_name) >= (int)sizeof(path)) continue;
+            files++;
+            more = scanTranslationFile(path, visit, context);
+        }
+    }
+    closedir(dir);
+    return files;
+}
+
+static bool addListEntry(const PackageFields *fields, void *context) {
+    Package *package = storeAdd((PackageStore *)context, fields->name, fields->nameLen,
+                                fields->version, fields->versionLen, fields->description, fields->descLen);
+    if (package) packageSetPriority(package, fields->priority);
+    return true;
+}
+
+// 목록 디렉터리의 모든 Packages 파일을 읽어 이름순·중복 제거된 인덱스 구성
+// 이름마다 후보 버전 하나만 남김. policy(NULL 가능)는 인덱스를 해제할 때까지 유지되어야 함
+int aptIndexLoad(AptIndex *index, const char *listsDir, const AptPolicy *policy) {
+    storeInit(&index->packages);
+    memset(&index->trigrams, 0, sizeof(index->trigrams));
+    memset(&index->text, 0, sizeof(index->text));
+    index->policy = policy;
+
+    if (scanLists(listsDir, policy, addListEntry, &index->packages) < 0) return -1;
+
+    storeSortByName(&index->packages, true);
+    storeBuildIndex(&index->packages);
+    // 색인 생성에 실패하면 선형 검색으로 동작
+    trigramBuild(&index->trigrams, &index->packages);
+    return index->packages.count;
+}
+
+typedef struct ScanQuery {
+    char needle[FILTER_QUERY_SIZE];     // 소문자로 바꾼 질의
+    size_t needleLen;
+    PackageVisitor visit;
+    void *context;
+} ScanQuery;
+
+static bool visitMatch(const PackageFields *fields, void *context) {
+    ScanQuery *scan = (ScanQuery *)context;
+
+    if (!containsIgnoreCase(fields->name, fields->nameLen, scan->needle, scan->needleLen)
+        && !(fields->description
+             && containsIgnoreCase(fields->description, fields->descLen, scan->needle, scan->needleLen))) {
+        return true;
+    }
+    return scan->visit(fields, scan->context);
+}
+
+// 색인을 만들지 않고 Packages 파일을 한 번 훑으며 일치 항목만 넘김 (한 번 검색하고 끝나는 비대화형 실행용)
+// 같은 패키지가 여러 목록에 있으면 여러 번 넘어옴. 읽은 파일 수, 디렉터리를 열 수 없으면 -1
+int aptIndexScan(const char *listsDir, const AptPolicy *policy, const char *query,
+                 PackageVisitor visit, void *context) {
+    ScanQuery scan = { .visit = visit, .context = context };
+
+    for (; query[scan.needleLen] && scan.needleLen < sizeof(scan.needle) - 1; scan.needleLen++) {
+        scan.needle[scan.needleLen] = (char)tolower((unsigned char)query[scan.needleLen]);
+    }
+    return scanLists(listsDir, policy, visitMatch, &scan);
+}
+
+void aptIndexFree(AptIndex *index) {
+    storeFree(&index->packages);
+    trigramFree(&index->trigrams);
+    fullTextFree(&index->text);
+}
+
+static bool addResult(const Package *package, const PackageStore *installed, PackageStore *results) {
+    // 인덱스는 프로그램 종료 때까지 유지되므로 문자열은 복사하지 않고 가리킴
+    Package *result = storeAddShared(results, package);
+    if (!result) return false;
+
+    if (installed && storeFind(installed, package->name)) {
+        result->flags |= PKG_INSTALLED;
+    }
+    return true;
+}
+
+// 부분 일치 항목을 이름순으로 추가 (added에 표시된 항목은 건너뜀)
+static void addMatches(const AptIndex *index, const PackageStore *installed, const char *query,
+                       PackageStore *results, const unsigned char *added) {
+    const PackageStore *packages = &index->packages;
+    int *matches = NULL;
+    int matchCount = trigramQuery(&index->trigrams, packages, query, &matches);
+
+    if (matchCount >= 0) {
+        for (int i = 0; i < matchCount; i++) {
+            if (added && added[matches[i]]) continue;
+            if (!addResult(&packages->items[matches[i]], installed, results)) break;
+        }
+        free(matches);
+    } else {
+        for (int i = 0; i < packages->count; i++) {
+            if ((added && added[i]) || !packageMatches(&packages->items[i], query)) continue;
+            if (!addResult(&packages->items[i], installed, results)) break;
+        }
+    }
+}
+
+// 이름 또는 요약에 질의 문자열이 포함된 패키지를 results에 추가 (대소문자 무시)
+int aptIndexSearch(const AptIndex *index, const PackageStore *installed,
+                   const char *query, PackageStore *results) {
+    addMatches(index, installed, query, results, NULL);
+    results->sorted = index->packages.sorted;
+    return results->count;
+}
+
+// 순위 검색: 이름이 질의와 같은 패키지, BM25 상위 FULLTEXT_TOP_K개, 나머지 부분 일치 (이름순) 순서
+// 전문 검색 색인이 없으면 부분 일치만 (이름이 같은 패키지는 맨 앞)
+int aptIndexRankedSearch(const AptIndex *index, const PackageStore *installed,
+                         const char *query, PackageStore *results) {
+    const PackageStore *packages = &index->packages;
+    char name[PACKAGE_NAME_SIZE];
+    size_t nameLen = 0;
+
+    unsigned char *added = (unsigned char *)calloc((size_t)packages->count + 1, 1);
+    FullTextHit *hits = (FullTextHit *)malloc(FULLTEXT_TOP_K * sizeof(FullTextHit));
+    if (!added || !hits) {
+        free(added);
+        free(hits);
+        return aptIndexSearch(index, installed, query, results);
+    }
+
+    for (; query[nameLen] && nameLen < sizeof(name) - 1; nameLen++) {
+        name[nameLen] = (char)tolower((unsigned char)query[nameLen]);
+    }
+    int exact = storeLookup(packages, name, nameLen);
+    if (exact >= 0 && addResult(&packages->items[exact], installed, results)) added[exact] = 1;
+
+    int hitCount = fullTextQuery(&index->text, query, hits, FULLTEXT_TOP_K);
+    for (int i = 0; i < hitCount; i++) {
+        if (added[hits[i].document]) continue;
+        if (!addResult(&packages->items[hits[i].document], installed, results)) break;
+        added[hits[i].document] = 1;
+    }
+
+    addMatches(index, installed, query, results, added);
+    results->sorted = exact < 0 && hitCount <= 0 && packages->sorted;
+
+    free(added);
+    free(hits);
+    return results->count;
+}
+
+static uint64_t hashBytes(uint64_t hash, const void *data, size_t length) {
+    const unsigned char *bytes = (const unsigned char *)data;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+// 전문 검색 색인의 서명: 인덱스의 이름·버전·요약과 Packages·Translation 파일의 이름·크기·수정 시각
+// (긴 설명은 버전이 같아도 목록 파일이 바뀌면 달라질 수 있음)
+static uint64_t textIndexKey(const AptIndex *index, const char *listsDir) {
+    uint64_t key = 14695981039346656037ull;
+    char path[PATH_BUFFER_SIZE];
+
+    for (int i = 0; i < index->packages.count; i++) {
+        const Package *package = &index->packages.items[i];
+        key = hashBytes(key, package->name, strlen(package->name) + 1);
+        key = hashBytes(key, package->version, strlen(package->version) + 1);
+        key = hashBytes(key, package->description, strlen(package->description) + 1);
+    }
+
+    // readdir 순서에 상관없도록 파일별 서명을 더함
+    uint64_t files = 0;
+    DIR *dir = opendir(listsDir);
+    if (dir) {
+        struct dirent *entry;
+        while ((entry = readdir(dir)) != NULL) {
+            struct stat st;
+            if (!isPackagesList(entry->d_name) && !isTranslationList(entry->d_name, NULL)) continue;
+            if (snprintf(path, sizeof(path), "%s/%s", listsDir, entry->d_name) >= (int)sizeof(path)) continue;
+            if (stat(path, &st) < 0) continue;
+
+            int64_t stamp[3] = { (int64_t)st.st_size, (int64_t)st.st_mtim.tv_sec, (int64_t)st.st_mtim.tv_nsec };
+            uint64_t file = hashBytes(14695981039346656037ull, entry->d_name, strlen(entry->d_name));
+            files += hashBytes(file, stamp, sizeof(stamp));
+        }
+        closedir(dir);
+    }
+    return hashBytes(key, &files, sizeof(files));
+}
+
+// TextBuild.seen 값
+enum {
+    TEXT_PENDING,       // 아직 못 찾음 (끝에 이름·요약만 색인)
+    TEXT_INDEXED,
+    TEXT_WAITING,       // Packages에는 요약뿐이라 md5가 같은 Translation 스탠자를 기다림
+};
+
+typedef struct TextBuild {
+    const PackageStore *packages;
+    FullTextBuilder *builder;
+    unsigned char *seen;
+    char (*md5s)[DESCRIPTION_MD5_SIZE];    // TEXT_WAITING 항목의 Description-md5
+    int waiting;
+} TextBuild;
+
+static void addTextDocument(FullTextBuilder *builder, uint32_t document, const char *name, size_t nameLen,
+                            const char *summary, size_t summaryLen, const char *details, size_t detailsLen) {
+    fullTextAdd(builder, document, name, nameLen, true);
+    fullTextAdd(builder, document, summary, summaryLen, false);
+    fullTextAdd(builder, document, details, detailsLen, false);
+}
+
+// 목록 파일의 스탠자 중 인덱스에 남은 항목(후보 버전)의 이름·요약·긴 설명을 색인
+static bool addTextEntry(const PackageFields *fields, void *context) {
+    TextBuild *build = (TextBuild *)context;
+    int document = storeLookup(build->packages, fields->name, fields->nameLen);
+    if (document < 0 || build->seen[document]) return true;
+
+    const char *version = build->packages->items[document].version;
+    if (!fields->version || strlen(version) != fields->versionLen
+        || memcmp(version, fields->version, fields->versionLen) != 0) {
+        return true;
+    }
+
+    // 요즘 미러는 Packages에 요약과 Description-md5만 두고 긴 설명은 Translation 파일에 둠
+    if (fields->detailsLen == 0 && fields->descriptionMd5Len == DESCRIPTION_MD5_SIZE) {
+        memcpy(build->md5s[document], fields->descriptionMd5, DESCRIPTION_MD5_SIZE);
+        build->seen[document] = TEXT_WAITING;
+        build->waiting++;
+        return true;
+    }
+
+    build->seen[document] = TEXT_INDEXED;
+    addTextDocument(build->builder, (uint32_t)document, fields->name, fields->nameLen,
+                    fields->description, fields->descLen, fields->details, fields->detailsLen);
+    return !build->builder->failed;
+}
+
+// Translation 스탠자 중 이름과 Description-md5가 후보 버전과 같은 것의 요약·긴 설명을 색인
+static bool addTranslationEntry(const PackageFields *fields, void *context) {
+    TextBuild *build = (TextBuild *)context;
+    int document = storeLookup(build->packages, fields->name, fields->nameLen);
+    if (document < 0 || build->seen[document] != TEXT_WAITING) return true;
+    if (fields->descriptionMd5Len != DESCRIPTION_MD5_SIZE
+        || memcmp(build->md5s[document], fields->descriptionMd5, DESCRIPTION_MD5_SIZE) != 0) {
+        return true;
+    }
+
+    build->seen[document] = TEXT_INDEXED;
+    build->waiting--;
+    addTextDocument(build->builder, (uint32_t)document, fields->name, fields->nameLen,
+                    fields->description, fields->descLen, fields->details, fields->detailsLen);
+    return !build->builder->failed && build->waiting > 0;
+}
+
+// 인덱스와 목록 파일의 긴 설명으로 전문 검색 색인 구성 (aptIndexLoad 이후 한 번)
+// cachePath가 있으면 서명이 같은 저장본을 매핑해 쓰고, 없거나 다르면 새로 만들어 저장
+bool aptIndexBuildText(AptIndex *index, const char *listsDir, const char *cachePath) {
+    const PackageStore *packages = &index->packages;
+    FullTextBuilder builder;
+
+    uint64_t start = traceNowUs();
+    fullTextFree(&index->text);
+    if (packages->count == 0) return false;
+
+    uint64_t key = textIndexKey(index, listsDir);
+    if (cachePath && fullTextLoad(&index->text, cachePath, key, (uint32_t)packages->count)) {
+        index->text.buildMs = (traceNowUs() - start) / 1e3;
+        return true;
+    }
+
+    TextBuild build = { .packages = packages, .builder = &builder };
+    build.seen = (unsigned char *)calloc((size_t)packages->count, 1);
+    build.md5s = (char (*)[DESCRIPTION_MD5_SIZE])malloc((size_t)packages->count * DESCRIPTION_MD5_SIZE);
+    if (!build.seen || !build.md5s || !fullTextBegin(&builder, (uint32_t)packages->count)) {
+        // 실패한 구성 상태는 fullTextFinish가 해제
+        if (build.seen && build.md5s) fullTextFinish(&builder, &index->text);
+        free(build.seen);
+        free(build.md5s);
+        return false;
+    }
+
+    scanLists(listsDir, index->policy, addTextEntry, &build);
+    if (build.waiting > 0 && !builder.failed) scanTranslations(listsDir, addTranslationEntry, &build);
+    // 그사이 목록 파일이 바뀌었거나 번역이 없어 찾지 못한 항목은 저장소의 이름·요약만 색인
+    for (int i = 0; i < packages->count; i++) {
+        const Package *package = &packages->items[i];
+        if (build.seen[i] == TEXT_INDEXED) continue;
+        addTextDocument(&builder, (uint32_t)i, package->name, strlen(package->name),
+                        package->description, strlen(package->description), NULL, 0);
+    }
+    free(build.seen);
+    free(build.md5s);
+
+    if (!fullTextFinish(&builder, &index->text)) return false;
+    index->text.buildMs = (traceNowUs() - start) / 1e3;
+
+    if (cachePath) fullTextSave(&index->text, cachePath, key);
+    return true;
+}
+
+// 후보 버전이 설치된 버전보다 높은 패키지를 results에 추가
+// 설치된 버전의 우선순위는 100 (a=now로 맞는 핀이 있으면 그 값). 후보의 우선순위가 그보다 낮으면
+// (NotAutomatic 목록, 설치된 버전을 고정한 핀) apt도 올리지 않음
+// 버전 열은 후보 버전, 요약 앞에는 설치된 버전을 붙임. 결과 수를 반환하고 메모리가 부족하면 -1
+int aptIndexUpgradable(const AptIndex *index, const PackageStore *installed, PackageStore *results) {
+    char description[BUFFER_SIZE];
+    AptListSource status = { .archive = "now", .priority = APT_PRIORITY_INSTALLED };
+
+    for (int i = 0; i < installed->count; i++) {
+        const Package *current = &installed->items[i];
+        const Package *candidate = storeFind(&index->packages, current->name);
+        if (!candidate || versionCompare(candidate->version, current->version) <= 0) continue;
+
+        int currentPriority = index->policy
+            ? aptPolicyPriority(index->policy, &status, current->name, strlen(current->name),
+                                current->version, strlen(current->version))
+            : APT_PRIORITY_INSTALLED;
+        if (packagePriority(candidate) < currentPriority) continue;
+
+        int length = snprintf(description, sizeof(description), "(installed %s) %s",
+                              current->version, candidate->description);
+        if (length < 0) continue;
+        if (length >= (int)sizeof(description)) length = (int)sizeof(description) - 1;
+
+        Package *result = storeAdd(results, current->name, strlen(current->name),
+                                   candidate->version, strlen(candidate->version), description, (size_t)length);
+        if (!result) return -1;
+        result->flags |= PKG_INSTALLED;
+    }
+
+    results->sorted = installed->sorted;
+    return results->count;
+}
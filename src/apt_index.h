@@ -0,0 +1,29 @@
+#ifndef APT_INDEX_H
+#define APT_INDEX_H
+
+#include "package_store.h"
+#include "trigram.h"
+#include "fulltext.h"
+#include "apt_policy.h"
+
+// /var/lib/apt/lists 의 Packages 인덱스를 읽어 만든 검색용 저장소와 트라이그램 색인
+// text는 긴 설명까지 포함한 BM25 색인 (aptIndexBuildText로 따로 구성)
+typedef struct AptIndex {
+    PackageStore packages;
+    TrigramIndex trigrams;
+    FullTextIndex text;
+    const AptPolicy *policy;    // 후보 버전 규칙 (NULL이면 아키텍처·핀 없이 가장 높은 버전)
+} AptIndex;
+
+int aptIndexLoad(AptIndex *index, const char *listsDir, const AptPolicy *policy);
+void aptIndexFree(AptIndex *index);
+int aptIndexSearch(const AptIndex *index, const PackageStore *installed,
+                   const char *query, PackageStore *results);
+int aptIndexRankedSearch(const AptIndex *index, const PackageStore *installed,
+                         const char *query, PackageStore *results);
+bool aptIndexBuildText(AptIndex *index, const char *listsDir, const char *cachePath);
+int aptIndexUpgradable(const AptIndex *index, const PackageStore *installed, PackageStore *results);
+int aptIndexScan(const char *listsDir, const AptPolicy *policy, const char *query,
+                 PackageVisitor visit, void *context);
+
+#endif // APT_INDEX_H
@@ -0,0 +1,354 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <ctype.h>
+#include <dirent.h>
+#include <fnmatch.h>
+#include <regex.h>
+#include <unistd.h>
+#include "apt_policy.h"
+#include "stanza.h"
+
+// 앞뒤 공백을 뺀 값을 NUL 종료 문자열로 복사 (넘치면 자름)
+static void copyValue(char *dest, size_t size, const char *value, size_t length) {
+    while (length > 0 && isspace((unsigned char)*value)) {
+        value++;
+        length--;
+    }
+    while (length > 0 && isspace((unsigned char)value[length - 1])) length--;
+    if (length >= size) length = size - 1;
+    memcpy(dest, value, length);
+    dest[length] = '\0';
+}
+
+static char *dupValue(const char *value, size_t length) {
+    char buffer[BUFFER_SIZE];
+    copyValue(buffer, sizeof(buffer), value, length);
+    return strdup(buffer);
+}
+
+static bool isYes(const char *value, size_t length) {
+    return value && length >= 3 && strncasecmp(value, "yes", 3) == 0;
+}
+
+// 핀의 패턴 하나와 비교. /정규식/ 또는 glob (이름 그대로도 glob으로 일치)
+// 정규식 핀은 드물어 비교할 때마다 컴파일함
+static bool patternMatch(const char *pattern, size_t length, const char *text) {
+    char buffer[APT_PIN_FIELD_SIZE];
+    if (length >= sizeof(buffer)) return false;
+
+    if (length >= 2 && pattern[0] == '/' && pattern[length - 1] == '/') {
+        regex_t regex;
+        memcpy(buffer, pattern + 1, length - 2);
+        buffer[length - 2] = '\0';
+        if (regcomp(&regex, buffer, REG_EXTENDED | REG_NOSUB) != 0) return false;
+        bool matched = regexec(&regex, text, 0, NULL, 0) == 0;
+        regfree(&regex);
+        return matched;
+    }
+    memcpy(buffer, pattern, length);
+    buffer[length] = '\0';
+    return fnmatch(buffer, text, 0) == 0;
+}
+
+// 공백으로 구분한 패키지 패턴 중 하나라도 이름과 맞는지 (src: 핀은 소스 이름을 모르므로 건너뜀)
+static bool packageMatches(const AptPin *pin, const char *name) {
+    const char *p = pin->packages;
+
+    while (*p) {
+        while (isspace((unsigned char)*p)) p++;
+        size_t length = strcspn(p, " \t\n");
+        if (length == 0) break;
+        if (strncmp(p, "src:", 4) != 0 && patternMatch(p, length, name)) return true;
+        p += length;
+    }
+    return false;
+}
+
+// "a=bookworm-backports, c=main" 형식의 조건을 모두 만족하는지. '='가 없으면 v= 로 봄 (apt와 같음)
+static bool releaseMatches(const char *conditions, const AptListSource *source) {
+    const char *p = conditions;
+
+    if (!strchr(conditions, '=')) return patternMatch(conditions, strlen(conditions), source->version);
+
+    while (*p) {
+        while (*p == ',' || isspace((unsigned char)*p)) p++;
+        if (!*p) break;
+        size_t length = strcspn(p, ",");
+        const char *equals = memchr(p, '=', length);
+        if (!equals || equals - p != 1) return false;
+
+        const char *field;
+        switch (*p) {
+            case 'a': field = source->archive; break;
+            case 'n': field = source->codename; break;
+            case 'o': field = source->origin; break;
+            case 'l': field = source->label; break;
+            case 'v': field = source->version; break;
+            case 'c': field = source->component; break;
+            case 'b': field = source->architecture; break;
+            default: return false;
+        }
+
+        char value[APT_PIN_FIELD_SIZE];
+        copyValue(value, sizeof(value), equals + 1, length - 2);
+        if (!patternMatch(value, strlen(value), field)) return false;
+        p += length;
+    }
+    return true;
+}
+
+static bool pinMatches(const AptPin *pin, const AptListSource *source, const char *name, const char *version) {
+    if (!packageMatches(pin, name)) return false;
+
+    switch (pin->type) {
+        case PIN_RELEASE:
+            return source && releaseMatches(pin->value, source);
+        case PIN_VERSION:
+            return patternMatch(pin->value, strlen(pin->value), version);
+        case PIN_ORIGIN:
+            return source && strcasecmp(pin->value, source->site) == 0;
+    }
+    return false;
+}
+
+static bool addPin(AptPolicy *policy, const Stanza *stanza) {
+    size_t packagesLen, pinLen, priorityLen;
+    const char *packages = stanzaGet(stanza, "Package", &packagesLen);
+    const char *pin = stanzaGet(stanza, "Pin", &pinLen);
+    const char *priority = stanzaGet(stanza, "Pin-Priority", &priorityLen);
+    if (!packages || !pin || !priority) return true;
+
+    char pinText[BUFFER_SIZE];
+    copyValue(pinText, sizeof(pinText), pin, pinLen);
+
+    AptPin entry;
+    const char *rest;
+    if (strncmp(pinText, "release", 7) == 0) {
+        entry.type = PIN_RELEASE;
+        rest = pinText + 7;
+    } else if (strncmp(pinText, "version", 7) == 0) {
+        entry.type = PIN_VERSION;
+        rest = pinText + 7;
+    } else if (strncmp(pinText, "origin", 6) == 0) {
+        entry.type = PIN_ORIGIN;
+        rest = pinText + 6;
+    } else {
+        return true;
+    }
+    while (isspace((unsigned char)*rest)) rest++;
+
+    // origin "host" 처럼 따옴표로 감싼 값
+    size_t restLen = strlen(rest);
+    if (restLen >= 2 && rest[0] == '"' && rest[restLen - 1] == '"') {
+        rest++;
+        restLen -= 2;
+    }
+
+    if (policy->pinCount == policy->pinCapacity) {
+        int capacity = policy->pinCapacity ? policy->pinCapacity * 2 : 16;
+        AptPin *pins = (AptPin *)realloc(policy->pins, (size_t)capacity * sizeof(AptPin));
+        if (!pins) return false;
+        policy->pins = pins;
+        policy->pinCapacity = capacity;
+    }
+
+    entry.packages = dupValue(packages, packagesLen);
+    entry.value = strndup(rest, restLen);
+    entry.priority = atoi(priority);
+    if (!entry.packages || !entry.value) {
+        free(entry.packages);
+        free(entry.value);
+        return false;
+    }
+    entry.general = strcmp(entry.packages, "*") == 0;
+    policy->pins[policy->pinCount++] = entry;
+    return true;
+}
+
+// preferences 형식 파일 하나의 핀을 차례로 추가 (없거나 빈 파일은 무시)
+static bool readPreferences(AptPolicy *policy, const char *path) {
+    MappedFile file;
+    StanzaReader reader;
+    Stanza stanza;
+    bool ok = true;
+
+    if (!mapFile(path, &file)) return true;
+    stanzaReaderInit(&reader, file.data, file.size);
+    while (ok && stanzaNext(&reader, &stanza)) {
+        ok = addPin(policy, &stanza);
+    }
+    unmapFile(&file);
+    return ok;
+}
+
+// apt가 읽는 preferences.d 파일 이름: 영숫자·'-'·'_'·'.'만 쓰고 확장자가 없거나 .pref
+static int isPreferencesFile(const struct dirent *entry) {
+    const char *name = entry->d_name;
+    if (name[0] == '.') return 0;
+
+    for (const char *p = name; *p; p++) {
+        if (!isalnum((unsigned char)*p) && *p != '-' && *p != '_' && *p != '.') return 0;
+    }
+    const char *dot = strrchr(name, '.');
+    return !dot || strcmp(dot, ".pref") == 0;
+}
+
+// preferencesPath와 preferencesPath.d/ 의 핀을 apt와 같은 순서(파일, 디렉터리의 이름순)로 읽음
+// 파일이 없으면 핀 없이 성공. 메모리가 부족하면 false
+bool aptPolicyLoad(AptPolicy *policy, const char *preferencesPath, const char *architecture) {
+    char path[PATH_BUFFER_SIZE];
+    struct dirent **entries;
+
+    memset(policy, 0, sizeof(*policy));
+    policy->architecture = architecture;
+    if (!preferencesPath) return true;
+
+    if (!readPreferences(policy, preferencesPath)) return false;
+
+    if (snprintf(path, sizeof(path), "%s.d", preferencesPath) >= (int)sizeof(path)) return true;
+    int count = scandir(path, &entries, isPreferencesFile, alphasort);
+    bool ok = true;
+    for (int i = 0; i < count; i++) {
+        char filePath[PATH_BUFFER_SIZE];
+        if (ok && snprintf(filePath, sizeof(filePath), "%s/%s", path, entries[i]->d_name) < (int)sizeof(filePath)) {
+            ok = readPreferences(policy, filePath);
+        }
+        free(entries[i]);
+    }
+    if (count >= 0) free(entries);
+    return ok;
+}
+
+void aptPolicyFree(AptPolicy *policy) {
+    for (int i = 0; i < policy->pinCount; i++) {
+        free(policy->pins[i].packages);
+        free(policy->pins[i].value);
+    }
+    free(policy->pins);
+    memset(policy, 0, sizeof(*policy));
+}
+
+// 파일 이름의 binary-ARCH 부분 (없으면 빈 문자열)
+static void listArchitecture(const char *fileName, char *architecture, size_t size) {
+    const char *binary = strstr(fileName, "_binary-");
+    architecture[0] = '\0';
+    if (!binary) return;
+
+    binary += 8;
+    copyValue(architecture, size, binary, strcspn(binary, "_"));
+}
+
+bool aptPolicyArchitecture(const AptPolicy *policy, const char *architecture, size_t length) {
+    if (!policy || !policy->architecture || !architecture) return true;
+    return (length == 3 && strncmp(architecture, "all", 3) == 0)
+        || (strlen(policy->architecture) == length && strncmp(architecture, policy->architecture, length) == 0);
+}
+
+// 다른 아키텍처(i386 등 추가 아키텍처)의 목록은 읽지 않음
+bool aptPolicyWantsList(const AptPolicy *policy, const char *fileName) {
+    char architecture[APT_PIN_FIELD_SIZE];
+
+    listArchitecture(fileName, architecture, sizeof(architecture));
+    return !architecture[0] || aptPolicyArchitecture(policy, architecture, strlen(architecture));
+}
+
+// prefix 뒤에 InRelease, 없으면 Release를 붙인 파일에서 출처 필드를 읽음
+static bool readRelease(AptListSource *source, const char *listsDir, const char *prefix, size_t prefixLen) {
+    static const char *const names[] = { "InRelease", "Release" };
+    char path[PATH_BUFFER_SIZE];
+    MappedFile file;
+
+    for (size_t i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+        int length = snprintf(path, sizeof(path), "%s/%.*s%s", listsDir, (int)prefixLen, prefix, names[i]);
+        if (length >= (int)sizeof(path) || !mapFile(path, &file)) continue;
+
+        // InRelease는 서명 머리글 다음 스탠자가 본문
+        StanzaReader reader;
+        Stanza stanza;
+        bool found = false;
+        stanzaReaderInit(&reader, file.data, file.size);
+        while (!found && stanzaNext(&reader, &stanza)) {
+            size_t suiteLen, codenameLen, originLen, labelLen, versionLen, notAutoLen, butAutoLen;
+            const char *suite = stanzaGet(&stanza, "Suite", &suiteLen);
+            const char *codename = stanzaGet(&stanza, "Codename", &codenameLen);
+            if (!suite && !codename) continue;
+
+            const char *origin = stanzaGet(&stanza, "Origin", &originLen);
+            const char *label = stanzaGet(&stanza, "Label", &labelLen);
+            const char *version = stanzaGet(&stanza, "Version", &versionLen);
+            const char *notAuto = stanzaGet(&stanza, "NotAutomatic", &notAutoLen);
+            const char *butAuto = stanzaGet(&stanza, "ButAutomaticUpgrades", &butAutoLen);
+            if (suite) copyValue(source->archive, sizeof(source->archive), suite, suiteLen);
+            if (codename) copyValue(source->codename, sizeof(source->codename), codename, codenameLen);
+            if (origin) copyValue(source->origin, sizeof(source->origin), origin, originLen);
+            if (label) copyValue(source->label, sizeof(source->label), label, labelLen);
+            if (version) copyValue(source->version, sizeof(source->version), version, versionLen);
+            if (isYes(notAuto, notAutoLen)) {
+                source->priority = isYes(butAuto, butAutoLen) ? APT_PRIORITY_BUT_AUTOMATIC
+                                                              : APT_PRIORITY_NOT_AUTOMATIC;
+            }
+            found = true;
+        }
+        unmapFile(&file);
+        if (found) return true;
+    }
+    return false;
+}
+
+// 목록 파일 이름(apt가 URI의 '/'를 '_'로 바꾼 것)으로 Release 파일을 찾아 출처를 채움
+//   host_debian_dists_bookworm-backports_main_binary-amd64_Packages
+//   → host_debian_dists_bookworm-backports_InRelease, 구성 요소 main
+// 스위트에 '/'가 들어 있을 수 있어 (bookworm/updates) 짧은 접두어부터 차례로 시도
+// Release 파일이 없으면 기본 우선순위(500)의 빈 출처
+void aptListSourceRead(AptListSource *source, const char *listsDir, const char *fileName) {
+    memset(source, 0, sizeof(*source));
+    source->priority = APT_PRIORITY_DEFAULT;
+    copyValue(source->site, sizeof(source->site), fileName, strcspn(fileName, "_"));
+    listArchitecture(fileName, source->architecture, sizeof(source->architecture));
+
+    const char *dists = strstr(fileName, "_dists_");
+    if (!dists) {
+        // 평면 저장소 (deb URI ./): 접두어는 마지막 "_Packages" 앞까지
+        const char *packages = strstr(fileName, "_Packages");
+        if (packages) readRelease(source, listsDir, fileName, (size_t)(packages - fileName) + 1);
+        return;
+    }
+
+    const char *binary = strstr(dists, "_binary-");
+    const char *limit = binary ? binary : fileName + strlen(fileName);
+    for (const char *p = dists + 7; p < limit; p++) {
+        if (*p != '_') continue;
+        if (!readRelease(source, listsDir, fileName, (size_t)(p - fileName) + 1)) continue;
+
+        // 접두어 다음부터 binary- 앞까지가 구성 요소 (main/debian-installer처럼 '_'로 바뀐 '/' 복원)
+        copyValue(source->component, sizeof(source->component), p + 1, (size_t)(limit - p - 1));
+        for (char *c = source->component; *c; c++) {
+            if (*c == '_') *c = '/';
+        }
+        return;
+    }
+}
+
+// 목록 파일 source에 있는 name 버전 version의 핀 우선순위
+// 패키지를 지정한 핀을 먼저, 그다음 "Package: *" 핀을 파일 순서대로 보고 처음 맞는 것을 씀
+int aptPolicyPriority(const AptPolicy *policy, const AptListSource *source,
+                      const char *name, size_t nameLen, const char *version, size_t versionLen) {
+    int fallback = source ? source->priority : APT_PRIORITY_DEFAULT;
+    if (!policy || policy->pinCount == 0) return fallback;
+
+    char nameText[MAX_PACKAGE_NAME_LENGTH + 1];
+    char versionText[APT_PIN_FIELD_SIZE];
+    copyValue(nameText, sizeof(nameText), name, nameLen);
+    copyValue(versionText, sizeof(versionText), version ? version : "", version ? versionLen : 0);
+
+    for (int pass = 0; pass < 2; pass++) {
+        for (int i = 0; i < policy->pinCount; i++) {
+            const AptPin *pin = &policy->pins[i];
+            if (pin->general != (pass == 1)) continue;
+            if (pinMatches(pin, source, nameText, versionText)) return pin->priority;
+        }
+    }
+    return fallback;
+}
@@ -0,0 +1,56 @@
+#ifndef APT_POLICY_H
+#define APT_POLICY_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "constants.h"
+
+// apt가 후보 버전을 고르는 규칙 중 목록 파일만으로 판단할 수 있는 부분
+//   - 목록의 Release 파일이 NotAutomatic이면 우선순위 1, ButAutomaticUpgrades도 있으면 100, 아니면 500
+//   - /etc/apt/preferences{,.d}의 Pin-Priority가 맞으면 그 값 (패키지를 지정한 핀, 그다음 "*" 핀 순으로 첫 일치)
+//   - 기본 아키텍처와 "all" 스탠자만 후보
+// 후보는 우선순위가 가장 높은 버전, 같으면 높은 버전. 설치된 버전은 우선순위 100으로 취급
+
+// 목록 파일 하나의 출처 (Release 파일과 파일 이름에서 얻음)
+typedef struct AptListSource {
+    char archive[APT_PIN_FIELD_SIZE];     // Suite (a=)
+    char codename[APT_PIN_FIELD_SIZE];    // n=
+    char origin[APT_PIN_FIELD_SIZE];      // o=
+    char label[APT_PIN_FIELD_SIZE];       // l=
+    char version[APT_PIN_FIELD_SIZE];     // v=
+    char component[APT_PIN_FIELD_SIZE];   // c= (파일 이름에서)
+    char site[APT_PIN_FIELD_SIZE];        // "Pin: origin"이 비교하는 호스트 (파일 이름 첫 부분)
+    char architecture[APT_PIN_FIELD_SIZE];  // 파일 이름의 binary-ARCH (없으면 빈 문자열)
+    int priority;                         // 핀이 없을 때의 우선순위
+} AptListSource;
+
+typedef enum AptPinType {
+    PIN_RELEASE,
+    PIN_VERSION,
+    PIN_ORIGIN,
+} AptPinType;
+
+typedef struct AptPin {
+    char *packages;         // 공백으로 구분한 이름·glob·/정규식/ ("*"이면 모든 패키지)
+    char *value;            // release 조건 목록, version glob, origin 호스트
+    AptPinType type;
+    bool general;           // Package: *
+    int priority;
+} AptPin;
+
+typedef struct AptPolicy {
+    const char *architecture;
+    AptPin *pins;
+    int pinCount;
+    int pinCapacity;
+} AptPolicy;
+
+bool aptPolicyLoad(AptPolicy *policy, const char *preferencesPath, const char *architecture);
+void aptPolicyFree(AptPolicy *policy);
+bool aptPolicyWantsList(const AptPolicy *policy, const char *fileName);
+void aptListSourceRead(AptListSource *source, const char *listsDir, const char *fileName);
+bool aptPolicyArchitecture(const AptPolicy *policy, const char *architecture, size_t length);
+int aptPolicyPriority(const AptPolicy *policy, const AptListSource *source,
+                      const char *name, size_t nameLen, const char *version, size_t versionLen);
+
+#endif // APT_POLICY_H
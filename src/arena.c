@@ -0,0 +1,66 @@
+#include <stdlib.h>
+#include <string.h>
+#include "arena.h"
+
+void arenaInit(Arena *arena, size_t blockSize) {
+    arena->head = NULL;
+    arena->blockSize = blockSize;
+    arena->bytesUsed = 0;
+    arena->bytesReserved = 0;
+}
+
+static ArenaBlock *arenaGrow(Arena *arena, size_t minSize) {
+    size_t size = arena->blockSize;
+    if (size < minSize) size = minSize;
+
+    ArenaBlock *block = (ArenaBlock *)malloc(sizeof(ArenaBlock) + size);
+    if (!block) return NULL;
+
+    block->next = arena->head;
+    block->used = 0;
+    block->size = size;
+    arena->head = block;
+    arena->bytesReserved += size;
+    return block;
+}
+
+void *arenaAlloc(Arena *arena, size_t size, size_t align) {
+    ArenaBlock *block = arena->head;
+    size_t offset = 0;
+
+    if (align == 0) align = 1;
+    if (block) {
+        offset = (block->used + align - 1) & ~(align - 1);
+    }
+
+    if (!block || offset + size > block->size) {
+        block = arenaGrow(arena, size + align);
+        if (!block) return NULL;
+        offset = 0;
+    }
+
+    block->used = offset + size;
+    arena->bytesUsed += size;
+    return block->data + offset;
+}
+
+char *arenaStrndup(Arena *arena, const char *str, size_t length) {
+    char *copy = (char *)arenaAlloc(arena, length + 1, 1);
+    if (!copy) return NULL;
+
+    if (length) memcpy(copy, str, length);
+    copy[length] = '\0';
+    return copy;
+}
+
+void arenaFree(Arena *arena) {
+    ArenaBlock *block = arena->head;
+    while (block) {
+        ArenaBlock *next = block->next;
+        free(block);
+        block = next;
+    }
+    arena->head = NULL;
+    arena->bytesUsed = 0;
+    arena->bytesReserved = 0;
+}
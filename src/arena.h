@@ -0,0 +1,26 @@
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+// 범프 할당기 블록. 블록 단위로만 해제됨
+typedef struct ArenaBlock {
+    struct ArenaBlock *next;
+    size_t used;
+    size_t size;
+    char data[];
+} ArenaBlock;
+
+typedef struct Arena {
+    ArenaBlock *head;
+    size_t blockSize;
+    size_t bytesUsed;      // 실제로 할당해 준 바이트
+    size_t bytesReserved;  // 블록으로 확보한 바이트
+} Arena;
+
+void arenaInit(Arena *arena, size_t blockSize);
+void *arenaAlloc(Arena *arena, size_t size, size_t align);
+char *arenaStrndup(Arena *arena, const char *str, size_t length);
+void arenaFree(Arena *arena);
+
+#endif // ARENA_H
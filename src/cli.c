@@ -0,0 +1,357 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/wait.h>
+#include "cli.h"
+#include "package_manager.h"
+#include "package_store.h"
+#include "apt_index.h"
+#include "pager.h"
+#include "config.h"
+#include "constants.h"
+#include "utils.h"
+
+// 출력 한 줄(항목 하나)을 쓰는 동안 필요한 상태
+typedef struct CliOutput {
+    CliFormat format;
+    int fields;     // 지금 줄에 쓴 필드 수
+} CliOutput;
+
+static void writeTsvValue(const char *value, size_t length) {
+    size_t plain = 0;
+
+    for (size_t i = 0; i < length; i++) {
+        const char *escape = value[i] == '\t' ? "\\t" : value[i] == '\n' ? "\\n" : value[i] == '\\' ? "\\\\" : NULL;
+        if (!escape) continue;
+        fwrite(value + plain, 1, i - plain, stdout);
+        fputs(escape, stdout);
+        plain = i + 1;
+    }
+    fwrite(value + plain, 1, length - plain, stdout);
+}
+
+static void writeJsonString(const char *value, size_t length) {
+    size_t plain = 0;
+
+    putchar('"');
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)value[i];
+        if (c >= 0x20 && c != '"' && c != '\\') continue;
+
+        fwrite(value + plain, 1, i - plain, stdout);
+        if (c == '"' || c == '\\') printf("\\%c", c);
+        else if (c == '\n') fputs("\\n", stdout);
+        else if (c == '\t') fputs("\\t", stdout);
+        else printf("\\u%04x", c);
+        plain = i + 1;
+    }
+    fwrite(value + plain, 1, length - plain, stdout);
+    putchar('"');
+}
+
+static void beginRecord(CliOutput *out) {
+    out->fields = 0;
+    if (out->format == CLI_JSON) putchar('{');
+}
+
+// TSV는 열 순서로 값만, JSON은 키와 값. value가 NULL이면 빈 문자열
+static void writeField(CliOutput *out, const char *key, const char *value, size_t length) {
+    if (!value) length = 0;
+
+    if (out->format == CLI_JSON) {
+        if (out->fields > 0) putchar(',');
+        writeJsonString(key, strlen(key));
+        putchar(':');
+        writeJsonString(value ? value : "", length);
+    } else {
+        if (out->fields > 0) putchar('\t');
+        writeTsvValue(value ? value : "", length);
+    }
+    out->fields++;
+}
+
+static void endRecord(CliOutput *out) {
+    if (out->format == CLI_JSON) putchar('}');
+    putchar('\n');
+}
+
+// 목록·검색·설치 결과의 공통 행: 이름, 버전, 상태, 요약
+static void writePackageRow(CliFormat format, const PackageFields *fields, const char *state) {
+    CliOutput out = { format, 0 };
+
+    beginRecord(&out);
+    writeField(&out, "name", fields->name, fields->nameLen);
+    writeField(&out, "version", fields->version, fields->versionLen);
+    writeField(&out, "state", state, strlen(state));
+    writeField(&out, "summary", fields->description, fields->descLen);
+    endRecord(&out);
+}
+
+static bool printInstalled(const PackageFields *fields, void *context) {
+    writePackageRow(*(const CliFormat *)context, fields, "installed");
+    return true;
+}
+
+static int runList(CliFormat format) {
+    if (streamInstalled(printInstalled, &format) < 0) {
+        fprintf(stderr, "Cannot read installed packages from %s\n", config.statusPath);
+        return CLI_EXIT_ERROR;
+    }
+    return CLI_EXIT_OK;
+}
+
+typedef struct SearchOutput {
+    CliFormat format;
+    PackageStore seen;              // 여러 목록 파일에 같은 패키지가 있으면 처음 것만 출력
+    const PackageStore *installed;
+    int count;
+} SearchOutput;
+
+static bool printMatch(const PackageFields *fields, void *context) {
+    SearchOutput *search = (SearchOutput *)context;
+
+    if (storeLookup(&search->seen, fields->name, fields->nameLen) >= 0) return true;
+    storeAdd(&search->seen, fields->name, fields->nameLen, NULL, 0, NULL, 0);
+
+    bool installed = storeLookup(search->installed, fields->name, fields->nameLen) >= 0;
+    writePackageRow(search->format, fields, installed ? "installed" : "available");
+    search->count++;
+    return true;
+}
+
+// 내려받은 Packages 목록을 색인 없이 한 번 훑음. 목록이 없으면 apt search
+static int runSearch(CliFormat format, const char *query) {
+    SearchOutput search = { .format = format };
+    PackageStore installed;
+
+    if (!query[0] || strlen(query) >= FILTER_QUERY_SIZE) {
+        fprintf(stderr, "Invalid search query\n");
+        return CLI_EXIT_USAGE;
+    }
+
+    storeInit(&installed);
+    loadPackages(&installed);
+    storeInit(&search.seen);
+    storeBuildIndex(&search.seen);
+    search.installed = &installed;
+
+    // 인덱스를 만들지 않아도 다른 아키텍처의 목록은 보이지 않도록 같은 규칙으로 거름
+    AptPolicy policy;
+    aptPolicyLoad(&policy, NULL, config.architecture);
+    int files = aptIndexScan(config.listsDir, &policy, query, printMatch, &search);
+    aptPolicyFree(&policy);
+    bool ok = files > 0;
+    if (!ok) {
+        // apt search에는 단어마다 인자 하나로 넘기며, 단어에는 패키지 이름에 쓰는 문자만 허용
+        if (!isValidSearchQuery(query)) {
+            fprintf(stderr, "No package lists in %s; apt search needs words of name characters\n",
+                    config.listsDir);
+        } else {
+            ok = streamAptSearch(query, printMatch, &search) >= 0;
+        }
+    }
+
+    storeFree(&search.seen);
+    storeFree(&installed);
+    if (!ok) return CLI_EXIT_ERROR;
+    return search.count > 0 ? CLI_EXIT_OK : CLI_EXIT_NOT_FOUND;
+}
+
+// 필드 값 버퍼 (이어지는 줄을 붙여 가며 씀)
+typedef struct FieldValue {
+    char *data;
+    size_t length;
+    size_t capacity;
+} FieldValue;
+
+static bool valueAppend(FieldValue *value, const char *str, size_t length) {
+    if (value->length + length > value->capacity) {
+        size_t capacity = value->capacity ? value->capacity : BUFFER_SIZE;
+        while (capacity < value->length + length) capacity *= 2;
+        char *data = (char *)realloc(value->data, capacity);
+        if (!data) return false;
+        value->data = data;
+        value->capacity = capacity;
+    }
+    memcpy(value->data + value->length, str, length);
+    value->length += length;
+    return true;
+}
+
+// apt-cache show 출력의 항목 하나 (빈 줄까지)를 필드 단위로 출력하고 다음 줄 번호를 돌려줌
+// 이어지는 줄은 앞의 공백 하나를 떼고 값에 줄바꿈으로 붙임
+static int writeStanza(CliFormat format, const TextBuffer *text, int first) {
+    CliOutput out = { format, 0 };
+    FieldValue value = { 0 };
+    int line = first;
+
+    beginRecord(&out);
+    while (line < text->lineCount && textLine(text, line)[0]) {
+        const char *str = textLine(text, line);
+        const char *colon = strchr(str, ':');
+        line++;
+        if (!colon || str[0] == ' ') continue;
+
+        const char *start = colon[1] == ' ' ? colon + 2 : colon + 1;
+        value.length = 0;
+        valueAppend(&value, start, strlen(start));
+        for (; line < text->lineCount && textLine(text, line)[0] == ' '; line++) {
+            const char *next = textLine(text, line);
+            valueAppend(&value, "\n", 1);
+            valueAppend(&value, next + 1, strlen(next + 1));
+        }
+
+        if (format == CLI_TSV) {
+            // 필드마다 "이름\t값" 한 줄, 항목 사이는 빈 줄
+            fwrite(str, 1, (size_t)(colon - str), stdout);
+            putchar('\t');
+            writeTsvValue(value.data, value.length);
+            putchar('\n');
+        } else {
+            char key[PACKAGE_NAME_SIZE];
+            snprintf(key, sizeof(key), "%.*s", (int)(colon - str), str);
+            writeField(&out, key, value.data, value.length);
+        }
+    }
+    if (format == CLI_JSON) endRecord(&out);
+    else putchar('\n');
+
+    free(value.data);
+    return line;
+}
+
+static int runShow(CliFormat format, char **names, int count) {
+    int status = CLI_EXIT_OK;
+
+    // 한 번 실행하고 끝나므로 도우미 프로세스를 띄우지 않음
+    config.helperPath = NULL;
+    for (int i = 0; i < count; i++) {
+        TextBuffer text;
+        textInit(&text);
+
+        if (!isValidPackageName(names[i])) {
+            fprintf(stderr, "Invalid package name: %s\n", names[i]);
+            status = CLI_EXIT_USAGE;
+        } else if (!fetchPackageText(names[i], NULL, &text) || text.lineCount == 0) {
+            fprintf(stderr, "Package not found: %s\n", names[i]);
+            if (status == CLI_EXIT_OK) status = CLI_EXIT_NOT_FOUND;
+        } else {
+            for (int line = 0; line < text.lineCount; line++) {
+                if (textLine(&text, line)[0]) line = writeStanza(format, &text, line);
+            }
+        }
+        textFree(&text);
+    }
+    return status;
+}
+
+// [sudo] apt-get install -y 이름... 을 실행하고 종료 상태를 돌려줌
+// 결과 행만 표준 출력에 남도록 apt-get의 출력은 표준 오류로 보냄
+static int runAptInstall(char **names, int count) {
+    char *argv[CLI_INSTALL_MAX + 5];
+    int argc = 0;
+
+    if (config.sudoPath) argv[argc++] = (char *)config.sudoPath;
+    argv[argc++] = (char *)config.aptGetPath;
+    argv[argc++] = "install";
+    argv[argc++] = "-y";
+    for (int i = 0; i < count; i++) argv[argc++] = names[i];
+    argv[argc] = NULL;
+
+    fflush(stdout);
+    pid_t pid = fork();
+    if (pid < 0) return -1;
+    if (pid == 0) {
+        dup2(STDERR_FILENO, STDOUT_FILENO);
+        setenv("DEBIAN_FRONTEND", "noninteractive", 1);
+        execvp(argv[0], argv);
+        fprintf(stderr, "Failed to execute %s: %s\n", argv[0], strerror(errno));
+        _exit(127);
+    }
+
+    int status;
+    while (waitpid(pid, &status, 0) < 0) {
+        if (errno != EINTR) return -1;
+    }
+    return WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+}
+
+static int runInstall(CliFormat format, char **names, int count) {
+    if (count > CLI_INSTALL_MAX) {
+        fprintf(stderr, "Too many packages (max %d)\n", CLI_INSTALL_MAX);
+        return CLI_EXIT_USAGE;
+    }
+    for (int i = 0; i < count; i++) {
+        if (!isValidPackageName(names[i])) {
+            fprintf(stderr, "Invalid package name: %s\n", names[i]);
+            return CLI_EXIT_USAGE;
+        }
+    }
+
+    int status = runAptInstall(names, count);
+    if (status < 0) {
+        fprintf(stderr, "Failed to run %s: %s\n", config.aptGetPath, strerror(errno));
+        return CLI_EXIT_ERROR;
+    }
+
+    // 설치 뒤의 상태를 다시 읽어 요청한 패키지마다 결과 한 행
+    PackageStore installed;
+    storeInit(&installed);
+    config.useCache = false;
+    loadPackages(&installed);
+    for (int i = 0; i < count; i++) {
+        const Package *package = storeFind(&installed, names[i]);
+        PackageFields fields = { .name = names[i], .nameLen = strlen(names[i]) };
+        if (package) {
+            fields.version = package->version;
+            fields.versionLen = strlen(package->version);
+            fields.description = package->description;
+            fields.descLen = strlen(package->description);
+        }
+        writePackageRow(format, &fields, package ? "installed" : "not-installed");
+    }
+    storeFree(&installed);
+
+    // apt-get이 실패하면 그 종료 코드를 그대로 돌려줌 (보통 100)
+    return status;
+}
+
+bool cliParseFormat(const char *name, CliFormat *format) {
+    if (strcmp(name, "tsv") == 0) {
+        *format = CLI_TSV;
+    } else if (strcmp(name, "json") == 0) {
+        *format = CLI_JSON;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+int cliRun(CliCommand command, CliFormat format, char **args, int argCount) {
+    int status;
+
+    switch (command) {
+        case CLI_LIST:
+            status = runList(format);
+            break;
+        case CLI_SEARCH:
+            status = runSearch(format, args[0]);
+            break;
+        case CLI_SHOW:
+        case CLI_INSTALL:
+            if (argCount == 0) {
+                fprintf(stderr, "No package names given\n");
+                return CLI_EXIT_USAGE;
+            }
+            status = command == CLI_SHOW ? runShow(format, args, argCount) : runInstall(format, args, argCount);
+            break;
+        default:
+            return CLI_EXIT_USAGE;
+    }
+
+    // 파이프가 닫히는 등 출력에 실패하면 성공으로 끝내지 않음
+    if (fflush(stdout) != 0 && status == CLI_EXIT_OK) status = CLI_EXIT_ERROR;
+    return status;
+}
@@ -0,0 +1,24 @@
+#ifndef CLI_H
+#define CLI_H
+
+#include <stdbool.h>
+
+// 화면 없이 한 가지 일만 하고 끝나는 실행 (스크립트·다른 도구에서 호출)
+// 결과는 표준 출력에 한 줄에 한 항목, 진행 메시지와 오류는 표준 오류로 보냄
+typedef enum {
+    CLI_NONE,
+    CLI_LIST,       // 설치된 패키지
+    CLI_SEARCH,     // 이름·요약 검색
+    CLI_SHOW,       // apt-cache show 항목
+    CLI_INSTALL,    // apt-get install 후 결과 상태
+} CliCommand;
+
+typedef enum {
+    CLI_TSV,        // 탭으로 나눈 열 (값 안의 탭·줄바꿈·역슬래시는 \t \n \\)
+    CLI_JSON,       // 한 줄에 JSON 객체 하나 (NDJSON)
+} CliFormat;
+
+bool cliParseFormat(const char *name, CliFormat *format);
+int cliRun(CliCommand command, CliFormat format, char **args, int argCount);
+
+#endif // CLI_H
@@ -0,0 +1,19 @@
+#include "config.h"
+#include "constants.h"
+
+Config config = {
+    .statusPath = DPKG_STATUS_PATH,
+    .listsDir = APT_LISTS_DIR,
+    .extendedStatesPath = APT_EXTENDED_STATES_PATH,
+    .preferencesPath = APT_PREFERENCES_PATH,
+    .architecture = NATIVE_ARCHITECTURE,
+    .forceDpkgQuery = false,
+    .useCache = true,
+    .showFrameStats = false,
+    .aptGetPath = APT_GET_PATH,
+    .sudoPath = SUDO_PATH,
+    .detailCacheBytes = (size_t)DETAIL_CACHE_DEFAULT_MB * 1024 * 1024,
+    .prefetchWindow = PREFETCH_WINDOW,
+    .searchJobs = SEARCH_JOBS,
+    .helperPath = HELPER_SELF_PATH,
+};
@@ -0,0 +1,27 @@
+#ifndef CONFIG_H
+#define CONFIG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// 실행 중 변경 가능한 설정 (명령행 옵션으로 덮어씀)
+typedef struct Config {
+    const char *statusPath;   // dpkg status 파일 경로
+    const char *listsDir;     // apt Packages 인덱스 디렉터리
+    const char *extendedStatesPath;  // apt 자동 설치 표시 (설치 이유 표시용)
+    const char *preferencesPath;     // apt 핀 설정 (같은 이름 + ".d" 디렉터리도 읽음)
+    const char *architecture;        // 후보로 삼는 목록 스탠자의 아키텍처 ("all"과 함께). NULL이면 거르지 않음
+    bool forceDpkgQuery;      // 내장 파서 대신 dpkg-query 사용
+    bool useCache;            // 설치 목록 스냅샷 캐시 사용
+    bool showFrameStats;      // 목록 프레임당 출력 바이트 표시
+    const char *aptGetPath;   // 설치·삭제·업데이트에 쓸 apt-get (테스트용 대역 스크립트로 교체 가능)
+    const char *sudoPath;     // 권한 상승 명령 (NULL이면 직접 실행)
+    size_t detailCacheBytes;  // 상세 정보 캐시 메모리 상한 (0이면 캐시 안 함)
+    const char *helperPath;   // 상세 정보 도우미 실행 파일 (NULL이면 요청마다 popen)
+    int prefetchWindow;       // 커서 위아래로 상세 정보를 미리 가져올 줄 수 (0이면 안 함)
+    int searchJobs;           // 검색 결과 상세 정보를 동시에 가져오는 작업 스레드 수
+} Config;
+
+extern Config config;
+
+#endif // CONFIG_H
@@ -5,8 +5,6 @@
 #define BUFFER_SIZE 1024
 #define COMMAND_SIZE 512
 #define PACKAGE_NAME_SIZE 256
-#define MAX_PACKAGES 1024
-#define MAX_LINES 1000
 #define MAX_PACKAGE_NAME_LENGTH 255
 
 // 패키지 관리 액션
@@ -14,10 +12,127 @@
 #define ACTION_REMOVE 1
 #define ACTION_UPDATE 2
 
+// 표시 검토 화면 결과
+#define REVIEW_BACK 0
+#define REVIEW_APPLY 1
+#define REVIEW_CLEAR 2
+
+// 작업(apt-get 실행) 관련 상수
+#define JOB_MAX_STEPS 2
+#define JOB_OUTPUT_LINES 500
+#define JOB_LINE_SIZE 256
+#define JOB_TITLE_SIZE 128
+#define JOB_PANE_ROWS 8
+#define JOB_POLL_MS 200
+#define REFRESH_DELAY_MS 250      // dpkg가 status를 연달아 쓰는 동안 갱신을 미룸
+#define APT_GET_PATH "apt-get"
+#define SUDO_PATH "sudo"
+#define APT_CACHE_PATH "apt-cache"
+#define HELPER_SELF_PATH "/proc/self/exe"
+
+// 상세 정보 뷰어 관련 상수
+#define PAGER_INITIAL_SIZE 4096
+#define PAGER_INITIAL_LINES 64
+#define PAGER_QUERY_SIZE 128
+
+// 상세 정보 캐시 관련 상수
+#define DETAIL_CACHE_DEFAULT_MB 8
+#define DETAIL_CACHE_INITIAL_BUCKETS 64
+#define PREFETCH_WINDOW 4                 // 커서 위아래로 미리 가져올 줄 수
+#define PREFETCH_WINDOW_MAX 32
+#define PREFETCH_QUEUE_SIZE (PREFETCH_WINDOW_MAX * 2 + 1)
+#define PREFETCH_BATCH 8                  // 작업 스레드가 한 번에 도우미에 요청하는 항목 수
+#define HELPER_BATCH_MAX 64
+#define SEARCH_JOBS 4                     // 검색 결과 상세 정보를 동시에 가져오는 작업 스레드 수
+#define SEARCH_JOBS_MAX 16
+#define SEARCH_JOB_CHUNK 8                // 작업 스레드가 한 번에 가져가는 결과 수
+#define SEARCH_FETCHING_TEXT "(fetching details...)"
+
+// 비대화형 명령 (--list, --search, --show, --install) 종료 코드
+#define CLI_EXIT_OK 0
+#define CLI_EXIT_ERROR 1          // 목록·apt를 읽지 못함
+#define CLI_EXIT_USAGE 2          // 잘못된 인자
+#define CLI_EXIT_NOT_FOUND 3      // 검색 결과가 없거나 없는 패키지
+#define CLI_INSTALL_MAX 64
+
+// 의존 관계 그래프 관련 상수
+#define DEP_INITIAL_CAPACITY 1024
+#define DEP_WHY_PATH_MAX 64       // 설치 이유 경로에 표시하는 최대 패키지 수
+#define DEP_STATS_SAMPLES 1000    // --stats에서 질의 시간을 재는 패키지 수
+
+// 필터 관련 상수
+#define FILTER_QUERY_SIZE 128
+
 // UI 관련 상수
 #define HEADER_LINES 2
 #define FOOTER_LINES 1
 #define MIN_ROWS 10
 #define MIN_COLS 40
+#define KEY_ESCAPE 27
+#define ESCAPE_DELAY_MS 25
+#define TRACE_MAX_NAMES 32        // 화면 통계에 모아 두는 구간 이름 수
+#define TRACE_OVERLAY_WIDTH 54
+
+// 경로 상수
+#define DPKG_STATUS_PATH "/var/lib/dpkg/status"
+#define APT_LISTS_DIR "/var/lib/apt/lists"
+#define APT_EXTENDED_STATES_PATH "/var/lib/apt/extended_states"
+#define APT_PREFERENCES_PATH "/etc/apt/preferences"   // 같은 이름 + ".d" 디렉터리도 읽음
+#define CACHE_DIR_NAME "package_manager"
+#define SNAPSHOT_FILE_NAME "packages.snap"
+#define FULLTEXT_FILE_NAME "fulltext.idx"
+#define PATH_BUFFER_SIZE 4096
+
+// 파서 관련 상수
+#define STANZA_MAX_FIELDS 64
+#define STANZA_STREAM_INITIAL_SIZE (256 * 1024)   // 압축 목록 파일의 스탠자 버퍼 (더 긴 스탠자가 있으면 늘어남)
+#define DECOMPRESS_CHUNK_SIZE (64 * 1024)         // 압축 파일에서 한 번에 읽는 크기
+#define LZ4_WINDOW_SIZE (64 * 1024)               // LZ4 일치 거리의 최댓값
+#define INITIAL_PACKAGE_CAPACITY 1024
+
+// 저장소 관련 상수
+#define ARENA_BLOCK_SIZE (64 * 1024)
+#define INTERN_INITIAL_CAPACITY 1024
+
+#define COLUMN_WIDTH_LIMIT 255
+
+// 트라이그램 키 공간 (문자당 6비트 × 3)
+#define TRIGRAM_KEYS (1u << 18)
+
+// apt 후보 버전 관련 상수 (apt_preferences(5)의 기본 우선순위)
+#define APT_PRIORITY_DEFAULT 500
+#define APT_PRIORITY_NOT_AUTOMATIC 1          // Release에 NotAutomatic: yes (experimental 등)
+#define APT_PRIORITY_BUT_AUTOMATIC 100        // NotAutomatic + ButAutomaticUpgrades (backports 등)
+#define APT_PRIORITY_INSTALLED 100            // 설치된 버전
+#define APT_PIN_FIELD_SIZE 128
+
+// 빌드한 기계의 dpkg 아키텍처 이름 (--arch로 바꿀 수 있음)
+#if defined(__x86_64__)
+#define NATIVE_ARCHITECTURE "amd64"
+#elif defined(__aarch64__)
+#define NATIVE_ARCHITECTURE "arm64"
+#elif defined(__i386__)
+#define NATIVE_ARCHITECTURE "i386"
+#elif defined(__arm__)
+#define NATIVE_ARCHITECTURE "armhf"
+#elif defined(__powerpc64__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+#define NATIVE_ARCHITECTURE "ppc64el"
+#elif defined(__s390x__)
+#define NATIVE_ARCHITECTURE "s390x"
+#elif defined(__riscv) && __riscv_xlen == 64
+#define NATIVE_ARCHITECTURE "riscv64"
+#else
+#define NATIVE_ARCHITECTURE NULL              // 알 수 없으면 아키텍처로 거르지 않음
+#endif
+
+// 전문 검색 (BM25) 관련 상수
+#define FULLTEXT_TERM_MIN 2                 // 한 글자 단어는 색인하지 않음
+#define FULLTEXT_TERM_MAX 32                // 더 긴 단어는 잘라서 색인
+#define FULLTEXT_QUERY_TERMS 16
+#define FULLTEXT_TOP_K 200                  // 순위를 매겨 보여 주는 검색 결과 수
+#define FULLTEXT_NAME_WEIGHT 4              // 이름에 나온 단어는 설명의 4배로 셈
+#define FULLTEXT_K1 1.2f
+#define FULLTEXT_B 0.75f
+#define DESCRIPTION_MD5_SIZE 32             // Description-md5 (16진수 32자)
 
 #endif // CONSTANTS_H
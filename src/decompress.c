@@ -0,0 +1,379 @@
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <zlib.h>
+#include <lzma.h>
+#include "decompress.h"
+#include "constants.h"
+
+#define LZ4_FRAME_MAGIC 0x184D2204u
+#define LZ4_SKIPPABLE_MAGIC 0x184D2A50u     // 0x184D2A50 ~ 0x184D2A5F
+#define LZ4_SKIPPABLE_MASK 0xFFFFFFF0u
+#define LZ4_MIN_MATCH 4
+
+static uint32_t readLE32(const unsigned char *p) {
+    return (uint32_t)p[0] | (uint32_t)p[1] << 8 | (uint32_t)p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+DecompressFormat detectFormat(const unsigned char *data, size_t length) {
+    if (length >= 2 && data[0] == 0x1f && data[1] == 0x8b) return FORMAT_GZIP;
+    if (length >= 6 && memcmp(data, "\xFD" "7zXZ\0", 6) == 0) return FORMAT_XZ;
+    if (length >= 4) {
+        uint32_t magic = readLE32(data);
+        if (magic == LZ4_FRAME_MAGIC || (magic & LZ4_SKIPPABLE_MASK) == LZ4_SKIPPABLE_MAGIC) return FORMAT_LZ4;
+    }
+    return FORMAT_PLAIN;
+}
+
+const char *formatName(DecompressFormat format) {
+    switch (format) {
+        case FORMAT_GZIP: return "gz";
+        case FORMAT_XZ: return "xz";
+        case FORMAT_LZ4: return "lz4";
+        default: return "plain";
+    }
+}
+
+// 입력 청크를 다시 채움. 파일 끝이거나 읽기에 실패하면 false
+static bool fillInput(DecompressStream *stream) {
+    ssize_t n;
+
+    if (stream->inputEnd) return false;
+    do {
+        n = read(stream->fd, stream->input, DECOMPRESS_CHUNK_SIZE);
+    } while (n < 0 && errno == EINTR);
+
+    stream->inputPos = 0;
+    if (n <= 0) {
+        stream->inputLen = 0;
+        stream->inputEnd = true;
+        return false;
+    }
+    stream->inputLen = (size_t)n;
+    stream->compressedBytes += (uint64_t)n;
+    return true;
+}
+
+// 입력에서 정확히 length 바이트를 꺼냄 (dst가 NULL이면 건너뜀). 꺼낸 바이트 수 반환
+static size_t takeInput(DecompressStream *stream, void *dst, size_t length) {
+    size_t taken = 0;
+
+    while (taken < length) {
+        if (stream->inputPos == stream->inputLen && !fillInput(stream)) break;
+        size_t n = stream->inputLen - stream->inputPos;
+        if (n > length - taken) n = length - taken;
+        if (dst) memcpy((unsigned char *)dst + taken, stream->input + stream->inputPos, n);
+        stream->inputPos += n;
+        taken += n;
+    }
+    return taken;
+}
+
+static ssize_t readPlain(DecompressStream *stream, unsigned char *out, size_t capacity) {
+    size_t n = takeInput(stream, out, capacity);
+    if (n < capacity) stream->finished = true;
+    return (ssize_t)n;
+}
+
+static ssize_t readGzip(DecompressStream *stream, unsigned char *out, size_t capacity) {
+    z_stream *z = (z_stream *)stream->codec;
+
+    z->next_out = out;
+    z->avail_out = (uInt)capacity;
+    while (z->avail_out > 0 && !stream->finished) {
+        // 스트림 끝 표시 전에 파일이 끝나면 잘린 파일
+        if (stream->inputPos == stream->inputLen && !fillInput(stream)) return -1;
+
+        z->next_in = stream->input + stream->inputPos;
+        z->avail_in = (uInt)(stream->inputLen - stream->inputPos);
+        int rc = inflate(z, Z_NO_FLUSH);
+        stream->inputPos = stream->inputLen - z->avail_in;
+
+        if (rc == Z_STREAM_END) {
+            // gzip 멤버가 여러 개 이어 붙어 있으면 다음 멤버를 계속 풂
+            if (stream->inputPos == stream->inputLen && !fillInput(stream)) stream->finished = true;
+            else if (inflateReset(z) != Z_OK) return -1;
+        } else if (rc != Z_OK) {
+            return -1;
+        }
+    }
+    return (ssize_t)(capacity - z->avail_out);
+}
+
+static ssize_t readXz(DecompressStream *stream, unsigned char *out, size_t capacity) {
+    lzma_stream *xz = (lzma_stream *)stream->codec;
+
+    xz->next_out = out;
+    xz->avail_out = capacity;
+    while (xz->avail_out > 0 && !stream->finished) {
+        if (stream->inputPos == stream->inputLen) fillInput(stream);
+
+        xz->next_in = stream->input + stream->inputPos;
+        xz->avail_in = stream->inputLen - stream->inputPos;
+        // 이어 붙은 .xz 스트림까지 읽으므로 입력이 끝났음을 알려야 끝남
+        lzma_ret rc = lzma_code(xz, stream->inputEnd ? LZMA_FINISH : LZMA_RUN);
+        stream->inputPos = stream->inputLen - xz->avail_in;
+
+        if (rc == LZMA_STREAM_END) stream->finished = true;
+        else if (rc != LZMA_OK) return -1;
+    }
+    return (ssize_t)(capacity - xz->avail_out);
+}
+
+// 8바이트씩 복사 (끝에서 최대 7바이트를 더 쓰므로 호출하는 쪽에서 여유를 확인)
+static inline void wildCopy(unsigned char *dst, const unsigned char *src, size_t length) {
+    unsigned char *end = dst + length;
+    do {
+        memcpy(dst, src, 8);
+        dst += 8;
+        src += 8;
+    } while (dst < end);
+}
+
+// LZ4 블록 하나를 window + start 위치에 풂. 일치는 window 앞쪽의 이전 출력을 참조할 수 있음
+// 모든 길이·거리를 확인하므로 손상된 입력에도 버퍼 밖을 읽거나 쓰지 않음. 푼 길이, 손상되면 -1
+static ssize_t lz4DecodeBlock(const unsigned char *src, size_t srcLen,
+                              unsigned char *window, size_t start, size_t capacity) {
+    const unsigned char *ip = src;
+    const unsigned char *ipEnd = src + srcLen;
+    unsigned char *op = window + start;
+    unsigned char *opEnd = op + capacity;
+
+    for (;;) {
+        if (ip >= ipEnd) return -1;
+        unsigned token = *ip++;
+
+        size_t length = token >> 4;
+        if (length == 15) {
+            unsigned extra;
+            do {
+                if (ip >= ipEnd) return -1;
+                extra = *ip++;
+                length += extra;
+            } while (extra == 255);
+        }
+        if (length > (size_t)(ipEnd - ip) || length > (size_t)(opEnd - op)) return -1;
+        // 대부분 짧은 리터럴이므로 양쪽에 여유가 있으면 memcpy 호출 대신 8바이트씩 복사
+        if (length + 8 <= (size_t)(ipEnd - ip) && length + 8 <= (size_t)(opEnd - op)) wildCopy(op, ip, length);
+        else memcpy(op, ip, length);
+        op += length;
+        ip += length;
+
+        // 마지막 시퀀스는 리터럴만 있음
+        if (ip == ipEnd) break;
+
+        if (ipEnd - ip < 2) return -1;
+        size_t offset = (size_t)ip[0] | (size_t)ip[1] << 8;
+        ip += 2;
+        if (offset == 0 || offset > (size_t)(op - window)) return -1;
+
+        length = (token & 15) + LZ4_MIN_MATCH;
+        if ((token & 15) == 15) {
+            unsigned extra;
+            do {
+                if (ip >= ipEnd) return -1;
+                extra = *ip++;
+                length += extra;
+            } while (extra == 255);
+        }
+        if (length > (size_t)(opEnd - op)) return -1;
+
+        const unsigned char *match = op - offset;
+        if (offset >= 8 && length + 8 <= (size_t)(opEnd - op)) {
+            wildCopy(op, match, length);
+        } else if (offset >= length) {
+            memcpy(op, match, length);
+        } else {
+            // 겹치는 복사는 반복 패턴을 만들므로 앞에서부터 한 바이트씩
+            for (size_t i = 0; i < length; i++) op[i] = match[i];
+        }
+        op += length;
+    }
+    return (ssize_t)(op - (window + start));
+}
+
+// 프레임 헤더 (매직 다음부터). 체크섬(xxHash32)은 검증하지 않고 건너뜀
+static bool lz4FrameHeader(DecompressStream *stream) {
+    Lz4Frame *frame = &stream->lz4;
+    unsigned char header[2];
+
+    if (takeInput(stream, header, sizeof(header)) < sizeof(header)) return false;
+    unsigned flags = header[0];
+    unsigned sizeCode = (header[1] >> 4) & 7;
+
+    // 버전 01만 있고, 외부 사전이 필요한 프레임은 풀 수 없음
+    if ((flags >> 6) != 1 || (flags & 0x01) || sizeCode < 4) return false;
+
+    size_t optional = (flags & 0x08 ? 8 : 0) + 1;   // 내용 크기, 헤더 체크섬
+    if (takeInput(stream, NULL, optional) < optional) return false;
+
+    // 블록 최대 크기: 4 = 64KiB, 5 = 256KiB, 6 = 1MiB, 7 = 4MiB
+    size_t blockMax = (size_t)1 << (8 + 2 * sizeCode);
+    if (blockMax > frame->blockMax) {
+        unsigned char *block = (unsigned char *)realloc(frame->block, blockMax);
+        if (!block) return false;
+        frame->block = block;
+        unsigned char *window = (unsigned char *)realloc(frame->window, LZ4_WINDOW_SIZE + blockMax);
+        if (!window) return false;
+        frame->window = window;
+        frame->blockMax = blockMax;
+    }
+
+    frame->linked = !(flags & 0x20);
+    frame->blockChecksum = flags & 0x10;
+    frame->contentChecksum = flags & 0x04;
+    frame->history = frame->outPos = frame->outEnd = 0;
+    frame->inFrame = true;
+    return true;
+}
+
+// 다음 데이터 블록을 풂. 1: 출력 있음, 0: 파일 끝, -1: 손상·잘림
+static int lz4NextBlock(DecompressStream *stream) {
+    Lz4Frame *frame = &stream->lz4;
+    unsigned char word[4];
+
+    for (;;) {
+        if (!frame->inFrame) {
+            size_t got = takeInput(stream, word, sizeof(word));
+            if (got == 0) return 0;
+            if (got < sizeof(word)) return -1;
+
+            uint32_t magic = readLE32(word);
+            if ((magic & LZ4_SKIPPABLE_MASK) == LZ4_SKIPPABLE_MAGIC) {
+                if (takeInput(stream, word, sizeof(word)) < sizeof(word)) return -1;
+                uint32_t size = readLE32(word);
+                if (takeInput(stream, NULL, size) < size) return -1;
+                continue;
+            }
+            if (magic != LZ4_FRAME_MAGIC || !lz4FrameHeader(stream)) return -1;
+        }
+
+        if (takeInput(stream, word, sizeof(word)) < sizeof(word)) return -1;
+        uint32_t size = readLE32(word);
+        if (size == 0) {
+            // 프레임 끝 표시 (뒤에 다른 프레임이 이어질 수 있음)
+            frame->inFrame = false;
+            if (frame->contentChecksum && takeInput(stream, NULL, 4) < 4) return -1;
+            continue;
+        }
+
+        bool stored = size & 0x80000000u;   // 압축하지 않고 그대로 둔 블록
+        size &= 0x7FFFFFFFu;
+        if (size > frame->blockMax) return -1;
+
+        // 이어진 블록이면 직전 출력의 마지막 64KiB를 창 앞으로 옮겨 일치 거리 안에 둠
+        size_t keep = 0;
+        if (frame->linked) {
+            keep = frame->outEnd < LZ4_WINDOW_SIZE ? frame->outEnd : LZ4_WINDOW_SIZE;
+            memmove(frame->window, frame->window + frame->outEnd - keep, keep);
+        }
+        frame->history = keep;
+
+        ssize_t produced;
+        if (stored) {
+            produced = takeInput(stream, frame->window + keep, size) == size ? (ssize_t)size : -1;
+        } else if (takeInput(stream, frame->block, size) == size) {
+            produced = lz4DecodeBlock(frame->block, size, frame->window, keep, frame->blockMax);
+        } else {
+            produced = -1;
+        }
+        if (produced < 0) return -1;
+        if (frame->blockChecksum && takeInput(stream, NULL, 4) < 4) return -1;
+
+        frame->outPos = keep;
+        frame->outEnd = keep + (size_t)produced;
+        if (produced > 0) return 1;
+    }
+}
+
+static ssize_t readLz4(DecompressStream *stream, unsigned char *out, size_t capacity) {
+    Lz4Frame *frame = &stream->lz4;
+    size_t produced = 0;
+
+    while (produced < capacity && !stream->finished) {
+        if (frame->outPos == frame->outEnd) {
+            int rc = lz4NextBlock(stream);
+            if (rc < 0) return -1;
+            if (rc == 0) {
+                stream->finished = true;
+                break;
+            }
+        }
+
+        size_t n = frame->outEnd - frame->outPos;
+        if (n > capacity - produced) n = capacity - produced;
+        memcpy(out + produced, frame->window + frame->outPos, n);
+        frame->outPos += n;
+        produced += n;
+    }
+    return (ssize_t)produced;
+}
+
+// 파일을 열고 첫 청크로 형식을 판별해 해제기를 준비
+bool decompressOpen(DecompressStream *stream, const char *path) {
+    memset(stream, 0, sizeof(*stream));
+    stream->fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (stream->fd < 0) return false;
+
+    stream->input = (unsigned char *)malloc(DECOMPRESS_CHUNK_SIZE);
+    if (!stream->input) {
+        decompressClose(stream);
+        return false;
+    }
+    fillInput(stream);
+    stream->format = detectFormat(stream->input, stream->inputLen);
+
+    if (stream->format == FORMAT_GZIP) {
+        z_stream *z = (z_stream *)calloc(1, sizeof(z_stream));
+        // 15 + 32: 최대 창 크기, gzip·zlib 헤더 자동 인식
+        if (!z || inflateInit2(z, 15 + 32) != Z_OK) {
+            free(z);
+            decompressClose(stream);
+            return false;
+        }
+        stream->codec = z;
+    } else if (stream->format == FORMAT_XZ) {
+        lzma_stream *xz = (lzma_stream *)malloc(sizeof(lzma_stream));
+        if (xz) *xz = (lzma_stream)LZMA_STREAM_INIT;
+        if (!xz || lzma_stream_decoder(xz, UINT64_MAX, LZMA_CONCATENATED) != LZMA_OK) {
+            free(xz);
+            decompressClose(stream);
+            return false;
+        }
+        stream->codec = xz;
+    }
+    return true;
+}
+
+// 풀린 내용을 buffer에 최대 capacity 바이트까지 채움. 끝이면 0, 손상되었거나 잘렸으면 -1
+ssize_t decompressRead(DecompressStream *stream, void *buffer, size_t capacity) {
+    ssize_t n;
+
+    if (stream->finished || capacity == 0) return 0;
+    switch (stream->format) {
+        case FORMAT_GZIP: n = readGzip(stream, (unsigned char *)buffer, capacity); break;
+        case FORMAT_XZ: n = readXz(stream, (unsigned char *)buffer, capacity); break;
+        case FORMAT_LZ4: n = readLz4(stream, (unsigned char *)buffer, capacity); break;
+        default: n = readPlain(stream, (unsigned char *)buffer, capacity); break;
+    }
+    if (n > 0) stream->outputBytes += (uint64_t)n;
+    return n;
+}
+
+void decompressClose(DecompressStream *stream) {
+    if (stream->codec) {
+        if (stream->format == FORMAT_GZIP) inflateEnd((z_stream *)stream->codec);
+        else if (stream->format == FORMAT_XZ) lzma_end((lzma_stream *)stream->codec);
+        free(stream->codec);
+        stream->codec = NULL;
+    }
+    free(stream->lz4.block);
+    free(stream->lz4.window);
+    free(stream->input);
+    memset(&stream->lz4, 0, sizeof(stream->lz4));
+    stream->input = NULL;
+    if (stream->fd >= 0) close(stream->fd);
+    stream->fd = -1;
+}
@@ -0,0 +1,52 @@
+#ifndef DECOMPRESS_H
+#define DECOMPRESS_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <sys/types.h>
+
+// 압축된 목록 파일을 고정 크기 청크로 읽으며 풀어 주는 스트림
+// 형식은 파일 앞부분의 매직 바이트로 판별 (확장자는 보지 않음)
+typedef enum DecompressFormat {
+    FORMAT_PLAIN,
+    FORMAT_GZIP,
+    FORMAT_XZ,
+    FORMAT_LZ4,
+} DecompressFormat;
+
+// LZ4 프레임 해제 상태. 블록 단위로 풀며, 블록이 서로 이어진 프레임은 직전 64KiB를 창으로 유지
+typedef struct Lz4Frame {
+    unsigned char *block;       // 압축된 블록 하나
+    unsigned char *window;      // [이전 출력 최대 64KiB][이번 블록 출력]
+    size_t blockMax;
+    size_t history;             // window 앞쪽의 이전 출력 길이
+    size_t outPos;              // 이번 블록 출력 중 아직 넘기지 않은 위치 (window 기준)
+    size_t outEnd;
+    bool inFrame;
+    bool linked;                // 블록이 이전 블록을 참조할 수 있음
+    bool blockChecksum;
+    bool contentChecksum;
+} Lz4Frame;
+
+typedef struct DecompressStream {
+    int fd;
+    DecompressFormat format;
+    unsigned char *input;       // 파일에서 읽은 압축 청크
+    size_t inputPos;
+    size_t inputLen;
+    bool inputEnd;
+    bool finished;
+    void *codec;                // z_stream / lzma_stream (형식별)
+    Lz4Frame lz4;
+    uint64_t compressedBytes;   // 파일에서 읽은 바이트
+    uint64_t outputBytes;       // 풀어서 넘긴 바이트
+} DecompressStream;
+
+DecompressFormat detectFormat(const unsigned char *data, size_t length);
+const char *formatName(DecompressFormat format);
+bool decompressOpen(DecompressStream *stream, const char *path);
+ssize_t decompressRead(DecompressStream *stream, void *buffer, size_t capacity);
+void decompressClose(DecompressStream *stream);
+
+#endif // DECOMPRESS_H
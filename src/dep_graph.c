@@ -0,0 +1,511 @@
+#include <stdlib.h>
+#include <string.h>
+#include "dep_graph.h"
+#include "stanza.h"
+#include "constants.h"
+#include "trace.h"
+
+// 구성 중에만 쓰는 늘어나는 번호 배열
+typedef struct IdList {
+    uint32_t *data;
+    size_t count;
+    size_t capacity;
+} IdList;
+
+static bool idPush(IdList *list, uint32_t id) {
+    if (list->count == list->capacity) {
+        size_t capacity = list->capacity ? list->capacity * 2 : DEP_INITIAL_CAPACITY;
+        uint32_t *data = (uint32_t *)realloc(list->data, capacity * sizeof(uint32_t));
+        if (!data) return false;
+        list->data = data;
+        list->capacity = capacity;
+    }
+    list->data[list->count++] = id;
+    return true;
+}
+
+static void idFree(IdList *list) {
+    free(list->data);
+    memset(list, 0, sizeof(*list));
+}
+
+#define RELATION_KINDS 3
+
+static const char *relationFields[RELATION_KINDS] = { "Depends", "Pre-Depends", "Recommends" };
+
+// 1차 순회에서 찾아 둔 스탠자의 관계 필드 (매핑된 파일을 가리킴). 2차에는 스탠자를 다시 파싱하지 않음
+typedef struct RelationRecord {
+    uint32_t node;
+    const char *values[RELATION_KINDS];     // DEP_DEPENDS 등의 순서
+    size_t lengths[RELATION_KINDS];
+    bool essential;
+} RelationRecord;
+
+typedef struct GraphBuilder {
+    DepGraph *graph;
+    PackageStore virtuals;      // Provides로만 존재하는 이름
+    uint32_t *providerOffsets;  // 가상 이름별 제공 노드 시작 위치
+    uint32_t *providers;
+    IdList groupOwners;         // 아래 셋은 그룹 순서 (노드별로 모으기 전)
+    IdList groupKinds;
+    IdList groupStarts;
+    IdList targets;
+    RelationRecord *records;
+    size_t recordCount;
+    size_t recordCapacity;
+    bool ok;
+} GraphBuilder;
+
+static RelationRecord *addRecord(GraphBuilder *builder) {
+    if (builder->recordCount == builder->recordCapacity) {
+        size_t capacity = builder->recordCapacity ? builder->recordCapacity * 2 : DEP_INITIAL_CAPACITY;
+        RelationRecord *records = (RelationRecord *)realloc(builder->records, capacity * sizeof(RelationRecord));
+        if (!records) return NULL;
+        builder->records = records;
+        builder->recordCapacity = capacity;
+    }
+    return &builder->records[builder->recordCount++];
+}
+
+// 의존 관계를 만족시킬 수 있는 상태인지 (삭제됐지만 설정 파일만 남은 항목 등은 제외)
+static bool isPresentStatus(const char *status, size_t length) {
+    static const char *absent[] = { "not-installed", "config-files" };
+
+    if (!status) return true;
+    while (length > 0 && (status[length - 1] == ' ' || status[length - 1] == '\r')) length--;
+    for (size_t i = 0; i < sizeof(absent) / sizeof(absent[0]); i++) {
+        size_t absentLen = strlen(absent[i]);
+        if (length >= absentLen && memcmp(status + length - absentLen, absent[i], absentLen) == 0) return false;
+    }
+    return true;
+}
+
+static const char *skipSpace(const char *p, const char *end) {
+    while (p < end && (*p == ' ' || *p == '\t' || *p == '\n' || *p == '\r')) p++;
+    return p;
+}
+
+// "이름:아키텍처 (>= 버전)" 에서 이름 부분의 길이
+static size_t relationNameLength(const char *p, const char *end) {
+    size_t length = 0;
+    while (p + length < end) {
+        char c = p[length];
+        if (c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '(' || c == ':' || c == '['
+            || c == '<' || c == ',' || c == '|') {
+            break;
+        }
+        length++;
+    }
+    return length;
+}
+
+// 이름 하나를 만족시키는 설치된 노드들 (같은 이름의 패키지 + 그 이름을 Provides 하는 패키지)
+static void resolveName(GraphBuilder *builder, const char *name, size_t length) {
+    int node = storeLookup(&builder->graph->nodes, name, length);
+    if (node >= 0) builder->ok &= idPush(&builder->targets, (uint32_t)node);
+
+    int virtualIndex = storeLookup(&builder->virtuals, name, length);
+    if (virtualIndex < 0) return;
+    for (uint32_t i = builder->providerOffsets[virtualIndex]; i < builder->providerOffsets[virtualIndex + 1]; i++) {
+        builder->ok &= idPush(&builder->targets, builder->providers[i]);
+    }
+}
+
+// 관계 필드 하나 ("a (>= 1) | b, c")를 그룹으로 나눠 추가. 설치된 대안이 하나도 없는 그룹은 버림
+static void addRelations(GraphBuilder *builder, uint32_t owner, int kind, const char *value, size_t length) {
+    const char *p = value;
+    const char *end = value + length;
+
+    while (p < end) {
+        size_t start = builder->targets.count;
+
+        for (;;) {
+            p = skipSpace(p, end);
+            size_t nameLen = relationNameLength(p, end);
+            if (nameLen > 0) resolveName(builder, p, nameLen);
+            p += nameLen;
+            while (p < end && *p != '|' && *p != ',') p++;
+            if (p < end && *p == '|') {
+                p++;
+                continue;
+            }
+            break;
+        }
+        if (p < end) p++;  // ','
+
+        if (builder->targets.count > start) {
+            builder->ok &= idPush(&builder->groupOwners, owner);
+            builder->ok &= idPush(&builder->groupKinds, (uint32_t)kind);
+            builder->ok &= idPush(&builder->groupStarts, (uint32_t)start);
+        }
+    }
+}
+
+// 1차 순회: 설치된 패키지를 노드로, Provides를 (가상 이름, 노드) 쌍으로 모으고 관계 필드 위치를 기록
+static void collectNodes(GraphBuilder *builder, const MappedFile *file, IdList *provided, IdList *providedBy) {
+    StanzaReader reader;
+    Stanza stanza;
+    PackageStore *nodes = &builder->graph->nodes;
+
+    stanzaReaderInit(&reader, file->data, file->size);
+    while (stanzaNext(&reader, &stanza)) {
+        size_t nameLen, versionLen, statusLen, providesLen;
+        const char *name = stanzaGet(&stanza, "Package", &nameLen);
+        const char *status = stanzaGet(&stanza, "Status", &statusLen);
+        if (!name || nameLen == 0 || !isPresentStatus(status, statusLen)) continue;
+
+        // 여러 아키텍처로 설치된 같은 이름은 노드 하나로 합침
+        int node = storeLookup(nodes, name, nameLen);
+        if (node < 0) {
+            const char *version = stanzaGet(&stanza, "Version", &versionLen);
+            if (!storeAdd(nodes, name, nameLen, version, version ? versionLen : 0, NULL, 0)) {
+                builder->ok = false;
+                return;
+            }
+            node = nodes->count - 1;
+        }
+
+        RelationRecord *record = addRecord(builder);
+        if (!record) {
+            builder->ok = false;
+            return;
+        }
+        record->node = (uint32_t)node;
+        for (int kind = 0; kind < RELATION_KINDS; kind++) {
+            record->values[kind] = stanzaGet(&stanza, relationFields[kind], &record->lengths[kind]);
+        }
+        size_t essentialLen;
+        const char *essential = stanzaGet(&stanza, "Essential", &essentialLen);
+        record->essential = essential && essentialLen == 3 && memcmp(essential, "yes", 3) == 0;
+
+        const char *provides = stanzaGet(&stanza, "Provides", &providesLen);
+        const char *end = provides ? provides + providesLen : NULL;
+        for (const char *p = provides; p && p < end; ) {
+            p = skipSpace(p, end);
+            size_t length = relationNameLength(p, end);
+            if (length > 0) {
+                int virtualIndex = storeLookup(&builder->virtuals, p, length);
+                if (virtualIndex < 0 && storeAdd(&builder->virtuals, p, length, NULL, 0, NULL, 0)) {
+                    virtualIndex = builder->virtuals.count - 1;
+                }
+                if (virtualIndex >= 0) {
+                    builder->ok &= idPush(provided, (uint32_t)virtualIndex);
+                    builder->ok &= idPush(providedBy, (uint32_t)node);
+                }
+            }
+            p += length;
+            while (p < end && *p != ',') p++;
+            if (p < end) p++;
+        }
+    }
+}
+
+// 키별 개수를 센 뒤 누적합 위치에 값을 채워 CSR 배열 구성 (offsets는 keyCount + 1개)
+static bool buildCsr(const IdList *keys, const IdList *values, uint32_t keyCount,
+                     uint32_t **offsets, uint32_t **data) {
+    *offsets = (uint32_t *)calloc((size_t)keyCount + 1, sizeof(uint32_t));
+    *data = (uint32_t *)malloc((values->count ? values->count : 1) * sizeof(uint32_t));
+    uint32_t *cursor = (uint32_t *)malloc(((size_t)keyCount + 1) * sizeof(uint32_t));
+    if (!*offsets || !*data || !cursor) {
+        free(cursor);
+        return false;
+    }
+
+    for (size_t i = 0; i < keys->count; i++) (*offsets)[keys->data[i] + 1]++;
+    for (uint32_t key = 0; key < keyCount; key++) (*offsets)[key + 1] += (*offsets)[key];
+    memcpy(cursor, *offsets, ((size_t)keyCount + 1) * sizeof(uint32_t));
+    for (size_t i = 0; i < keys->count; i++) (*data)[cursor[keys->data[i]]++] = values->data[i];
+
+    free(cursor);
+    return true;
+}
+
+// 2차: 모든 이름을 안 뒤 기록해 둔 관계 필드를 노드 번호로 풂 (Pre-Depends, Depends, Recommends 순)
+static void collectGroups(GraphBuilder *builder) {
+    static const int order[RELATION_KINDS] = { DEP_PRE_DEPENDS, DEP_DEPENDS, DEP_RECOMMENDS };
+    DepGraph *graph = builder->graph;
+
+    for (size_t i = 0; builder->ok && i < builder->recordCount; i++) {
+        const RelationRecord *record = &builder->records[i];
+
+        if (record->essential) graph->nodeFlags[record->node] |= DEP_NODE_ESSENTIAL;
+        for (int k = 0; k < RELATION_KINDS; k++) {
+            int kind = order[k];
+            if (record->values[kind]) {
+                addRelations(builder, record->node, kind, record->values[kind], record->lengths[kind]);
+            }
+        }
+    }
+}
+
+// 그룹을 노드별로 모으고 (정방향) 대안 노드마다 그 그룹을 등록 (역방향)
+static bool finishGroups(GraphBuilder *builder) {
+    DepGraph *graph = builder->graph;
+    uint32_t nodeCount = (uint32_t)graph->nodes.count;
+    uint32_t groupCount = (uint32_t)builder->groupOwners.count;
+    IdList order = { 0 };
+    bool ok = true;
+
+    graph->groupCount = groupCount;
+    graph->targetCount = (uint32_t)builder->targets.count;
+
+    // 그룹 번호 자체를 값으로 넣어 소유 노드 순으로 정렬된 순서를 얻음
+    for (uint32_t g = 0; g < groupCount && ok; g++) ok = idPush(&order, g);
+    uint32_t *sorted = NULL;
+    ok = ok && buildCsr(&builder->groupOwners, &order, nodeCount, &graph->groupOffsets, &sorted);
+
+    graph->groupKinds = (uint8_t *)malloc(groupCount ? groupCount : 1);
+    graph->groupOwners = (uint32_t *)malloc((groupCount ? groupCount : 1) * sizeof(uint32_t));
+    graph->targetOffsets = (uint32_t *)malloc(((size_t)groupCount + 1) * sizeof(uint32_t));
+    graph->targets = (uint32_t *)malloc((graph->targetCount ? graph->targetCount : 1) * sizeof(uint32_t));
+    ok = ok && graph->groupKinds && graph->groupOwners && graph->targetOffsets && graph->targets;
+
+    IdList reverseKeys = { 0 }, reverseValues = { 0 };
+    uint32_t position = 0;
+    for (uint32_t slot = 0; ok && slot < groupCount; slot++) {
+        uint32_t g = sorted[slot];
+        uint32_t start = builder->groupStarts.data[g];
+        uint32_t end = g + 1 < groupCount ? builder->groupStarts.data[g + 1] : graph->targetCount;
+
+        graph->groupKinds[slot] = (uint8_t)builder->groupKinds.data[g];
+        graph->groupOwners[slot] = builder->groupOwners.data[g];
+        graph->targetOffsets[slot] = position;
+        for (uint32_t t = start; t < end && ok; t++) {
+            graph->targets[position++] = builder->targets.data[t];
+            ok = idPush(&reverseKeys, builder->targets.data[t]) && idPush(&reverseValues, slot);
+        }
+    }
+    if (ok) graph->targetOffsets[groupCount] = position;
+
+    ok = ok && buildCsr(&reverseKeys, &reverseValues, nodeCount, &graph->reverseOffsets, &graph->reverseGroups);
+
+    free(sorted);
+    idFree(&order);
+    idFree(&reverseKeys);
+    idFree(&reverseValues);
+    return ok;
+}
+
+// apt가 자동으로 설치한 패키지 표시 ("Auto-Installed: 1"). 파일이 없으면 모르는 것으로 둠
+static void loadExtendedStates(DepGraph *graph, const char *path) {
+    MappedFile file;
+    StanzaReader reader;
+    Stanza stanza;
+
+    if (!path || !mapFile(path, &file)) return;
+
+    stanzaReaderInit(&reader, file.data, file.size);
+    while (stanzaNext(&reader, &stanza)) {
+        size_t nameLen, autoLen;
+        const char *name = stanzaGet(&stanza, "Package", &nameLen);
+        const char *autoInstalled = stanzaGet(&stanza, "Auto-Installed", &autoLen);
+        if (!name || !autoInstalled || autoLen != 1 || autoInstalled[0] != '1') continue;
+
+        int node = storeLookup(&graph->nodes, name, nameLen);
+        if (node >= 0) graph->nodeFlags[node] |= DEP_NODE_AUTO;
+    }
+    unmapFile(&file);
+    graph->autoKnown = true;
+}
+
+// status 파일을 한 번 파싱해 그래프 구성: 관계는 이름을 모두 안 뒤에 노드 번호로 풀 수 있으므로 위치만 기록해 둠
+bool depGraphBuild(DepGraph *graph, const char *statusPath, const char *extendedStatesPath) {
+    MappedFile file;
+    GraphBuilder builder = { .graph = graph, .ok = true };
+    IdList provided = { 0 }, providedBy = { 0 };
+
+    uint64_t start = traceNowUs();
+    memset(graph, 0, sizeof(*graph));
+    storeInit(&graph->nodes);
+    storeBuildIndex(&graph->nodes);
+    if (!mapFile(statusPath, &file)) return false;
+
+    storeInit(&builder.virtuals);
+    storeBuildIndex(&builder.virtuals);
+    collectNodes(&builder, &file, &provided, &providedBy);
+
+    builder.ok = builder.ok
+        && buildCsr(&provided, &providedBy, (uint32_t)builder.virtuals.count,
+                    &builder.providerOffsets, &builder.providers)
+        && (graph->nodeFlags = (uint8_t *)calloc(graph->nodes.count ? graph->nodes.count : 1, 1)) != NULL;
+    if (builder.ok) collectGroups(&builder);
+    if (builder.ok) builder.ok = finishGroups(&builder);
+    unmapFile(&file);
+
+    idFree(&provided);
+    idFree(&providedBy);
+    idFree(&builder.groupOwners);
+    idFree(&builder.groupKinds);
+    idFree(&builder.groupStarts);
+    idFree(&builder.targets);
+    free(builder.records);
+    free(builder.providerOffsets);
+    free(builder.providers);
+    storeFree(&builder.virtuals);
+
+    if (!builder.ok) {
+        depGraphFree(graph);
+        return false;
+    }
+    loadExtendedStates(graph, extendedStatesPath);
+    graph->buildMs = (traceNowUs() - start) / 1e3;
+    return true;
+}
+
+void depGraphFree(DepGraph *graph) {
+    storeFree(&graph->nodes);
+    free(graph->nodeFlags);
+    free(graph->groupOffsets);
+    free(graph->groupKinds);
+    free(graph->groupOwners);
+    free(graph->targetOffsets);
+    free(graph->targets);
+    free(graph->reverseOffsets);
+    free(graph->reverseGroups);
+    memset(graph, 0, sizeof(*graph));
+}
+
+int depGraphFind(const DepGraph *graph, const char *name) {
+    return storeLookup(&graph->nodes, name, strlen(name));
+}
+
+// 요청한 노드를 지우면 함께 지워지는 노드 (apt-get remove와 같은 규칙: Depends/Pre-Depends만 따짐)
+// 그룹마다 남은 대안 수를 세어 두고, 지워지는 노드를 대안으로 가진 그룹만 줄여 나감 (너비 우선)
+bool depGraphRemovalImpact(const DepGraph *graph, const int *nodes, int count, DepImpact *impact) {
+    int nodeCount = graph->nodes.count;
+
+    uint64_t start = traceNowUs();
+    memset(impact, 0, sizeof(*impact));
+    uint32_t *remaining = (uint32_t *)malloc((graph->groupCount ? graph->groupCount : 1) * sizeof(uint32_t));
+    uint8_t *gone = (uint8_t *)calloc(nodeCount ? nodeCount : 1, 1);
+    impact->removed = (int *)malloc((nodeCount ? nodeCount : 1) * sizeof(int));
+    impact->causes = (int *)malloc((nodeCount ? nodeCount : 1) * sizeof(int));
+    if (!remaining || !gone || !impact->removed || !impact->causes) {
+        free(remaining);
+        free(gone);
+        depImpactFree(impact);
+        return false;
+    }
+
+    for (uint32_t g = 0; g < graph->groupCount; g++) {
+        remaining[g] = graph->targetOffsets[g + 1] - graph->targetOffsets[g];
+    }
+    for (int i = 0; i < count; i++) {
+        if (nodes[i] < 0 || nodes[i] >= nodeCount || gone[nodes[i]]) continue;
+        gone[nodes[i]] = 1;
+        impact->removed[impact->count] = nodes[i];
+        impact->causes[impact->count++] = -1;
+    }
+    impact->requested = impact->count;
+
+    for (int head = 0; head < impact->count; head++) {
+        int node = impact->removed[head];
+        for (uint32_t r = graph->reverseOffsets[node]; r < graph->reverseOffsets[node + 1]; r++) {
+            uint32_t group = graph->reverseGroups[r];
+            if (graph->groupKinds[group] == DEP_RECOMMENDS || --remaining[group] > 0) continue;
+
+            uint32_t owner = graph->groupOwners[group];
+            if (gone[owner]) continue;
+            gone[owner] = 1;
+            impact->removed[impact->count] = (int)owner;
+            impact->causes[impact->count++] = node;
+        }
+    }
+
+    free(remaining);
+    free(gone);
+    impact->elapsedUs = (double)(traceNowUs() - start);
+    return true;
+}
+
+void depImpactFree(DepImpact *impact) {
+    free(impact->removed);
+    free(impact->causes);
+    memset(impact, 0, sizeof(*impact));
+}
+
+// 설치 이유의 시작점: 직접 설치한 패키지 (자동 설치 정보가 없으면 자신 말고는 아무도 필요로 하지 않는 패키지)
+static bool isRootNode(const DepGraph *graph, int node) {
+    if (graph->autoKnown) return !(graph->nodeFlags[node] & DEP_NODE_AUTO);
+
+    for (uint32_t r = graph->reverseOffsets[node]; r < graph->reverseOffsets[node + 1]; r++) {
+        if (graph->groupOwners[graph->reverseGroups[r]] != (uint32_t)node) return false;
+    }
+    return true;
+}
+
+// node가 설치되어 있는 이유: 시작점에서 node까지 가장 짧은 의존 경로를 path에 기록 (시작점이 먼저)
+// 경로의 노드 수, 시작점에 닿지 않으면 0 (자동 설치됐지만 더는 필요 없는 패키지), 실패하면 -1
+int depGraphWhy(const DepGraph *graph, int node, int *path, int capacity) {
+    int nodeCount = graph->nodes.count;
+    if (node < 0 || node >= nodeCount || capacity <= 0) return -1;
+
+    int *next = (int *)malloc(nodeCount * sizeof(int));     // node 쪽으로 한 걸음 가까운 노드
+    int *queue = (int *)malloc(nodeCount * sizeof(int));
+    if (!next || !queue) {
+        free(next);
+        free(queue);
+        return -1;
+    }
+    for (int i = 0; i < nodeCount; i++) next[i] = -2;
+
+    int found = -1, tail = 0;
+    next[node] = -1;
+    queue[tail++] = node;
+    for (int head = 0; head < tail && found < 0; head++) {
+        int current = queue[head];
+        if (isRootNode(graph, current)) {
+            found = current;
+            break;
+        }
+        for (uint32_t r = graph->reverseOffsets[current]; r < graph->reverseOffsets[current + 1]; r++) {
+            int owner = (int)graph->groupOwners[graph->reverseGroups[r]];
+            if (next[owner] != -2) continue;
+            next[owner] = current;
+            queue[tail++] = owner;
+        }
+    }
+
+    int length = 0;
+    for (int current = found; current >= 0 && length < capacity; current = next[current]) {
+        path[length++] = current;
+    }
+    free(next);
+    free(queue);
+    return length;
+}
+
+// from이 to를 필요로 하는 가장 강한 관계 (Pre-Depends > Depends > Recommends), 없으면 -1
+int depGraphEdgeKind(const DepGraph *graph, int from, int to) {
+    int best = -1;
+
+    for (uint32_t g = graph->groupOffsets[from]; g < graph->groupOffsets[from + 1]; g++) {
+        for (uint32_t t = graph->targetOffsets[g]; t < graph->targetOffsets[g + 1]; t++) {
+            if (graph->targets[t] != (uint32_t)to) continue;
+            int kind = graph->groupKinds[g];
+            if (best < 0 || kind == DEP_PRE_DEPENDS || (kind == DEP_DEPENDS && best == DEP_RECOMMENDS)) {
+                best = kind;
+            }
+        }
+    }
+    return best;
+}
+
+const char *depKindName(int kind) {
+    switch (kind) {
+        case DEP_DEPENDS: return "Depends";
+        case DEP_PRE_DEPENDS: return "Pre-Depends";
+        case DEP_RECOMMENDS: return "Recommends";
+        default: return "?";
+    }
+}
+
+size_t depGraphBytes(const DepGraph *graph) {
+    size_t nodeCount = (size_t)graph->nodes.count;
+    return storeBytesUsed(&graph->nodes)
+         + nodeCount
+         + (nodeCount + 1) * sizeof(uint32_t) * 2
+         + graph->groupCount * (1 + sizeof(uint32_t) * 2)
+         + sizeof(uint32_t)
+         + graph->targetCount * sizeof(uint32_t) * 2;
+}
@@ -0,0 +1,56 @@
+#ifndef DEP_GRAPH_H
+#define DEP_GRAPH_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "package_store.h"
+
+// 설치된 패키지 사이의 의존 관계 (dpkg status의 Depends/Pre-Depends/Recommends/Provides)
+//
+// 노드는 설치된 패키지, 의존 그룹은 "a | b" 처럼 하나만 있으면 되는 대안 묶음 하나.
+// 가상 패키지는 그것을 Provides 하는 설치된 패키지들로 풀어서 대안에 넣음 (버전 조건은 무시:
+// 설치된 상태는 dpkg가 이미 만족시킨 것이므로 누가 누구를 만족시키는지만 필요)
+// 정방향·역방향 모두 CSR 배열이라 질의 중에는 메모리 할당 외에 포인터를 따라가지 않음
+#define DEP_DEPENDS 0
+#define DEP_PRE_DEPENDS 1
+#define DEP_RECOMMENDS 2
+
+#define DEP_NODE_AUTO 0x01        // apt가 의존성 때문에 자동으로 설치 (extended_states)
+#define DEP_NODE_ESSENTIAL 0x02   // Essential: yes
+
+typedef struct DepGraph {
+    PackageStore nodes;         // 노드 번호 = 저장소 번호 (이름 색인으로 조회)
+    uint8_t *nodeFlags;
+    uint32_t *groupOffsets;     // 노드별 의존 그룹 시작 위치 (노드 수 + 1개)
+    uint8_t *groupKinds;        // DEP_DEPENDS 등
+    uint32_t *groupOwners;      // 그룹을 가진 노드
+    uint32_t *targetOffsets;    // 그룹별 대안 노드 시작 위치 (그룹 수 + 1개)
+    uint32_t *targets;
+    uint32_t *reverseOffsets;   // 노드별 그 노드를 대안으로 가진 그룹 시작 위치 (노드 수 + 1개)
+    uint32_t *reverseGroups;
+    uint32_t groupCount;
+    uint32_t targetCount;
+    bool autoKnown;             // extended_states를 읽었는지 (아니면 자동 설치 여부를 모름)
+    double buildMs;
+} DepGraph;
+
+// 삭제 영향: 요청한 노드와, 그 때문에 Depends/Pre-Depends를 만족할 수 없게 되어 함께 삭제되는 노드
+typedef struct DepImpact {
+    int *removed;       // 요청한 노드가 먼저, 이후 깨지는 순서
+    int *causes;        // removed[i]를 깨뜨린 노드 (요청한 노드는 -1)
+    int count;
+    int requested;
+    double elapsedUs;
+} DepImpact;
+
+bool depGraphBuild(DepGraph *graph, const char *statusPath, const char *extendedStatesPath);
+void depGraphFree(DepGraph *graph);
+int depGraphFind(const DepGraph *graph, const char *name);
+bool depGraphRemovalImpact(const DepGraph *graph, const int *nodes, int count, DepImpact *impact);
+void depImpactFree(DepImpact *impact);
+int depGraphWhy(const DepGraph *graph, int node, int *path, int capacity);
+int depGraphEdgeKind(const DepGraph *graph, int from, int to);
+const char *depKindName(int kind);
+size_t depGraphBytes(const DepGraph *graph);
+
+#endif // DEP_GRAPH_H
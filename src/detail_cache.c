@@ -0,0 +1,188 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include "detail_cache.h"
+#include "package_store.h"
+#include "constants.h"
+
+// 해시는 이름만으로 계산해 같은 패키지의 모든 버전이 한 버킷에 모이게 함 (이름 단위 무효화)
+typedef struct DetailEntry {
+    struct DetailEntry *hashNext;
+    struct DetailEntry *prev;      // LRU 목록: head가 가장 최근에 쓴 항목
+    struct DetailEntry *next;
+    uint32_t hash;
+    size_t cost;
+    TextBuffer text;
+    const char *version;           // key 안의 버전 위치
+    char key[];                    // "이름\0버전\0"
+} DetailEntry;
+
+static struct {
+    DetailEntry **buckets;
+    size_t bucketCount;
+    DetailEntry *head;
+    DetailEntry *tail;
+    DetailCacheStats stats;
+} cache;
+
+void detailCacheInit(size_t capacity) {
+    detailCacheFree();
+    cache.stats.capacity = capacity;
+}
+
+static DetailEntry **bucketFor(uint32_t hash) {
+    return &cache.buckets[hash & (cache.bucketCount - 1)];
+}
+
+static void lruUnlink(DetailEntry *entry) {
+    if (entry->prev) entry->prev->next = entry->next;
+    else cache.head = entry->next;
+    if (entry->next) entry->next->prev = entry->prev;
+    else cache.tail = entry->prev;
+    entry->prev = entry->next = NULL;
+}
+
+static void lruPushFront(DetailEntry *entry) {
+    entry->next = cache.head;
+    if (cache.head) cache.head->prev = entry;
+    cache.head = entry;
+    if (!cache.tail) cache.tail = entry;
+}
+
+static void removeEntry(DetailEntry *entry) {
+    DetailEntry **link = bucketFor(entry->hash);
+    while (*link != entry) link = &(*link)->hashNext;
+    *link = entry->hashNext;
+
+    lruUnlink(entry);
+    cache.stats.bytes -= entry->cost;
+    cache.stats.entries--;
+    textFree(&entry->text);
+    free(entry);
+}
+
+// 항목 수가 버킷 수를 넘으면 버킷을 두 배로 늘려 다시 분배
+static bool growBuckets(void) {
+    size_t count = cache.bucketCount ? cache.bucketCount * 2 : DETAIL_CACHE_INITIAL_BUCKETS;
+    DetailEntry **buckets = (DetailEntry **)calloc(count, sizeof(DetailEntry *));
+    if (!buckets) return false;
+
+    for (size_t i = 0; i < cache.bucketCount; i++) {
+        DetailEntry *entry = cache.buckets[i];
+        while (entry) {
+            DetailEntry *next = entry->hashNext;
+            DetailEntry **bucket = &buckets[entry->hash & (count - 1)];
+            entry->hashNext = *bucket;
+            *bucket = entry;
+            entry = next;
+        }
+    }
+    free(cache.buckets);
+    cache.buckets = buckets;
+    cache.bucketCount = count;
+    return true;
+}
+
+static DetailEntry *findEntry(const char *name, const char *version, uint32_t hash) {
+    if (!cache.buckets) return NULL;
+
+    for (DetailEntry *entry = *bucketFor(hash); entry; entry = entry->hashNext) {
+        if (entry->hash == hash && strcmp(entry->key, name) == 0 && strcmp(entry->version, version) == 0) {
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// 찾으면 가장 최근 항목으로 옮김. 반환한 버퍼는 다음 Put/무효화 전까지 유효
+const TextBuffer *detailCacheGet(const char *name, const char *version) {
+    if (!version) version = "";
+
+    DetailEntry *entry = findEntry(name, version, hashString(name, strlen(name)));
+    if (!entry) {
+        cache.stats.misses++;
+        return NULL;
+    }
+
+    cache.stats.hits++;
+    lruUnlink(entry);
+    lruPushFront(entry);
+    return &entry->text;
+}
+
+// 통계와 LRU 순서를 건드리지 않고 있는지만 확인 (미리 가져오기 예약용)
+bool detailCacheContains(const char *name, const char *version) {
+    if (!version) version = "";
+    return findEntry(name, version, hashString(name, strlen(name))) != NULL;
+}
+
+// 성공하면 text의 소유권을 가져가고 text는 빈 버퍼가 됨. 캐시가 꺼져 있거나 상한보다 크면 NULL
+const TextBuffer *detailCachePut(const char *name, const char *version, TextBuffer *text) {
+    if (!version) version = "";
+
+    size_t nameLen = strlen(name);
+    size_t versionLen = strlen(version);
+    size_t cost = sizeof(DetailEntry) + nameLen + versionLen + 2 + textBytesUsed(text);
+    if (cost > cache.stats.capacity) return NULL;
+
+    uint32_t hash = hashString(name, nameLen);
+    DetailEntry *old = findEntry(name, version, hash);
+    if (old) removeEntry(old);
+
+    if ((size_t)cache.stats.entries >= cache.bucketCount && !growBuckets()) return NULL;
+
+    DetailEntry *entry = (DetailEntry *)calloc(1, sizeof(DetailEntry) + nameLen + versionLen + 2);
+    if (!entry) return NULL;
+
+    memcpy(entry->key, name, nameLen + 1);
+    memcpy(entry->key + nameLen + 1, version, versionLen + 1);
+    entry->version = entry->key + nameLen + 1;
+    entry->hash = hash;
+    entry->cost = cost;
+    entry->text = *text;
+    textInit(text);
+
+    // 상한을 넘지 않을 때까지 가장 오래 쓰지 않은 항목부터 버림
+    while (cache.tail && cache.stats.bytes + cost > cache.stats.capacity) {
+        removeEntry(cache.tail);
+        cache.stats.evictions++;
+    }
+
+    DetailEntry **bucket = bucketFor(hash);
+    entry->hashNext = *bucket;
+    *bucket = entry;
+    lruPushFront(entry);
+    cache.stats.bytes += cost;
+    cache.stats.entries++;
+    return &entry->text;
+}
+
+// 설치 버전이 바뀐 패키지의 모든 버전 항목을 버림
+void detailCacheInvalidate(const char *name) {
+    if (!cache.buckets) return;
+
+    uint32_t hash = hashString(name, strlen(name));
+    DetailEntry *entry = *bucketFor(hash);
+    while (entry) {
+        DetailEntry *next = entry->hashNext;
+        if (entry->hash == hash && strcmp(entry->key, name) == 0) removeEntry(entry);
+        entry = next;
+    }
+}
+
+void detailCacheClear(void) {
+    while (cache.head) removeEntry(cache.head);
+}
+
+void detailCacheStats(DetailCacheStats *stats) {
+    *stats = cache.stats;
+}
+
+void detailCacheFree(void) {
+    size_t capacity = cache.stats.capacity;
+
+    detailCacheClear();
+    free(cache.buckets);
+    memset(&cache, 0, sizeof(cache));
+    cache.stats.capacity = capacity;
+}
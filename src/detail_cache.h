@@ -0,0 +1,27 @@
+#ifndef DETAIL_CACHE_H
+#define DETAIL_CACHE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "pager.h"
+
+// 패키지 상세 정보(apt-cache show 출력) LRU 캐시. 키는 이름 + 버전, 메모리 상한을 넘으면 오래된 것부터 버림
+typedef struct {
+    unsigned long hits;
+    unsigned long misses;
+    unsigned long evictions;
+    int entries;
+    size_t bytes;
+    size_t capacity;
+} DetailCacheStats;
+
+void detailCacheInit(size_t capacity);
+const TextBuffer *detailCacheGet(const char *name, const char *version);
+bool detailCacheContains(const char *name, const char *version);
+const TextBuffer *detailCachePut(const char *name, const char *version, TextBuffer *text);
+void detailCacheInvalidate(const char *name);
+void detailCacheClear(void);
+void detailCacheStats(DetailCacheStats *stats);
+void detailCacheFree(void);
+
+#endif // DETAIL_CACHE_H
@@ -0,0 +1,181 @@
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "detail_pool.h"
+#include "package_manager.h"
+#include "constants.h"
+
+static struct {
+    pthread_t threads[SEARCH_JOBS_MAX];
+    HelperConnection connections[SEARCH_JOBS_MAX];  // 작업 스레드마다 하나
+    int workerCount;
+    pthread_mutex_t lock;
+    bool running;
+    bool stopping;
+    DetailRequest *requests;
+    TextBuffer *texts;           // texts[i]는 requests[i]를 가져간 작업 스레드만 씀
+    int *ready;                  // 가져온 순서대로 쌓이는 번호
+    int readyCount;
+    int applied;                 // 메인 스레드가 넘겨받은 개수
+    unsigned char *claimed;      // SEARCH_JOB_CHUNK개 묶음마다 작업 스레드가 가져갔는지
+    int chunkCount;
+    int claimedCount;
+    int focus;                   // 다음에 가져갈 묶음을 찾기 시작할 위치 (화면에 보이는 결과)
+    int total;
+    PoolApply apply;
+    void *context;
+    int pipe[2];                 // 결과가 생기면 한 바이트 써서 메인 루프의 poll을 깨움
+} pool = { .lock = PTHREAD_MUTEX_INITIALIZER, .pipe = { -1, -1 } };
+
+// focus부터 (끝에 닿으면 처음부터) 아직 가져가지 않은 묶음을 찾음. 잠근 상태에서 호출
+static int claimChunk(void) {
+    for (int i = 0; i < pool.chunkCount; i++) {
+        int chunk = (pool.focus + i) % pool.chunkCount;
+        if (!pool.claimed[chunk]) {
+            pool.claimed[chunk] = 1;
+            pool.claimedCount++;
+            pool.focus = chunk + 1 < pool.chunkCount ? chunk + 1 : 0;
+            return chunk;
+        }
+    }
+    return -1;
+}
+
+static void *poolWorker(void *arg) {
+    HelperConnection *conn = (HelperConnection *)arg;
+
+    pthread_mutex_lock(&pool.lock);
+    while (!pool.stopping && pool.claimedCount < pool.chunkCount) {
+        // 화면에 보이는 결과부터 조금씩 나눠 가져가므로 보이는 줄이 먼저 채워짐
+        int start = claimChunk() * SEARCH_JOB_CHUNK;
+        int count = pool.total - start < SEARCH_JOB_CHUNK ? pool.total - start : SEARCH_JOB_CHUNK;
+        pthread_mutex_unlock(&pool.lock);
+
+        fetchPackageTexts(conn, pool.requests + start, count, pool.texts + start);
+
+        pthread_mutex_lock(&pool.lock);
+        for (int i = 0; i < count; i++) pool.ready[pool.readyCount++] = start + i;
+        if (write(pool.pipe[1], "", 1) < 0) {
+            // 파이프가 가득 차 있으면 이미 깨울 바이트가 남아 있음
+        }
+    }
+    pthread_mutex_unlock(&pool.lock);
+
+    helperStop(conn);
+    return NULL;
+}
+
+static void poolRelease(void) {
+    for (int i = 0; pool.texts && i < pool.total; i++) textFree(&pool.texts[i]);
+    free(pool.requests);
+    free(pool.texts);
+    free(pool.ready);
+    free(pool.claimed);
+    pool.requests = NULL;
+    pool.texts = NULL;
+    pool.ready = NULL;
+    pool.claimed = NULL;
+    pool.total = pool.readyCount = pool.applied = 0;
+    pool.chunkCount = pool.claimedCount = pool.focus = 0;
+
+    if (pool.pipe[0] >= 0) close(pool.pipe[0]);
+    if (pool.pipe[1] >= 0) close(pool.pipe[1]);
+    pool.pipe[0] = pool.pipe[1] = -1;
+}
+
+// 이전 작업이 남아 있으면 먼저 멈춤. 작업 스레드 수는 항목 묶음 수를 넘지 않음
+bool poolStart(const DetailRequest *requests, int count, int workers, PoolApply apply, void *context) {
+    poolStop();
+    if (count <= 0 || workers <= 0) return false;
+    int chunks = (count + SEARCH_JOB_CHUNK - 1) / SEARCH_JOB_CHUNK;
+    if (workers > SEARCH_JOBS_MAX) workers = SEARCH_JOBS_MAX;
+    if (workers > chunks) workers = chunks;
+
+    pool.requests = (DetailRequest *)malloc(count * sizeof(DetailRequest));
+    pool.texts = (TextBuffer *)calloc(count, sizeof(TextBuffer));
+    pool.ready = (int *)malloc(count * sizeof(int));
+    pool.claimed = (unsigned char *)calloc(chunks, 1);
+    if (!pool.requests || !pool.texts || !pool.ready || !pool.claimed
+        || pipe2(pool.pipe, O_NONBLOCK | O_CLOEXEC) < 0) {
+        poolRelease();
+        return false;
+    }
+    memcpy(pool.requests, requests, count * sizeof(DetailRequest));
+    pool.total = count;
+    pool.chunkCount = chunks;
+    pool.apply = apply;
+    pool.context = context;
+    pool.stopping = false;
+
+    for (int i = 0; i < workers; i++) {
+        helperInit(&pool.connections[i]);
+        if (pthread_create(&pool.threads[i], NULL, poolWorker, &pool.connections[i]) != 0) break;
+        pool.workerCount++;
+    }
+    if (pool.workerCount == 0) {
+        poolRelease();
+        return false;
+    }
+    pool.running = true;
+    return true;
+}
+
+int poolFd(void) {
+    return pool.pipe[0];
+}
+
+// 도착한 결과를 apply로 넘김. 넘긴 것이 있으면 true
+bool poolCollect(void) {
+    if (!pool.running) return false;
+
+    char drain[64];
+    while (read(pool.pipe[0], drain, sizeof(drain)) > 0) {}
+
+    pthread_mutex_lock(&pool.lock);
+    int from = pool.applied;
+    int to = pool.readyCount;
+    pthread_mutex_unlock(&pool.lock);
+
+    // ready[from..to)는 작업 스레드가 더 이상 건드리지 않음
+    for (int i = from; i < to; i++) {
+        int index = pool.ready[i];
+        pool.apply(pool.context, index, &pool.texts[index]);
+        textFree(&pool.texts[index]);
+    }
+    pool.applied = to;
+    return to > from;
+}
+
+// 화면이 request번 요청 근처로 옮겨 가면 그 묶음부터 가져감
+void poolFocus(int request) {
+    if (!pool.running || request < 0 || request >= pool.total) return;
+
+    pthread_mutex_lock(&pool.lock);
+    pool.focus = request / SEARCH_JOB_CHUNK;
+    pthread_mutex_unlock(&pool.lock);
+}
+
+bool poolActive(void) {
+    return pool.running && pool.applied < pool.total;
+}
+
+void poolProgress(int *done, int *total) {
+    *done = pool.applied;
+    *total = pool.total;
+}
+
+// 남은 요청은 버리고 진행 중인 묶음이 끝나면 작업 스레드를 정리
+void poolStop(void) {
+    if (!pool.running) return;
+
+    pthread_mutex_lock(&pool.lock);
+    pool.stopping = true;
+    pthread_mutex_unlock(&pool.lock);
+
+    for (int i = 0; i < pool.workerCount; i++) pthread_join(pool.threads[i], NULL);
+    pool.workerCount = 0;
+    pool.running = false;
+    poolRelease();
+}
@@ -0,0 +1,21 @@
+#ifndef DETAIL_POOL_H
+#define DETAIL_POOL_H
+
+#include <stdbool.h>
+#include "helper.h"
+
+// 검색 결과의 상세 정보를 여러 작업 스레드가 나눠 가져옴
+// 작업 스레드마다 도우미 연결(없으면 popen)을 따로 쓰므로 요청이 동시에 진행됨
+// 결과는 메인 스레드가 poolCollect에서 apply로 넘겨받음 (index는 requests의 순서)
+typedef void (*PoolApply)(void *context, int index, TextBuffer *text);
+
+// requests의 문자열은 poolStop까지 유지되어야 함
+bool poolStart(const DetailRequest *requests, int count, int workers, PoolApply apply, void *context);
+int poolFd(void);
+bool poolCollect(void);
+void poolFocus(int request);
+bool poolActive(void);
+void poolProgress(int *done, int *total);
+void poolStop(void);
+
+#endif // DETAIL_POOL_H
@@ -0,0 +1,155 @@
+#include <string.h>
+#include "filter.h"
+#include "constants.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define FILTER_X86 1
+#endif
+
+static inline unsigned char lowerByte(unsigned char c) {
+    return (c >= 'A' && c <= 'Z') ? (unsigned char)(c | 0x20) : c;
+}
+
+// 첫 글자 이후를 대소문자 무시로 비교
+static inline bool equalTail(const char *text, const char *needle, size_t length) {
+    for (size_t i = 1; i < length; i++) {
+        if (lowerByte((unsigned char)text[i]) != (unsigned char)needle[i]) return false;
+    }
+    return true;
+}
+
+static inline __attribute__((always_inline)) bool containsScalar(const char *haystack, size_t length, const char *needle, size_t needleLen, size_t from) {
+    unsigned char first = (unsigned char)needle[0];
+
+    for (size_t i = from; i + needleLen <= length; i++) {
+        if (lowerByte((unsigned char)haystack[i]) == first && equalTail(haystack + i, needle, needleLen)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+#ifdef FILTER_X86
+// 'A'..'Z' 바이트만 0x20을 더해 소문자로 변환
+static inline __attribute__((always_inline)) __m128i lower128(__m128i v) {
+    __m128i upper = _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8('A' - 1)),
+                                  _mm_cmplt_epi8(v, _mm_set1_epi8('Z' + 1)));
+    return _mm_or_si128(v, _mm_and_si128(upper, _mm_set1_epi8(0x20)));
+}
+
+// 첫 글자와 끝 글자가 동시에 맞는 위치만 골라 나머지를 비교 (16바이트 단위)
+// AVX2 구현의 꼬리 처리에도 인라인되어 VEX 인코딩으로 컴파일됨 (SSE/AVX 전환 비용 방지)
+static inline __attribute__((always_inline)) bool containsSse2Body(const char *haystack, size_t length, const char *needle, size_t needleLen) {
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[needleLen - 1]);
+    size_t i = 0;
+
+    for (; i + needleLen - 1 + 16 <= length; i += 16) {
+        __m128i blockFirst = lower128(_mm_loadu_si128((const __m128i *)(haystack + i)));
+        __m128i blockLast = lower128(_mm_loadu_si128((const __m128i *)(haystack + i + needleLen - 1)));
+        unsigned mask = (unsigned)_mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first),
+                                                                  _mm_cmpeq_epi8(blockLast, last)));
+        while (mask) {
+            int bit = __builtin_ctz(mask);
+            if (equalTail(haystack + i + bit, needle, needleLen)) return true;
+            mask &= mask - 1;
+        }
+    }
+    return containsScalar(haystack, length, needle, needleLen, i);
+}
+
+static bool containsSse2(const char *haystack, size_t length, const char *needle, size_t needleLen) {
+    return containsSse2Body(haystack, length, needle, needleLen);
+}
+
+__attribute__((target("avx2")))
+static inline __m256i lower256(__m256i v) {
+    __m256i upper = _mm256_and_si256(_mm256_cmpgt_epi8(v, _mm256_set1_epi8('A' - 1)),
+                                     _mm256_cmpgt_epi8(_mm256_set1_epi8('Z' + 1), v));
+    return _mm256_or_si256(v, _mm256_and_si256(upper, _mm256_set1_epi8(0x20)));
+}
+
+// containsSse2와 같은 방식을 32바이트 단위로 처리
+__attribute__((target("avx2")))
+static bool containsAvx2(const char *haystack, size_t length, const char *needle, size_t needleLen) {
+    const __m256i first = _mm256_set1_epi8(needle[0]);
+    const __m256i last = _mm256_set1_epi8(needle[needleLen - 1]);
+    size_t i = 0;
+
+    for (; i + needleLen - 1 + 32 <= length; i += 32) {
+        __m256i blockFirst = lower256(_mm256_loadu_si256((const __m256i *)(haystack + i)));
+        __m256i blockLast = lower256(_mm256_loadu_si256((const __m256i *)(haystack + i + needleLen - 1)));
+        unsigned mask = (unsigned)_mm256_movemask_epi8(_mm256_and_si256(_mm256_cmpeq_epi8(blockFirst, first),
+                                                                        _mm256_cmpeq_epi8(blockLast, last)));
+        while (mask) {
+            int bit = __builtin_ctz(mask);
+            if (equalTail(haystack + i + bit, needle, needleLen)) return true;
+            mask &= mask - 1;
+        }
+    }
+    return containsSse2Body(haystack + i, length - i, needle, needleLen);
+}
+#endif
+
+typedef bool (*ContainsFunction)(const char *, size_t, const char *, size_t);
+
+static bool containsPortable(const char *haystack, size_t length, const char *needle, size_t needleLen) {
+    return containsScalar(haystack, length, needle, needleLen, 0);
+}
+
+// CPU 기능에 맞는 구현을 한 번만 선택
+static ContainsFunction selectImplementation(const char **name) {
+#ifdef FILTER_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) {
+        *name = "avx2";
+        return containsAvx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        *name = "sse2";
+        return containsSse2;
+    }
+#endif
+    *name = "scalar";
+    return containsPortable;
+}
+
+static ContainsFunction containsImpl = NULL;
+static const char *containsName = "scalar";
+
+const char *filterImplementation(void) {
+    if (!containsImpl) containsImpl = selectImplementation(&containsName);
+    return containsName;
+}
+
+bool containsIgnoreCase(const char *haystack, size_t length, const char *needle, size_t needleLen) {
+    if (needleLen == 0) return true;
+    if (needleLen > length) return false;
+    if (!containsImpl) containsImpl = selectImplementation(&containsName);
+    return containsImpl(haystack, length, needle, needleLen);
+}
+
+// candidates(NULL이면 전체)의 항목 중 이름이나 요약에 query가 포함된 번호를 out에 기록
+int filterPackages(const PackageStore *store, const int *candidates, int count,
+                   const char *query, int *out) {
+    char needle[FILTER_QUERY_SIZE];
+    size_t needleLen = 0;
+
+    for (; query[needleLen] && needleLen < sizeof(needle) - 1; needleLen++) {
+        needle[needleLen] = (char)lowerByte((unsigned char)query[needleLen]);
+    }
+    needle[needleLen] = '\0';
+
+    int matched = 0;
+    for (int i = 0; i < count; i++) {
+        int index = candidates ? candidates[i] : i;
+        const Package *package = &store->items[index];
+
+        if (containsIgnoreCase(package->name, strlen(package->name), needle, needleLen)
+            || containsIgnoreCase(package->description, strlen(package->description), needle, needleLen)) {
+            out[matched++] = index;
+        }
+    }
+    return matched;
+}
@@ -0,0 +1,14 @@
+#ifndef FILTER_H
+#define FILTER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "package_store.h"
+
+// 대소문자 무시 부분 문자열 검사 (SSE2/AVX2 지원 시 벡터화). needle은 소문자여야 함
+bool containsIgnoreCase(const char *haystack, size_t length, const char *needle, size_t needleLen);
+int filterPackages(const PackageStore *store, const int *candidates, int count,
+                   const char *query, int *out);
+const char *filterImplementation(void);
+
+#endif // FILTER_H
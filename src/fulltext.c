@@ -0,0 +1,569 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "fulltext.h"
+#include "constants.h"
+#include "trace.h"
+#include "package_store.h"
+
+// 파일 형식 (리틀 엔디언, 모든 오프셋은 파일 시작 기준이며 8바이트 경계)
+//   FullTextHeader
+//   termOffsets[termCount], slots[slotCount], postingOffsets[termCount + 1],
+//   postings[postingCount], documentNorms[documentCount], termText[textSize]
+#define FULLTEXT_MAGIC "PMFTIDX\0"
+#define FULLTEXT_VERSION 1
+
+typedef struct FullTextHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t documentCount;
+    uint64_t key;               // 색인을 만든 저장소·목록 파일의 서명 (다르면 다시 만듦)
+    uint32_t termCount;
+    uint32_t slotCount;
+    uint32_t postingCount;
+    uint32_t textSize;
+    double averageLength;
+    uint64_t termOffsetsOffset;
+    uint64_t slotsOffset;
+    uint64_t postingOffsetsOffset;
+    uint64_t postingsOffset;
+    uint64_t normsOffset;
+    uint64_t textOffset;
+} FullTextHeader;
+
+typedef struct FullTextEntry {
+    uint32_t term;
+    uint32_t document;
+    uint16_t nameFrequency;
+    uint16_t bodyFrequency;
+} FullTextEntry;
+
+typedef void (*TermVisitor)(const char *term, size_t length, void *context);
+
+static inline bool isTermByte(unsigned char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c >= 0x80;
+}
+
+// 영숫자(와 UTF-8 바이트) 연속을 소문자 단어로 잘라 차례로 넘김. 너무 긴 단어는 앞부분만
+static void forEachTerm(const char *text, size_t length, TermVisitor visit, void *context) {
+    char term[FULLTEXT_TERM_MAX];
+    size_t i = 0;
+
+    while (i < length) {
+        while (i < length && !isTermByte((unsigned char)text[i])) i++;
+
+        size_t termLen = 0;
+        for (; i < length && isTermByte((unsigned char)text[i]); i++) {
+            unsigned char c = (unsigned char)text[i];
+            if (termLen < sizeof(term)) term[termLen++] = (char)(c >= 'A' && c <= 'Z' ? c + ('a' - 'A') : c);
+        }
+        if (termLen >= FULLTEXT_TERM_MIN) visit(term, termLen, context);
+    }
+}
+
+// ---- 구성 ----
+
+bool fullTextBegin(FullTextBuilder *builder, uint32_t documentCount) {
+    memset(builder, 0, sizeof(*builder));
+    builder->documentCount = documentCount;
+    builder->slotCount = 1024;
+    builder->termCapacity = 512;
+    builder->textCapacity = 4096;
+    builder->entryCapacity = 4096;
+
+    builder->slots = (uint32_t *)calloc(builder->slotCount, sizeof(uint32_t));
+    builder->termOffsets = (uint32_t *)malloc(builder->termCapacity * sizeof(uint32_t));
+    builder->lastDocument = (uint32_t *)malloc(builder->termCapacity * sizeof(uint32_t));
+    builder->lastEntry = (uint32_t *)malloc(builder->termCapacity * sizeof(uint32_t));
+    builder->text = (char *)malloc(builder->textCapacity);
+    builder->entries = (FullTextEntry *)malloc(builder->entryCapacity * sizeof(FullTextEntry));
+    builder->lengths = (uint32_t *)calloc(documentCount + 1, sizeof(uint32_t));
+
+    builder->failed = !builder->slots || !builder->termOffsets || !builder->lastDocument || !builder->lastEntry
+                   || !builder->text || !builder->entries || !builder->lengths;
+    return !builder->failed;
+}
+
+static void builderFree(FullTextBuilder *builder) {
+    free(builder->slots);
+    free(builder->termOffsets);
+    free(builder->lastDocument);
+    free(builder->lastEntry);
+    free(builder->text);
+    free(builder->entries);
+    free(builder->lengths);
+    memset(builder, 0, sizeof(*builder));
+}
+
+static bool growArray(void *arrayPtr, size_t count, size_t elementSize) {
+    void **array = (void **)arrayPtr;
+    void *grown = realloc(*array, count * elementSize);
+    if (!grown) return false;
+    *array = grown;
+    return true;
+}
+
+// 해시 표를 두 배로 늘려 모든 단어를 다시 넣음
+static bool growSlots(FullTextBuilder *builder) {
+    uint32_t slotCount = builder->slotCount * 2;
+    uint32_t *slots = (uint32_t *)calloc(slotCount, sizeof(uint32_t));
+    if (!slots) return false;
+
+    for (uint32_t id = 0; id < builder->termCount; id++) {
+        const char *term = builder->text + builder->termOffsets[id];
+        uint32_t slot = hashString(term, strlen(term)) & (slotCount - 1);
+        while (slots[slot]) slot = (slot + 1) & (slotCount - 1);
+        slots[slot] = id + 1;
+    }
+    free(builder->slots);
+    builder->slots = slots;
+    builder->slotCount = slotCount;
+    return true;
+}
+
+// 단어 번호 (처음 나온 단어면 사전에 추가). 메모리가 부족하면 UINT32_MAX
+static uint32_t internTerm(FullTextBuilder *builder, const char *term, size_t length) {
+    uint32_t hash = hashString(term, length);
+    uint32_t mask = builder->slotCount - 1;
+    uint32_t slot = hash & mask;
+
+    for (; builder->slots[slot]; slot = (slot + 1) & mask) {
+        uint32_t id = builder->slots[slot] - 1;
+        const char *existing = builder->text + builder->termOffsets[id];
+        if (strncmp(existing, term, length) == 0 && existing[length] == '\0') return id;
+    }
+
+    if (builder->termCount == builder->termCapacity) {
+        uint32_t capacity = builder->termCapacity * 2;
+        if (!growArray(&builder->termOffsets, capacity, sizeof(uint32_t))
+            || !growArray(&builder->lastDocument, capacity, sizeof(uint32_t))
+            || !growArray(&builder->lastEntry, capacity, sizeof(uint32_t))) {
+            return UINT32_MAX;
+        }
+        builder->termCapacity = capacity;
+    }
+    if (builder->textSize + length + 1 > builder->textCapacity) {
+        size_t capacity = builder->textCapacity * 2;
+        if (capacity > UINT32_MAX || !growArray(&builder->text, capacity, 1)) return UINT32_MAX;
+        builder->textCapacity = capacity;
+    }
+
+    uint32_t id = builder->termCount++;
+    builder->termOffsets[id] = (uint32_t)builder->textSize;
+    builder->lastDocument[id] = 0;
+    memcpy(builder->text + builder->textSize, term, length);
+    builder->text[builder->textSize + length] = '\0';
+    builder->textSize += length + 1;
+
+    // 절반 넘게 차면 늘림 (늘리면서 새 단어도 들어감)
+    if (builder->termCount * 2 > builder->slotCount) {
+        if (!growSlots(builder)) return UINT32_MAX;
+    } else {
+        builder->slots[slot] = id + 1;
+    }
+    return id;
+}
+
+typedef struct TermContext {
+    FullTextBuilder *builder;
+    uint32_t document;
+    bool isName;
+} TermContext;
+
+static void addTerm(const char *term, size_t length, void *context) {
+    TermContext *add = (TermContext *)context;
+    FullTextBuilder *builder = add->builder;
+
+    if (builder->failed) return;
+    uint32_t id = internTerm(builder, term, length);
+    if (id == UINT32_MAX) {
+        builder->failed = true;
+        return;
+    }
+
+    // 문서에서 처음 나온 단어면 새 항목, 아니면 빈도만 올림
+    if (builder->lastDocument[id] != add->document + 1) {
+        if (builder->entryCount == builder->entryCapacity) {
+            size_t capacity = builder->entryCapacity * 2;
+            if (capacity > UINT32_MAX || !growArray(&builder->entries, capacity, sizeof(FullTextEntry))) {
+                builder->failed = true;
+                return;
+            }
+            builder->entryCapacity = capacity;
+        }
+        builder->lastDocument[id] = add->document + 1;
+        builder->lastEntry[id] = (uint32_t)builder->entryCount;
+        builder->entries[builder->entryCount++] = (FullTextEntry){ .term = id, .document = add->document };
+    }
+
+    FullTextEntry *entry = &builder->entries[builder->lastEntry[id]];
+    if (add->isName) {
+        if (entry->nameFrequency < UINT16_MAX) entry->nameFrequency++;
+    } else {
+        if (entry->bodyFrequency < UINT16_MAX) entry->bodyFrequency++;
+    }
+    builder->lengths[add->document] += add->isName ? FULLTEXT_NAME_WEIGHT : 1;
+}
+
+void fullTextAdd(FullTextBuilder *builder, uint32_t document, const char *text, size_t length, bool isName) {
+    TermContext add = { .builder = builder, .document = document, .isName = isName };
+
+    if (!text || document >= builder->documentCount) return;
+    forEachTerm(text, length, addTerm, &add);
+}
+
+// 단어별로 모은 CSR 배열과 문서 길이 정규화 값을 만들고 구성 상태를 해제
+bool fullTextFinish(FullTextBuilder *builder, FullTextIndex *index) {
+    uint64_t start = traceNowUs();
+    memset(index, 0, sizeof(*index));
+
+    uint32_t termCount = builder->termCount;
+    uint32_t *offsets = builder->failed ? NULL : (uint32_t *)calloc(termCount + 1, sizeof(uint32_t));
+    FullTextPosting *postings = builder->failed ? NULL
+        : (FullTextPosting *)malloc((builder->entryCount + 1) * sizeof(FullTextPosting));
+    float *norms = builder->failed ? NULL : (float *)malloc((builder->documentCount + 1) * sizeof(float));
+    if (!offsets || !postings || !norms) {
+        free(offsets);
+        free(postings);
+        free(norms);
+        builderFree(builder);
+        return false;
+    }
+
+    // 단어별 개수 → 누적합 → 위치에 채움 (lastEntry는 더 쓰지 않으므로 채울 위치로 재사용)
+    for (size_t i = 0; i < builder->entryCount; i++) offsets[builder->entries[i].term + 1]++;
+    for (uint32_t term = 0; term < termCount; term++) offsets[term + 1] += offsets[term];
+    uint32_t *cursor = builder->lastEntry;
+    memcpy(cursor, offsets, termCount * sizeof(uint32_t));
+    for (size_t i = 0; i < builder->entryCount; i++) {
+        const FullTextEntry *entry = &builder->entries[i];
+        postings[cursor[entry->term]++] = (FullTextPosting){
+            .document = entry->document,
+            .nameFrequency = entry->nameFrequency,
+            .bodyFrequency = entry->bodyFrequency,
+        };
+    }
+
+    uint64_t totalLength = 0;
+    for (uint32_t doc = 0; doc < builder->documentCount; doc++) totalLength += builder->lengths[doc];
+    double average = builder->documentCount > 0 && totalLength > 0 ? (double)totalLength / builder->documentCount : 1.0;
+    for (uint32_t doc = 0; doc < builder->documentCount; doc++) {
+        norms[doc] = FULLTEXT_K1 * (1.0f - FULLTEXT_B + FULLTEXT_B * (float)(builder->lengths[doc] / average));
+    }
+
+    index->termText = builder->text;
+    index->termOffsets = builder->termOffsets;
+    index->slots = builder->slots;
+    index->postingOffsets = offsets;
+    index->postings = postings;
+    index->documentNorms = norms;
+    index->termCount = termCount;
+    index->slotCount = builder->slotCount;
+    index->postingCount = (uint32_t)builder->entryCount;
+    index->documentCount = builder->documentCount;
+    index->textSize = (uint32_t)builder->textSize;
+    index->averageLength = average;
+    index->buildMs = (traceNowUs() - start) / 1e3;
+
+    // 색인으로 넘긴 배열은 해제하지 않음
+    builder->text = NULL;
+    builder->termOffsets = NULL;
+    builder->slots = NULL;
+    builderFree(builder);
+    return true;
+}
+
+void fullTextFree(FullTextIndex *index) {
+    if (index->mapping) {
+        munmap((void *)index->mapping, index->mappingSize);
+    } else {
+        free((void *)index->termText);
+        free((void *)index->termOffsets);
+        free((void *)index->slots);
+        free((void *)index->postingOffsets);
+        free((void *)index->postings);
+        free((void *)index->documentNorms);
+    }
+    memset(index, 0, sizeof(*index));
+}
+
+size_t fullTextBytes(const FullTextIndex *index) {
+    return (size_t)index->termCount * sizeof(uint32_t) * 2
+         + (size_t)index->slotCount * sizeof(uint32_t)
+         + (size_t)index->postingCount * sizeof(FullTextPosting)
+         + (size_t)index->documentCount * sizeof(float)
+         + index->textSize;
+}
+
+// ---- 질의 ----
+
+// 단어 번호. 없으면 -1 (파일에서 읽은 색인도 범위를 벗어나는 값은 무시)
+static int lookupTerm(const FullTextIndex *index, const char *term, size_t length) {
+    uint32_t mask = index->slotCount - 1;
+    uint32_t slot = hashString(term, length) & mask;
+
+    for (uint32_t probe = 0; probe < index->slotCount; probe++, slot = (slot + 1) & mask) {
+        uint32_t id = index->slots[slot];
+        if (id == 0 || id > index->termCount) return -1;
+
+        uint32_t offset = index->termOffsets[id - 1];
+        if ((size_t)offset + length < index->textSize
+            && memcmp(index->termText + offset, term, length) == 0 && index->termText[offset + length] == '\0') {
+            return (int)(id - 1);
+        }
+    }
+    return -1;
+}
+
+typedef struct QueryTerms {
+    const FullTextIndex *index;
+    int ids[FULLTEXT_QUERY_TERMS];
+    int count;
+} QueryTerms;
+
+static void collectTerm(const char *term, size_t length, void *context) {
+    QueryTerms *terms = (QueryTerms *)context;
+    int id = lookupTerm(terms->index, term, length);
+
+    if (id < 0 || terms->count == FULLTEXT_QUERY_TERMS) return;
+    for (int i = 0; i < terms->count; i++) {
+        if (terms->ids[i] == id) return;
+    }
+    terms->ids[terms->count++] = id;
+}
+
+// 점수가 높은 쪽, 같으면 번호(이름순)가 앞인 쪽이 앞
+static bool ranksBefore(const FullTextHit *a, const FullTextHit *b) {
+    return a->score > b->score || (a->score == b->score && a->document < b->document);
+}
+
+static int compareHits(const void *a, const void *b) {
+    const FullTextHit *ha = (const FullTextHit *)a;
+    const FullTextHit *hb = (const FullTextHit *)b;
+    return ranksBefore(ha, hb) ? -1 : ranksBefore(hb, ha) ? 1 : 0;
+}
+
+// 가장 순위가 낮은 결과가 뿌리인 힙
+static void heapDown(FullTextHit *heap, int count, int i) {
+    for (;;) {
+        int worst = i, left = 2 * i + 1, right = left + 1;
+        if (left < count && ranksBefore(&heap[worst], &heap[left])) worst = left;
+        if (right < count && ranksBefore(&heap[worst], &heap[right])) worst = right;
+        if (worst == i) return;
+        FullTextHit swap = heap[i];
+        heap[i] = heap[worst];
+        heap[worst] = swap;
+        i = worst;
+    }
+}
+
+static void heapUp(FullTextHit *heap, int i) {
+    while (i > 0) {
+        int parent = (i - 1) / 2;
+        if (!ranksBefore(&heap[parent], &heap[i])) return;
+        FullTextHit swap = heap[i];
+        heap[i] = heap[parent];
+        heap[parent] = swap;
+        i = parent;
+    }
+}
+
+// 질의 단어 중 하나라도 있는 문서를 BM25 점수로 매겨 상위 limit개를 hits에 순서대로 넣음
+// 결과 수, 메모리가 부족하면 -1
+int fullTextQuery(const FullTextIndex *index, const char *query, FullTextHit *hits, int limit) {
+    QueryTerms terms = { .index = index };
+
+    if (!index->postings || index->slotCount == 0 || limit <= 0) return 0;
+    forEachTerm(query, strlen(query), collectTerm, &terms);
+    if (terms.count == 0) return 0;
+
+    float *scores = (float *)calloc(index->documentCount, sizeof(float));
+    uint32_t *touched = (uint32_t *)malloc(index->documentCount * sizeof(uint32_t));
+    if (!scores || !touched) {
+        free(scores);
+        free(touched);
+        return -1;
+    }
+
+    // 점수 기여는 항상 양수이므로 점수가 0인 문서가 처음 나온 문서
+    uint32_t touchedCount = 0;
+    float documents = (float)index->documentCount;
+    for (int t = 0; t < terms.count; t++) {
+        uint32_t first = index->postingOffsets[terms.ids[t]];
+        uint32_t last = index->postingOffsets[terms.ids[t] + 1];
+        if (first > last || last > index->postingCount) continue;
+
+        float frequency = (float)(last - first);
+        float idf = logf(1.0f + (documents - frequency + 0.5f) / (frequency + 0.5f));
+        if (!(idf > 0)) idf = 1e-6f;
+
+        for (uint32_t p = first; p < last; p++) {
+            const FullTextPosting *posting = &index->postings[p];
+            uint32_t doc = posting->document;
+            float tf = (float)(FULLTEXT_NAME_WEIGHT * posting->nameFrequency + posting->bodyFrequency);
+            if (doc >= index->documentCount || tf == 0) continue;
+
+            if (scores[doc] == 0) touched[touchedCount++] = doc;
+            scores[doc] += idf * tf * (FULLTEXT_K1 + 1) / (tf + index->documentNorms[doc]);
+        }
+    }
+
+    int count = 0;
+    for (uint32_t i = 0; i < touchedCount; i++) {
+        FullTextHit hit = { .document = (int)touched[i], .score = scores[touched[i]] };
+        if (count < limit) {
+            hits[count] = hit;
+            heapUp(hits, count++);
+        } else if (ranksBefore(&hit, &hits[0])) {
+            hits[0] = hit;
+            heapDown(hits, count, 0);
+        }
+    }
+    qsort(hits, (size_t)count, sizeof(FullTextHit), compareHits);
+
+    free(scores);
+    free(touched);
+    return count;
+}
+
+// ---- 저장·적재 ----
+
+// 8바이트 경계에 맞춰 배열 하나를 쓰고 시작 위치를 offset에 넣음
+static bool writeSection(FILE *fp, const void *data, size_t size, uint64_t *position, uint64_t *offset) {
+    static const char zeros[8];
+    size_t pad = (size_t)((8 - *position % 8) % 8);
+
+    if (pad > 0 && fwrite(zeros, 1, pad, fp) != pad) return false;
+    *position += pad;
+    *offset = *position;
+    if (size > 0 && fwrite(data, 1, size, fp) != size) return false;
+    *position += size;
+    return true;
+}
+
+// 임시 파일에 기록한 뒤 rename (스냅샷과 같은 방식)
+bool fullTextSave(const FullTextIndex *index, const char *path, uint64_t key) {
+    char tmpPath[PATH_BUFFER_SIZE];
+
+    if (!index->postings || index->mapping) return false;
+    if (snprintf(tmpPath, sizeof(tmpPath), "%s.XXXXXX", path) >= (int)sizeof(tmpPath)) return false;
+    int fd = mkstemp(tmpPath);
+    if (fd < 0) return false;
+
+    FILE *fp = fdopen(fd, "wb");
+    if (!fp) {
+        close(fd);
+        unlink(tmpPath);
+        return false;
+    }
+
+    FullTextHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, FULLTEXT_MAGIC, sizeof(header.magic));
+    header.version = FULLTEXT_VERSION;
+    header.documentCount = index->documentCount;
+    header.key = key;
+    header.termCount = index->termCount;
+    header.slotCount = index->slotCount;
+    header.postingCount = index->postingCount;
+    header.textSize = index->textSize;
+    header.averageLength = index->averageLength;
+
+    uint64_t position = sizeof(header);
+    bool ok = fseek(fp, (long)position, SEEK_SET) == 0
+        && writeSection(fp, index->termOffsets, index->termCount * sizeof(uint32_t), &position, &header.termOffsetsOffset)
+        && writeSection(fp, index->slots, index->slotCount * sizeof(uint32_t), &position, &header.slotsOffset)
+        && writeSection(fp, index->postingOffsets, (index->termCount + 1) * sizeof(uint32_t), &position,
+                        &header.postingOffsetsOffset)
+        && writeSection(fp, index->postings, index->postingCount * sizeof(FullTextPosting), &position,
+                        &header.postingsOffset)
+        && writeSection(fp, index->documentNorms, index->documentCount * sizeof(float), &position, &header.normsOffset)
+        && writeSection(fp, index->termText, index->textSize, &position, &header.textOffset)
+        && fseek(fp, 0, SEEK_SET) == 0
+        && fwrite(&header, sizeof(header), 1, fp) == 1;
+
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok || rename(tmpPath, path) < 0) {
+        unlink(tmpPath);
+        return false;
+    }
+    return true;
+}
+
+static bool sectionFits(uint64_t offset, uint64_t count, uint64_t elementSize, size_t fileSize) {
+    return offset % 8 == 0 && offset >= sizeof(FullTextHeader) && offset <= fileSize
+        && count * elementSize <= fileSize - offset;
+}
+
+// 저장된 색인을 매핑. key나 문서 수가 다르거나 손상되었으면 false (배열은 매핑을 직접 가리킴)
+bool fullTextLoad(FullTextIndex *index, const char *path, uint64_t key, uint32_t documentCount) {
+    struct stat st;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(FullTextHeader)) {
+        close(fd);
+        return false;
+    }
+
+    size_t size = (size_t)st.st_size;
+    const char *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+
+    const FullTextHeader *header = (const FullTextHeader *)data;
+    bool ok = memcmp(header->magic, FULLTEXT_MAGIC, sizeof(header->magic)) == 0
+        && header->version == FULLTEXT_VERSION
+        && header->key == key
+        && header->documentCount == documentCount
+        && header->slotCount > 0 && (header->slotCount & (header->slotCount - 1)) == 0
+        && header->textSize > 0
+        && sectionFits(header->termOffsetsOffset, header->termCount, sizeof(uint32_t), size)
+        && sectionFits(header->slotsOffset, header->slotCount, sizeof(uint32_t), size)
+        && sectionFits(header->postingOffsetsOffset, (uint64_t)header->termCount + 1, sizeof(uint32_t), size)
+        && sectionFits(header->postingsOffset, header->postingCount, sizeof(FullTextPosting), size)
+        && sectionFits(header->normsOffset, header->documentCount, sizeof(float), size)
+        && sectionFits(header->textOffset, header->textSize, 1, size)
+        && data[header->textOffset + header->textSize - 1] == '\0';
+
+    // 질의는 단어 위치·범위만 다시 확인하므로 여기서는 한 번 훑어 볼 만한 것만 검사
+    if (ok) {
+        const uint32_t *termOffsets = (const uint32_t *)(data + header->termOffsetsOffset);
+        const uint32_t *postingOffsets = (const uint32_t *)(data + header->postingOffsetsOffset);
+        const float *norms = (const float *)(data + header->normsOffset);
+
+        ok = postingOffsets[header->termCount] == header->postingCount;
+        for (uint32_t i = 0; ok && i < header->termCount; i++) {
+            ok = termOffsets[i] < header->textSize && postingOffsets[i] <= postingOffsets[i + 1];
+        }
+        for (uint32_t doc = 0; ok && doc < header->documentCount; doc++) {
+            ok = isfinite(norms[doc]) && norms[doc] > 0;
+        }
+    }
+    if (!ok) {
+        munmap((void *)data, size);
+        return false;
+    }
+
+    memset(index, 0, sizeof(*index));
+    index->termText = data + header->textOffset;
+    index->termOffsets = (const uint32_t *)(data + header->termOffsetsOffset);
+    index->slots = (const uint32_t *)(data + header->slotsOffset);
+    index->postingOffsets = (const uint32_t *)(data + header->postingOffsetsOffset);
+    index->postings = (const FullTextPosting *)(data + header->postingsOffset);
+    index->documentNorms = (const float *)(data + header->normsOffset);
+    index->termCount = header->termCount;
+    index->slotCount = header->slotCount;
+    index->postingCount = header->postingCount;
+    index->documentCount = header->documentCount;
+    index->textSize = header->textSize;
+    index->averageLength = header->averageLength;
+    index->mapping = data;
+    index->mappingSize = size;
+    return true;
+}
@@ -0,0 +1,71 @@
+#ifndef FULLTEXT_H
+#define FULLTEXT_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// 이름·요약·긴 설명의 단어 → 패키지 역색인과 BM25 순위 질의
+//
+// 단어는 영숫자(와 UTF-8 바이트) 연속을 소문자로 바꾼 것. 문서 번호는 색인을 만든 저장소의 번호이고,
+// 이름에 나온 단어는 FULLTEXT_NAME_WEIGHT배로 셈 (BM25F처럼 필드 가중 빈도·길이 사용)
+// 구성한 색인과 파일에서 매핑한 색인은 같은 배열 구조라 질의 코드는 구분하지 않음
+typedef struct FullTextPosting {
+    uint32_t document;
+    uint16_t nameFrequency;
+    uint16_t bodyFrequency;
+} FullTextPosting;
+
+typedef struct FullTextIndex {
+    const char *termText;               // NUL 종료 단어 연속
+    const uint32_t *termOffsets;        // 단어 번호 → termText 위치
+    const uint32_t *slots;              // 단어 해시 표 (단어 번호 + 1, 0은 빈 칸). 크기는 2의 거듭제곱
+    const uint32_t *postingOffsets;     // 단어별 postings 시작 위치 (단어 수 + 1개)
+    const FullTextPosting *postings;    // 단어마다 문서가 추가된 순서
+    const float *documentNorms;         // k1 * (1 - b + b * 길이 / 평균 길이)
+    uint32_t termCount;
+    uint32_t slotCount;
+    uint32_t postingCount;
+    uint32_t documentCount;
+    uint32_t textSize;
+    double averageLength;
+    double buildMs;
+    const void *mapping;                // 파일에서 적재한 경우 (배열이 모두 매핑을 가리킴)
+    size_t mappingSize;
+} FullTextIndex;
+
+// 구성 중 상태. 한 문서에 대한 fullTextAdd 호출은 다른 문서 호출과 섞이지 않아야 함
+typedef struct FullTextBuilder {
+    uint32_t documentCount;
+    char *text;
+    size_t textSize;
+    size_t textCapacity;
+    uint32_t *termOffsets;
+    uint32_t *lastDocument;             // 단어별 마지막으로 나온 문서 번호 + 1
+    uint32_t *lastEntry;                // 단어별 그 문서의 entries 위치
+    uint32_t termCount;
+    uint32_t termCapacity;
+    uint32_t *slots;
+    uint32_t slotCount;
+    struct FullTextEntry *entries;      // (단어, 문서, 빈도) 나온 순서대로
+    size_t entryCount;
+    size_t entryCapacity;
+    uint32_t *lengths;                  // 문서별 가중 길이
+    bool failed;
+} FullTextBuilder;
+
+typedef struct FullTextHit {
+    int document;
+    float score;
+} FullTextHit;
+
+bool fullTextBegin(FullTextBuilder *builder, uint32_t documentCount);
+void fullTextAdd(FullTextBuilder *builder, uint32_t document, const char *text, size_t length, bool isName);
+bool fullTextFinish(FullTextBuilder *builder, FullTextIndex *index);
+void fullTextFree(FullTextIndex *index);
+int fullTextQuery(const FullTextIndex *index, const char *query, FullTextHit *hits, int limit);
+bool fullTextSave(const FullTextIndex *index, const char *path, uint64_t key);
+bool fullTextLoad(FullTextIndex *index, const char *path, uint64_t key, uint32_t documentCount);
+size_t fullTextBytes(const FullTextIndex *index);
+
+#endif // FULLTEXT_H
@@ -0,0 +1,331 @@
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pthread.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include "helper.h"
+#include "config.h"
+#include "constants.h"
+#include "utils.h"
+#include "trace.h"
+
+static HelperConnection sharedConnection = {
+    .lock = PTHREAD_MUTEX_INITIALIZER, .pid = -1, .fd = -1,
+};
+
+void helperInit(HelperConnection *conn) {
+    memset(conn, 0, sizeof(*conn));
+    pthread_mutex_init(&conn->lock, NULL);
+    conn->pid = -1;
+    conn->fd = -1;
+}
+
+static void helperClose(HelperConnection *conn) {
+    if (conn->in) {
+        fclose(conn->in);  // conn->fd도 함께 닫힘
+        conn->in = NULL;
+        conn->fd = -1;
+    }
+    if (conn->pid > 0) {
+        while (waitpid(conn->pid, NULL, 0) < 0 && errno == EINTR) {}
+        conn->pid = -1;
+    }
+}
+
+static bool helperSpawn(HelperConnection *conn) {
+    int sv[2];
+
+    if (!config.helperPath || socketpair(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0, sv) < 0) {
+        return false;
+    }
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(sv[0]);
+        close(sv[1]);
+        return false;
+    }
+
+    if (pid == 0) {
+        int devnull = open("/dev/null", O_WRONLY);
+        dup2(sv[1], STDIN_FILENO);
+        dup2(sv[1], STDOUT_FILENO);
+        if (devnull >= 0) dup2(devnull, STDERR_FILENO);
+        // 터미널의 Ctrl-C로 함께 죽지 않도록 함 (연결이 끊기면 스스로 종료)
+        signal(SIGINT, SIG_IGN);
+        execl(config.helperPath, config.helperPath, "--helper", (char *)NULL);
+        _exit(127);
+    }
+
+    close(sv[1]);
+    conn->pid = pid;
+    conn->in = fdopen(sv[0], "r");
+    if (!conn->in) {
+        close(sv[0]);
+        helperClose(conn);
+        return false;
+    }
+    conn->fd = sv[0];
+    return true;
+}
+
+static bool tracedSpawn(HelperConnection *conn) {
+    uint64_t start = traceBegin();
+    bool ok = helperSpawn(conn);
+    traceEnd("helper spawn", start);
+    return ok;
+}
+
+// 도우미가 먼저 죽어도 SIGPIPE로 프로그램이 끝나지 않게 send 사용
+static bool sendAll(int fd, const char *data, size_t length) {
+    while (length > 0) {
+        ssize_t n = send(fd, data, length, MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR) continue;
+        if (n <= 0) return false;
+        data += n;
+        length -= (size_t)n;
+    }
+    return true;
+}
+
+static bool readExact(FILE *fp, size_t length, TextBuffer *text) {
+    char chunk[BUFFER_SIZE * 4];
+
+    while (length > 0) {
+        size_t want = length < sizeof(chunk) ? length : sizeof(chunk);
+        size_t n = fread(chunk, 1, want, fp);
+        if (n == 0 || !textAppend(text, chunk, n)) return false;
+        length -= n;
+    }
+    return true;
+}
+
+// 한 묶음 요청·응답 (requests 중 이름이 올바른 것만 보냄)
+static bool exchange(HelperConnection *conn, const DetailRequest *requests, int count, TextBuffer *texts) {
+    int sent[HELPER_BATCH_MAX];
+    int sentCount = 0;
+    size_t capacity = 32 + (size_t)count * (PACKAGE_NAME_SIZE * 2 + 4);
+    char *message = (char *)malloc(capacity);
+    if (!message) return false;
+
+    for (int i = 0; i < count; i++) {
+        if (isValidPackageName(requests[i].name)) sent[sentCount++] = i;
+    }
+
+    size_t length = (size_t)snprintf(message, capacity, "batch %d\n", sentCount);
+    for (int i = 0; i < sentCount; i++) {
+        const DetailRequest *request = &requests[sent[i]];
+        const char *version = request->version && isValidVersion(request->version) ? request->version : "-";
+        length += (size_t)snprintf(message + length, capacity - length, "%s %s\n", request->name, version);
+    }
+
+    bool ok = sendAll(conn->fd, message, length);
+    free(message);
+
+    for (int i = 0; ok && i < sentCount; i++) {
+        char header[64];
+        size_t size;
+
+        if (!fgets(header, sizeof(header), conn->in)) {
+            ok = false;
+        } else if (sscanf(header, "ok %zu", &size) == 1) {
+            ok = readExact(conn->in, size, &texts[sent[i]]);
+        } else {
+            ok = strcmp(header, "missing\n") == 0;
+        }
+    }
+    return ok;
+}
+
+// texts[i]에 requests[i]의 항목을 채움 (없는 패키지는 빈 버퍼). 도우미를 쓸 수 없으면 false
+bool helperShow(HelperConnection *conn, const DetailRequest *requests, int count, TextBuffer *texts) {
+    bool ok = true;
+
+    if (!conn) conn = &sharedConnection;
+    pthread_mutex_lock(&conn->lock);
+    if (!conn->in && (conn->failed || !tracedSpawn(conn))) {
+        conn->failed = true;
+        pthread_mutex_unlock(&conn->lock);
+        return false;
+    }
+
+    for (int start = 0; ok && start < count; start += HELPER_BATCH_MAX) {
+        int batch = count - start < HELPER_BATCH_MAX ? count - start : HELPER_BATCH_MAX;
+        uint64_t traceStart = traceBegin();
+        ok = exchange(conn, requests + start, batch, texts + start);
+        traceEnd("helper batch", traceStart);
+    }
+
+    if (!ok) {
+        helperClose(conn);
+        conn->failed = true;
+    }
+    pthread_mutex_unlock(&conn->lock);
+    return ok;
+}
+
+bool helperAvailable(const HelperConnection *conn) {
+    if (!conn) conn = &sharedConnection;
+    return config.helperPath && !conn->failed;
+}
+
+// 연결을 닫으면 도우미는 입력 끝을 보고 종료
+void helperStop(HelperConnection *conn) {
+    if (!conn) conn = &sharedConnection;
+    pthread_mutex_lock(&conn->lock);
+    helperClose(conn);
+    pthread_mutex_unlock(&conn->lock);
+}
+
+// ---- 도우미 프로세스 쪽 ----
+
+// 셸 없이 명령을 실행하고 표준 출력을 모두 읽음
+static bool runCommand(char *const argv[], TextBuffer *output) {
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) < 0) return false;
+
+    pid_t pid = fork();
+    if (pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return false;
+    }
+    if (pid == 0) {
+        dup2(fds[1], STDOUT_FILENO);
+        execvp(argv[0], argv);
+        _exit(127);
+    }
+
+    close(fds[1]);
+    FILE *fp = fdopen(fds[0], "r");
+    bool ok = fp && textReadStream(output, fp);
+    if (fp) fclose(fp);
+    else close(fds[0]);
+
+    // 일부 패키지가 없으면 apt-cache는 100으로 끝나지만 찾은 항목은 출력함
+    while (waitpid(pid, NULL, 0) < 0 && errno == EINTR) {}
+    return ok;
+}
+
+static const char *stanzaValue(const TextBuffer *text, int first, int last, const char *field) {
+    size_t fieldLen = strlen(field);
+
+    for (int i = first; i < last; i++) {
+        const char *line = textLine(text, i);
+        if (strncmp(line, field, fieldLen) == 0 && line[fieldLen] == ':' && line[fieldLen + 1] == ' ') {
+            return line + fieldLen + 2;
+        }
+    }
+    return "";
+}
+
+// apt-cache show 한 번으로 묶음을 처리하고 출력의 항목을 요청에 나눠 줌
+// withVersion이 false면 버전 없이 이름으로만 조회 (저장소에 없는 설치 버전 등)
+static void serveBatch(char names[][PACKAGE_NAME_SIZE], char versions[][PACKAGE_NAME_SIZE],
+                       int count, TextBuffer *texts, bool withVersion) {
+    char args[HELPER_BATCH_MAX][PACKAGE_NAME_SIZE * 2];
+    char *argv[HELPER_BATCH_MAX + 3] = { APT_CACHE_PATH, "show" };
+    int argc = 2;
+
+    for (int i = 0; i < count; i++) {
+        if (texts[i].lineCount > 0 || !names[i][0]) continue;
+        if (!withVersion && !versions[i][0]) continue;
+
+        if (withVersion && versions[i][0]) {
+            snprintf(args[i], sizeof(args[i]), "%.*s=%.*s", MAX_PACKAGE_NAME_LENGTH, names[i],
+                     MAX_PACKAGE_NAME_LENGTH, versions[i]);
+        } else {
+            snprintf(args[i], sizeof(args[i]), "%.*s", MAX_PACKAGE_NAME_LENGTH, names[i]);
+        }
+        argv[argc++] = args[i];
+    }
+    if (argc == 2) return;
+    argv[argc] = NULL;
+
+    TextBuffer output;
+    textInit(&output);
+    if (!runCommand(argv, &output)) {
+        textFree(&output);
+        return;
+    }
+
+    // 빈 줄로 나뉜 항목마다 Package/Version이 맞는 첫 요청에 배정
+    for (int first = 0; first < output.lineCount; ) {
+        int last = first;
+        while (last < output.lineCount && textLine(&output, last)[0]) last++;
+
+        if (last > first) {
+            const char *name = stanzaValue(&output, first, last, "Package");
+            const char *version = stanzaValue(&output, first, last, "Version");
+
+            for (int i = 0; i < count; i++) {
+                if (texts[i].lineCount > 0 || strcmp(names[i], name) != 0) continue;
+                if (withVersion && versions[i][0] && strcmp(versions[i], version) != 0) continue;
+
+                for (int line = first; line < last; line++) {
+                    const char *str = textLine(&output, line);
+                    textAppend(&texts[i], str, strlen(str));
+                    textAppend(&texts[i], "\n", 1);
+                }
+                textAppend(&texts[i], "\n", 1);
+                break;
+            }
+        }
+        first = last + 1;
+    }
+    textFree(&output);
+}
+
+int helperServe(FILE *in, FILE *out) {
+    static char names[HELPER_BATCH_MAX][PACKAGE_NAME_SIZE];
+    static char versions[HELPER_BATCH_MAX][PACKAGE_NAME_SIZE];
+    TextBuffer texts[HELPER_BATCH_MAX];
+    char line[BUFFER_SIZE];
+
+    while (fgets(line, sizeof(line), in)) {
+        int count;
+        if (sscanf(line, "batch %d", &count) != 1 || count < 0 || count > HELPER_BATCH_MAX) {
+            return EXIT_FAILURE;
+        }
+
+        for (int i = 0; i < count; i++) {
+            textInit(&texts[i]);
+            names[i][0] = versions[i][0] = '\0';
+            if (!fgets(line, sizeof(line), in)) return EXIT_FAILURE;
+
+            char *version = strchr(line, ' ');
+            line[strcspn(line, "\n")] = '\0';
+            if (version) *version++ = '\0';
+            // 요청 줄도 명령 인자로 쓰이므로 다시 검증
+            if (isValidPackageName(line)) {
+                snprintf(names[i], PACKAGE_NAME_SIZE, "%.*s", MAX_PACKAGE_NAME_LENGTH, line);
+            }
+            if (version && isValidVersion(version)) {
+                snprintf(versions[i], PACKAGE_NAME_SIZE, "%.*s", MAX_PACKAGE_NAME_LENGTH, version);
+            }
+        }
+
+        serveBatch(names, versions, count, texts, true);
+        serveBatch(names, versions, count, texts, false);
+
+        for (int i = 0; i < count; i++) {
+            if (texts[i].lineCount > 0) {
+                // 버퍼에는 줄 끝이 '\0'으로 바뀌어 있으므로 줄마다 다시 붙임 (길이는 같음)
+                fprintf(out, "ok %zu\n", texts[i].length);
+                for (int line = 0; line < texts[i].lineCount; line++) {
+                    fputs(textLine(&texts[i], line), out);
+                    fputc('\n', out);
+                }
+            } else {
+                fputs("missing\n", out);
+            }
+            textFree(&texts[i]);
+        }
+        fflush(out);
+    }
+    return EXIT_SUCCESS;
+}
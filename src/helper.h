@@ -0,0 +1,37 @@
+#ifndef HELPER_H
+#define HELPER_H
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <pthread.h>
+#include <sys/types.h>
+#include "pager.h"
+
+// 상세 정보 도우미 프로세스: 한 번 띄워 두고 소켓으로 요청을 묶어 보냄
+//
+// 요청:  "batch N\n" 다음에 N줄의 "이름 버전\n" (버전을 모르면 "-")
+// 응답:  요청 순서대로 N개의 "ok 길이\n" + 길이 바이트의 항목, 또는 "missing\n"
+//
+// 기본 도우미는 이 프로그램 자신(--helper)이며, 한 묶음을 apt-cache show 한 번으로 처리함
+typedef struct {
+    const char *name;
+    const char *version;    // NULL이면 후보 버전
+} DetailRequest;
+
+// 도우미 연결 하나 (도우미 프로세스 하나). 처음 요청할 때 실행
+typedef struct HelperConnection {
+    pthread_mutex_t lock;   // 여러 스레드가 같은 연결을 쓰면 한 묶음 단위로 잠금
+    pid_t pid;
+    int fd;
+    FILE *in;
+    bool failed;            // 실행 또는 통신에 실패하면 더 이상 쓰지 않고 popen으로 대체
+} HelperConnection;
+
+// conn이 NULL이면 상세 정보 화면과 미리 가져오기가 함께 쓰는 기본 연결
+void helperInit(HelperConnection *conn);
+bool helperShow(HelperConnection *conn, const DetailRequest *requests, int count, TextBuffer *texts);
+bool helperAvailable(const HelperConnection *conn);
+void helperStop(HelperConnection *conn);
+int helperServe(FILE *in, FILE *out);
+
+#endif // HELPER_H
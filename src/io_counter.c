@@ -0,0 +1,33 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include "io_counter.h"
+
+static int ioFd = -1;
+
+// 스레드별 커널 쓰기 통계. 프리페치·상세 풀 스레드의 쓰기는 다른 task에 쌓이므로 섞이지 않음
+// (ncurses는 FILE*를 거치지 않고 출력 fd에 write하므로 스트림을 감싸서는 셀 수 없음)
+size_t threadBytesWritten(void) {
+    char buffer[512];
+
+    if (ioFd < 0) {
+        ioFd = open("/proc/thread-self/io", O_RDONLY | O_CLOEXEC);
+        if (ioFd < 0) return 0;
+    }
+
+    ssize_t n = pread(ioFd, buffer, sizeof(buffer) - 1, 0);
+    if (n <= 0) return 0;
+    buffer[n] = '\0';
+
+    const char *wchar = strstr(buffer, "wchar:");
+    return wchar ? (size_t)strtoull(wchar + 6, NULL, 10) : 0;
+}
+
+void closeIoCounter(void) {
+    if (ioFd >= 0) {
+        close(ioFd);
+        ioFd = -1;
+    }
+}
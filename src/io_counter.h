@@ -0,0 +1,11 @@
+#ifndef IO_COUNTER_H
+#define IO_COUNTER_H
+
+#include <stddef.h>
+
+// 호출한 스레드가 write 계열 호출로 내보낸 누적 바이트 (/proc/thread-self/io 의 wchar)
+// 처음 호출한 스레드에 고정되므로 화면을 그리는 메인 스레드에서만 호출
+size_t threadBytesWritten(void);
+void closeIoCounter(void);
+
+#endif // IO_COUNTER_H
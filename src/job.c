@@ -0,0 +1,307 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <unistd.h>
+#include <pty.h>
+#include <sys/wait.h>
+#include "job.h"
+#include "utils.h"
+
+static Job job = { .state = JOB_IDLE, .fd = -1, .pid = -1 };
+
+static void freeSteps(void) {
+    for (int i = 0; i < job.stepCount; i++) {
+        for (char **arg = job.steps[i]; arg && *arg; arg++) free(*arg);
+        free(job.steps[i]);
+        job.steps[i] = NULL;
+    }
+    job.stepCount = 0;
+}
+
+static char **copyArgv(char *const *argv) {
+    int count = 0;
+    while (argv[count]) count++;
+
+    char **copy = (char **)calloc(count + 1, sizeof(char *));
+    if (!copy) return NULL;
+
+    for (int i = 0; i < count; i++) {
+        copy[i] = strdup(argv[i]);
+        if (!copy[i]) {
+            for (int j = 0; j < i; j++) free(copy[j]);
+            free(copy);
+            return NULL;
+        }
+    }
+    return copy;
+}
+
+// 출력 줄 링 버퍼
+static char *currentLine(void) {
+    return job.lines[(job.lineHead + job.lineCount - 1) % JOB_OUTPUT_LINES];
+}
+
+static void newLine(void) {
+    if (job.lineCount < JOB_OUTPUT_LINES) {
+        job.lineCount++;
+    } else {
+        job.lineHead = (job.lineHead + 1) % JOB_OUTPUT_LINES;
+    }
+    memset(currentLine(), 0, JOB_LINE_SIZE);
+    job.column = 0;
+}
+
+static void putChar(char c) {
+    if (job.lineCount == 0) newLine();
+
+    // "\r" 뒤에 바로 글자가 오면 진행률 표시처럼 같은 줄을 다시 쓰는 경우
+    if (job.pendingReturn) {
+        memset(currentLine(), 0, JOB_LINE_SIZE);
+        job.column = 0;
+        job.pendingReturn = false;
+    }
+
+    if (job.column < JOB_LINE_SIZE - 1) {
+        currentLine()[job.column++] = c;
+    }
+}
+
+// 터미널 출력을 줄 단위 텍스트로 변환 (제어 시퀀스는 버림)
+static void feedOutput(const char *data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        unsigned char c = (unsigned char)data[i];
+
+        switch (job.escapeState) {
+            case 1:  // ESC 다음 글자
+                job.escapeState = c == '[' ? 2 : c == ']' ? 3 : 0;
+                continue;
+            case 2:  // CSI: 최종 바이트까지 건너뜀
+                if (c >= 0x40 && c <= 0x7e) job.escapeState = 0;
+                continue;
+            case 3:  // OSC: BEL 또는 ESC \ 까지 건너뜀
+                if (c == '\a') job.escapeState = 0;
+                else if (c == 0x1b) job.escapeState = 1;
+                continue;
+            default:
+                break;
+        }
+
+        if (c == 0x1b) {
+            job.escapeState = 1;
+        } else if (c == '\r') {
+            job.pendingReturn = true;
+        } else if (c == '\n') {
+            job.pendingReturn = false;
+            if (job.lineCount == 0) newLine();
+            newLine();
+        } else if (c == '\b') {
+            if (job.column > 0) job.column--;
+        } else if (c == '\t') {
+            do putChar(' '); while (job.column % 8 && job.column < JOB_LINE_SIZE - 1);
+        } else if (c >= 0x20 && c != 0x7f) {
+            putChar((char)c);
+        }
+    }
+}
+
+static void appendText(const char *text) {
+    feedOutput(text, strlen(text));
+}
+
+static bool spawnStep(int step) {
+    struct winsize size = {
+        .ws_row = JOB_PANE_ROWS,
+        .ws_col = COLS > 0 ? COLS : 80,
+    };
+    int fd;
+
+    pid_t pid = forkpty(&fd, NULL, NULL, &size);
+    if (pid < 0) {
+        char message[BUFFER_SIZE];
+        snprintf(message, sizeof(message), "Failed to start %s: %s\n", job.steps[step][0], strerror(errno));
+        appendText(message);
+        return false;
+    }
+
+    if (pid == 0) {
+        // 진행 막대 등 화면 제어 출력을 줄이기 위해 단순 터미널로 알림
+        setenv("TERM", "dumb", 1);
+        execvp(job.steps[step][0], job.steps[step]);
+        fprintf(stderr, "Failed to execute %s: %s\n", job.steps[step][0], strerror(errno));
+        _exit(127);
+    }
+
+    fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    fcntl(fd, F_SETFD, FD_CLOEXEC);
+
+    job.pid = pid;
+    job.fd = fd;
+    job.currentStep = step;
+    job.version++;
+    return true;
+}
+
+bool jobStart(const char *title, char *const *steps[], int stepCount) {
+    if (job.state == JOB_RUNNING || stepCount <= 0 || stepCount > JOB_MAX_STEPS) return false;
+
+    freeSteps();
+    if (!job.lines) {
+        job.lines = calloc(JOB_OUTPUT_LINES, JOB_LINE_SIZE);
+        if (!job.lines) return false;
+    }
+
+    for (int i = 0; i < stepCount; i++) {
+        job.steps[i] = copyArgv(steps[i]);
+        if (!job.steps[i]) {
+            freeSteps();
+            return false;
+        }
+        job.stepCount++;
+    }
+
+    snprintf(job.title, sizeof(job.title), "%s", title);
+    job.lineHead = job.lineCount = job.column = 0;
+    job.pendingReturn = false;
+    job.escapeState = 0;
+    job.cancelRequested = false;
+    job.inputFocus = false;
+    job.hidden = false;
+    job.exitStatus = 0;
+
+    if (!spawnStep(0)) {
+        job.state = JOB_FAILED;
+        job.version++;
+        return false;
+    }
+    job.state = JOB_RUNNING;
+    return true;
+}
+
+// 현재 단계 종료 처리. 성공했고 다음 단계가 있으면 이어서 실행
+static void finishStep(int status) {
+    char buffer[BUFFER_SIZE];
+    ssize_t n;
+
+    // 종료 직전에 쓴 출력이 남아 있을 수 있음
+    while ((n = read(job.fd, buffer, sizeof(buffer))) > 0) {
+        feedOutput(buffer, (size_t)n);
+    }
+    close(job.fd);
+    job.fd = -1;
+    job.pid = -1;
+    job.exitStatus = WIFEXITED(status) ? WEXITSTATUS(status) : 128 + WTERMSIG(status);
+    job.version++;
+
+    if (job.cancelRequested) {
+        job.state = JOB_CANCELLED;
+    } else if (job.exitStatus != 0) {
+        job.state = JOB_FAILED;
+    } else if (job.currentStep + 1 < job.stepCount) {
+        if (!spawnStep(job.currentStep + 1)) job.state = JOB_FAILED;
+        return;
+    } else {
+        job.state = JOB_SUCCEEDED;
+    }
+    job.inputFocus = false;
+}
+
+// 읽을 수 있는 출력을 모두 가져옴. 화면을 다시 그려야 하면 true
+bool jobPump(void) {
+    if (job.fd < 0) return false;
+
+    unsigned before = job.version;
+    char buffer[BUFFER_SIZE * 4];
+    bool closed = false;
+
+    // 출력이 끊이지 않아도 키 입력을 처리할 수 있도록 한 번에 읽는 양을 제한
+    for (int reads = 0; reads < 16; reads++) {
+        ssize_t n = read(job.fd, buffer, sizeof(buffer));
+        if (n > 0) {
+            feedOutput(buffer, (size_t)n);
+            job.version++;
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        // 자식 쪽 터미널이 모두 닫히면 EIO
+        closed = n == 0 || errno != EAGAIN;
+        break;
+    }
+
+    int status;
+    if (closed) {
+        while (waitpid(job.pid, &status, 0) < 0 && errno == EINTR) {}
+        finishStep(status);
+    } else if (waitpid(job.pid, &status, WNOHANG) == job.pid) {
+        // 자손 프로세스가 터미널을 잡고 있어도 직접 실행한 명령이 끝나면 종료로 봄
+        finishStep(status);
+    }
+    return job.version != before;
+}
+
+const Job *jobCurrent(void) {
+    return job.state == JOB_IDLE ? NULL : &job;
+}
+
+bool jobRunning(void) {
+    return job.state == JOB_RUNNING;
+}
+
+bool jobPaneVisible(void) {
+    return job.state != JOB_IDLE && !job.hidden;
+}
+
+int jobPollFd(void) {
+    return job.fd;
+}
+
+// 처음에는 터미널의 Ctrl-C처럼 인터럽트 문자를 보내고, 다시 요청하면 SIGTERM
+void jobCancel(void) {
+    if (job.state != JOB_RUNNING) return;
+
+    if (!job.cancelRequested) {
+        job.cancelRequested = true;
+        if (write(job.fd, "\x03", 1) == 1) return;
+    }
+    kill(-job.pid, SIGTERM);
+    job.version++;
+}
+
+void jobToggleHidden(void) {
+    if (job.state == JOB_IDLE) return;
+    job.hidden = !job.hidden;
+    if (job.hidden) job.inputFocus = false;
+    job.version++;
+}
+
+void jobSetInputFocus(bool focus) {
+    job.inputFocus = focus && job.state == JOB_RUNNING;
+    if (job.inputFocus) job.hidden = false;
+    job.version++;
+}
+
+bool jobSendInput(const char *data, size_t length) {
+    if (job.state != JOB_RUNNING || job.fd < 0) return false;
+    return write(job.fd, data, length) == (ssize_t)length;
+}
+
+const char *jobLine(int index) {
+    if (index < 0 || index >= job.lineCount) return "";
+    return job.lines[(job.lineHead + index) % JOB_OUTPUT_LINES];
+}
+
+// 프로그램 종료 시 실행 중인 작업을 끝내고 자원 해제
+void jobShutdown(void) {
+    if (job.state == JOB_RUNNING && job.pid > 0) {
+        kill(-job.pid, SIGTERM);
+        while (waitpid(job.pid, NULL, 0) < 0 && errno == EINTR) {}
+    }
+    if (job.fd >= 0) close(job.fd);
+    freeSteps();
+    free(job.lines);
+    memset(&job, 0, sizeof(job));
+    job.fd = -1;
+    job.pid = -1;
+}
@@ -0,0 +1,53 @@
+#ifndef JOB_H
+#define JOB_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <sys/types.h>
+#include "constants.h"
+
+typedef enum JobState {
+    JOB_IDLE,
+    JOB_RUNNING,
+    JOB_SUCCEEDED,
+    JOB_FAILED,
+    JOB_CANCELLED,
+} JobState;
+
+// 백그라운드로 실행하는 명령 (apt-get 등). 의사 터미널로 출력과 입력을 중계
+typedef struct Job {
+    JobState state;
+    char title[JOB_TITLE_SIZE];
+    char **steps[JOB_MAX_STEPS];   // 차례로 실행할 argv 목록 (앞 단계가 성공해야 다음 실행)
+    int stepCount;
+    int currentStep;
+    pid_t pid;
+    int fd;                        // 의사 터미널 master (-1이면 없음)
+    int exitStatus;
+    bool cancelRequested;
+    bool inputFocus;               // 키 입력을 작업으로 전달하는 중
+    bool hidden;                   // 출력 창 숨김
+    char (*lines)[JOB_LINE_SIZE];  // 출력 줄 링 버퍼
+    int lineHead;                  // 가장 오래된 줄 위치
+    int lineCount;
+    int column;                    // 현재 줄에 쓸 위치
+    bool pendingReturn;            // '\r' 직후 (다음이 '\n'이 아니면 줄을 덮어씀)
+    int escapeState;
+    unsigned version;              // 출력이나 상태가 바뀔 때마다 증가
+} Job;
+
+// argv 배열을 복제해 단계로 등록 (마지막 원소는 NULL)
+bool jobStart(const char *title, char *const *steps[], int stepCount);
+const Job *jobCurrent(void);
+bool jobRunning(void);
+bool jobPaneVisible(void);
+int jobPollFd(void);
+bool jobPump(void);
+void jobCancel(void);
+void jobToggleHidden(void);
+void jobSetInputFocus(bool focus);
+bool jobSendInput(const char *data, size_t length);
+const char *jobLine(int index);
+void jobShutdown(void);
+
+#endif // JOB_H
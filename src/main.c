@@ -2,12 +2,36 @@
 #include "utils.h"
 #include "package_manager.h"
 #include "constants.h"
+#include "config.h"
+#include "job.h"
+#include "watcher.h"
+#include "detail_cache.h"
+#include "prefetch.h"
+#include "helper.h"
+#include "trace.h"
+#include "cli.h"
+#include <stdio.h>
 #include <string.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <locale.h>
 
 int main(int argc, char *argv[]) {
     bool autoUpdate = false;
+    bool showStats = false;
+    const char *tracePath = NULL;
+    CliCommand command = CLI_NONE;
+    CliFormat format = CLI_TSV;
+    char **commandArgs = NULL;
+    int commandArgCount = 0;
+
+    // 상세 정보 도우미로 실행된 경우: 화면 없이 표준 입출력으로 요청 처리
+    if (argc > 1 && strcmp(argv[1], "--helper") == 0) {
+        return helperServe(stdin, stdout);
+    }
+
+    // UTF-8 설명·이름의 표시 폭 계산과 ncursesw 출력에 필요
+    setlocale(LC_ALL, "");
 
     // 명령행 인자 파싱
     for (int i = 1; i < argc; i++) {
@@ -16,13 +40,100 @@ int main(int argc, char *argv[]) {
             return EXIT_SUCCESS;
         } else if (strcmp(argv[i], "--auto-update") == 0 || strcmp(argv[i], "-U") == 0) {
             autoUpdate = true;
+        } else if (strcmp(argv[i], "--status-file") == 0 && i + 1 < argc) {
+            config.statusPath = argv[++i];
+        } else if (strcmp(argv[i], "--lists-dir") == 0 && i + 1 < argc) {
+            config.listsDir = argv[++i];
+        } else if (strcmp(argv[i], "--extended-states") == 0 && i + 1 < argc) {
+            config.extendedStatesPath = argv[++i];
+        } else if (strcmp(argv[i], "--preferences") == 0 && i + 1 < argc) {
+            config.preferencesPath = argv[++i];
+        } else if (strcmp(argv[i], "--arch") == 0 && i + 1 < argc) {
+            config.architecture = argv[++i];
+        } else if (strcmp(argv[i], "--dpkg-query") == 0) {
+            config.forceDpkgQuery = true;
+        } else if (strcmp(argv[i], "--no-cache") == 0) {
+            config.useCache = false;
+        } else if (strcmp(argv[i], "--apt-get") == 0 && i + 1 < argc) {
+            config.aptGetPath = argv[++i];
+        } else if (strcmp(argv[i], "--no-sudo") == 0) {
+            config.sudoPath = NULL;
+        } else if (strcmp(argv[i], "--detail-cache") == 0 && i + 1 < argc) {
+            config.detailCacheBytes = strtoul(argv[++i], NULL, 10) * 1024 * 1024;
+        } else if (strcmp(argv[i], "--helper-path") == 0 && i + 1 < argc) {
+            config.helperPath = argv[++i];
+        } else if (strcmp(argv[i], "--no-helper") == 0) {
+            config.helperPath = NULL;
+        } else if (strcmp(argv[i], "--prefetch") == 0 && i + 1 < argc) {
+            config.prefetchWindow = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--jobs") == 0 && i + 1 < argc) {
+            config.searchJobs = atoi(argv[++i]);
+            if (config.searchJobs < 1) config.searchJobs = 1;
+            if (config.searchJobs > SEARCH_JOBS_MAX) config.searchJobs = SEARCH_JOBS_MAX;
+        } else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc) {
+            tracePath = argv[++i];
+        } else if (strcmp(argv[i], "--frame-stats") == 0) {
+            config.showFrameStats = true;
+        } else if (strcmp(argv[i], "--stats") == 0) {
+            showStats = true;
+        } else if (strcmp(argv[i], "--list") == 0) {
+            command = CLI_LIST;
+        } else if (strcmp(argv[i], "--search") == 0 && i + 1 < argc) {
+            command = CLI_SEARCH;
+            commandArgs = &argv[++i];
+            commandArgCount = 1;
+        } else if (strcmp(argv[i], "--show") == 0 || strcmp(argv[i], "--install") == 0) {
+            // 다음 옵션(--로 시작하는 인자) 전까지가 패키지 이름
+            command = strcmp(argv[i], "--show") == 0 ? CLI_SHOW : CLI_INSTALL;
+            commandArgs = &argv[i + 1];
+            commandArgCount = 0;
+            while (i + 1 < argc && strncmp(argv[i + 1], "--", 2) != 0) {
+                i++;
+                commandArgCount++;
+            }
+        } else if (strcmp(argv[i], "--format") == 0 && i + 1 < argc) {
+            if (!cliParseFormat(argv[++i], &format)) {
+                fprintf(stderr, "Unknown output format %s (use tsv or json)\n", argv[i]);
+                return CLI_EXIT_USAGE;
+            }
         }
     }
     
-    int packageCount, currIndex = 0, startIndex = 0, prevCh = 0, exitFlag = 0;
-    Package *packages = NULL;
+    if (tracePath && !traceOpen(tracePath)) {
+        fprintf(stderr, "Cannot write trace file %s\n", tracePath);
+        return EXIT_FAILURE;
+    }
+
+    // 비대화형 명령: 화면 없이 결과만 출력하고 종료 코드로 성공 여부를 알림
+    if (command != CLI_NONE) {
+        int status = cliRun(command, format, commandArgs, commandArgCount);
+        freeSearchIndex();
+        traceClose();
+        return status;
+    }
+
+    int packageCount;
+    PackageStore store;
+    PackageList list;
+    storeInit(&store);
+
+    // 통계 출력 모드: ncurses 없이 적재 결과만 보고
+    if (showStats) {
+        packageCount = loadPackages(&store);
+        printStats(&store);
+        printSearchStats();
+        printDependencyStats();
+        storeFree(&store);
+        freeSearchIndex();
+        freeDependencyGraph();
+        traceClose();
+        return packageCount > 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+    }
 
     init();
+    detailCacheInit(config.detailCacheBytes);
+    // 캐시가 꺼져 있으면 미리 가져온 결과를 둘 곳이 없음
+    if (config.detailCacheBytes > 0) prefetchStart(config.prefetchWindow);
     
     // 선택적 자동 시스템 업데이트 (사용자가 명령행 옵션으로 요청한 경우)
     if (autoUpdate) {
@@ -30,24 +141,32 @@ int main(int argc, char *argv[]) {
     }
     // 기본 동작: 시작 시 업데이트 수행 안 함. 'u' 키로 명시적 실행.
     
-    packageCount = loadPackages(&packages);
+    packageCount = loadPackages(&store);
     if (packageCount <= 0) {
-        deinit(packages, packageCount);
+        deinit(&store);
         fprintf(stderr, "Failed to load packages\n");
         return EXIT_FAILURE;
     }
 
-    while (!exitFlag) {
-        if (currIndex < startIndex) {
-            startIndex = currIndex;
-        } else if (currIndex >= startIndex + ROWS - 3) {
-            startIndex = currIndex - (ROWS - 3) + 1;
+    listInit(&list, &store);
+    // 설치·삭제 후 dpkg status가 바뀌면 목록을 제자리에서 갱신
+    watcherStart(config.statusPath);
+
+    while (!list.exitFlag) {
+        listSync(&list);
+        listScrollToCursor(&list, listVisibleRows());
+        displayPackages(&list);
+        keyInput(&list);
+
+        // 실행 중인 apt-get을 중간에 끊지 않도록 작업이 끝나야 종료
+        if (list.exitFlag && jobRunning()) {
+            list.exitFlag = 0;
+            if (!jobPaneVisible()) jobToggleHidden();
         }
-        displayPackages(packages, packageCount, startIndex, currIndex);
-        keyInput(&currIndex, &startIndex, &prevCh, &exitFlag, packageCount, packages);
     }
 
-    deinit(packages, packageCount);
+    listFree(&list);
+    deinit(&store);
     return EXIT_SUCCESS;
 }
 
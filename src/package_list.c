@@ -0,0 +1,193 @@
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <stdio.h>
+#include "package_list.h"
+#include "filter.h"
+
+bool listInit(PackageList *list, PackageStore *store) {
+    memset(list, 0, sizeof(*list));
+    list->store = store;
+    list->generation = store->generation;
+    return listReset(list);
+}
+
+void listFree(PackageList *list) {
+    free(list->view);
+    free(list->scratch);
+    list->view = list->scratch = NULL;
+    list->viewCount = 0;
+}
+
+// 저장소 크기에 맞춰 버퍼를 다시 잡고 현재 필터를 처음부터 적용
+bool listReset(PackageList *list) {
+    int capacity = list->store->count > 0 ? list->store->count : 1;
+    int *view = (int *)realloc(list->view, capacity * sizeof(int));
+    int *scratch = (int *)realloc(list->scratch, capacity * sizeof(int));
+
+    if (view) list->view = view;
+    if (scratch) list->scratch = scratch;
+    if (!view || !scratch) {
+        list->viewCount = 0;
+        return false;
+    }
+
+    if (list->filterLength > 0) {
+        list->viewCount = filterPackages(list->store, NULL, list->store->count, list->filter, list->view);
+    } else {
+        for (int i = 0; i < list->store->count; i++) list->view[i] = i;
+        list->viewCount = list->store->count;
+    }
+
+    if (list->currIndex >= list->viewCount) list->currIndex = list->viewCount > 0 ? list->viewCount - 1 : 0;
+    list->version++;
+    return true;
+}
+
+// 새 필터가 이전 필터를 포함하면 이전 결과만 다시 걸러냄 (입력을 늘릴 때마다 후보가 줄어듦)
+void listSetFilter(PackageList *list, const char *filter) {
+    size_t length = strlen(filter);
+    if (length >= sizeof(list->filter)) length = sizeof(list->filter) - 1;
+
+    bool refine = list->filterLength > 0
+               && (size_t)list->filterLength <= length
+               && strncasecmp(filter, list->filter, list->filterLength) == 0;
+    int current = list->viewCount > 0 ? list->view[list->currIndex] : -1;
+
+    memcpy(list->filter, filter, length);
+    list->filter[length] = '\0';
+    list->filterLength = (int)length;
+
+    if (!refine) {
+        listReset(list);
+    } else {
+        list->viewCount = filterPackages(list->store, list->view, list->viewCount, list->filter, list->scratch);
+        int *swap = list->view;
+        list->view = list->scratch;
+        list->scratch = swap;
+        list->version++;
+    }
+
+    // 이전에 선택했던 패키지가 결과에 남아 있으면 커서 유지
+    list->currIndex = 0;
+    for (int i = 0; i < list->viewCount; i++) {
+        if (list->view[i] == current) {
+            list->currIndex = i;
+            break;
+        }
+    }
+    list->startIndex = 0;
+}
+
+Package *listAt(const PackageList *list, int index) {
+    if (index < 0 || index >= list->viewCount) return NULL;
+    return &list->store->items[list->view[index]];
+}
+
+Package *listCurrent(const PackageList *list) {
+    return listAt(list, list->currIndex);
+}
+
+// 커서가 화면 안에 들어오도록 시작 위치 조정
+void listScrollToCursor(PackageList *list, int visibleRows) {
+    if (list->currIndex < list->startIndex) {
+        list->startIndex = list->currIndex;
+    } else if (list->currIndex >= list->startIndex + visibleRows) {
+        list->startIndex = list->currIndex - visibleRows + 1;
+    }
+}
+
+// 현재 패키지에 설치/삭제 표시. 이미 같은 표시가 있으면 해제
+void listToggleMark(PackageList *list, unsigned int mark) {
+    Package *package = listCurrent(list);
+    if (!package) return;
+
+    unsigned int previous = package->flags & PKG_MARKS;
+    if (previous == PKG_MARK_INSTALL) list->installMarks--;
+    if (previous == PKG_MARK_REMOVE) list->removeMarks--;
+    package->flags &= ~PKG_MARKS;
+
+    // 설치되지 않은 패키지는 삭제 표시할 수 없음
+    if (previous == mark || (mark == PKG_MARK_REMOVE && !(package->flags & PKG_INSTALLED))) return;
+
+    package->flags |= mark;
+    if (mark == PKG_MARK_INSTALL) list->installMarks++;
+    else list->removeMarks++;
+}
+
+void listClearMarks(PackageList *list) {
+    for (int i = 0; i < list->store->count; i++) {
+        list->store->items[i].flags &= ~PKG_MARKS;
+    }
+    list->installMarks = list->removeMarks = 0;
+}
+
+// 보기에서 이름이 name 이상인 첫 위치 (정렬되지 않은 저장소는 같은 이름만 찾음)
+static int viewLowerBound(const PackageList *list, const char *name) {
+    const Package *items = list->store->items;
+
+    if (!list->store->sorted) {
+        for (int i = 0; i < list->viewCount; i++) {
+            if (strcmp(items[list->view[i]].name, name) == 0) return i;
+        }
+        return list->currIndex;
+    }
+
+    int lo = 0, hi = list->viewCount;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (strcmp(items[list->view[mid]].name, name) < 0) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// 저장소가 제자리에서 갱신되었으면 보기를 다시 만들고 커서를 같은 패키지(없어졌으면 그 다음)에 둠
+void listSync(PackageList *list) {
+    if (list->generation != list->store->generation) {
+        int row = list->currIndex - list->startIndex;
+
+        listReset(list);
+        if (list->cursorName[0] != '\0' && list->viewCount > 0) {
+            int index = viewLowerBound(list, list->cursorName);
+            list->currIndex = index < list->viewCount ? index : list->viewCount - 1;
+        }
+        // 커서가 화면의 같은 줄에 머물도록 시작 위치도 맞춤
+        list->startIndex = list->currIndex - row > 0 ? list->currIndex - row : 0;
+
+        // 삭제된 패키지의 표시는 함께 사라지므로 다시 셈
+        list->installMarks = list->removeMarks = 0;
+        for (int i = 0; i < list->store->count; i++) {
+            unsigned int marks = list->store->items[i].flags & PKG_MARKS;
+            if (marks == PKG_MARK_INSTALL) list->installMarks++;
+            if (marks == PKG_MARK_REMOVE) list->removeMarks++;
+        }
+        list->generation = list->store->generation;
+    }
+
+    const Package *current = listCurrent(list);
+    snprintf(list->cursorName, sizeof(list->cursorName), "%s", current ? current->name : "");
+}
+
+// 이름이 정확히 같은 패키지로 커서 이동. 필터에 가려져 있으면 필터를 해제
+bool listJumpTo(PackageList *list, const char *name) {
+    int slot = storeLookup(list->store, name, strlen(name));
+    if (slot < 0) return false;
+
+    // view는 저장소 번호 오름차순이므로 이진 탐색
+    int lo = 0, hi = list->viewCount - 1;
+    while (lo <= hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (list->view[mid] == slot) {
+            list->currIndex = mid;
+            return true;
+        }
+        if (list->view[mid] < slot) lo = mid + 1;
+        else hi = mid - 1;
+    }
+
+    listSetFilter(list, "");
+    list->filtering = false;
+    list->currIndex = slot < list->viewCount ? slot : 0;
+    return true;
+}
@@ -0,0 +1,40 @@
+#ifndef PACKAGE_LIST_H
+#define PACKAGE_LIST_H
+
+#include <stdbool.h>
+#include "package_store.h"
+#include "constants.h"
+
+// 화면에 표시되는 패키지 목록 상태 (필터 결과와 커서 위치)
+typedef struct PackageList {
+    PackageStore *store;
+    int *view;                 // 보이는 항목의 store 번호
+    int viewCount;
+    unsigned version;          // view 내용이 바뀔 때마다 증가
+    int *scratch;              // 필터 계산용 보조 버퍼
+    char filter[FILTER_QUERY_SIZE];
+    int filterLength;
+    bool filtering;            // 필터 입력 중
+    int installMarks;          // 설치 표시한 패키지 수
+    int removeMarks;           // 삭제 표시한 패키지 수
+    unsigned generation;       // 마지막으로 맞춘 store->generation
+    char cursorName[PACKAGE_NAME_SIZE];  // 저장소가 갱신되어도 커서를 같은 패키지에 두기 위한 이름
+    int currIndex;
+    int startIndex;
+    int prevCh;
+    int exitFlag;
+} PackageList;
+
+bool listInit(PackageList *list, PackageStore *store);
+void listFree(PackageList *list);
+bool listReset(PackageList *list);
+void listSetFilter(PackageList *list, const char *filter);
+Package *listCurrent(const PackageList *list);
+Package *listAt(const PackageList *list, int index);
+void listScrollToCursor(PackageList *list, int visibleRows);
+void listSync(PackageList *list);
+bool listJumpTo(PackageList *list, const char *name);
+void listToggleMark(PackageList *list, unsigned int mark);
+void listClearMarks(PackageList *list);
+
+#endif // PACKAGE_LIST_H
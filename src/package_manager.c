@@ -2,28 +2,44 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/wait.h>
 #include <ncurses.h>
 #include "ui.h"
 #include "utils.h"
 #include "package_manager.h"
 #include "constants.h"
+#include "config.h"
+#include "stanza.h"
+#include "snapshot.h"
+#include "apt_index.h"
+#include "job.h"
+#include "detail_cache.h"
+#include "prefetch.h"
+#include "helper.h"
+#include "detail_pool.h"
+#include "trace.h"
 
-// 패키지 메모리 해제 함수
-void freePackages(Package *p, int count) {
-    if (!p) return;
-    
-    for (int i = 0; i < count; i++) {
-        safeFree(&p[i].name);
-        safeFree(&p[i].version);
-        safeFree(&p[i].description);
-    }
-    free(p);
-}
+// 현재 설치 목록 (검색 결과의 설치 여부 표시에 사용)
+static PackageStore *installedStore = NULL;
+
+// apt 목록 인덱스 (첫 검색 시 한 번만 적재)
+static AptIndex aptIndex;
+static AptPolicy aptPolicy;
+static bool aptIndexLoaded = false;
+
+// 설치된 패키지의 의존 관계 그래프 (삭제 전 영향 표시·설치 이유에 처음 필요할 때 구성)
+static DepGraph dependencyGraph;
+static bool dependencyGraphLoaded = false;
 
 // dpkg 쿼리 실행 및 패키지 카운트
 static int countPackages(void) {
     char buffer[BUFFER_SIZE];
     int packageCount = 0;
+    uint64_t start = traceBegin();
 
     FILE *fp = popen("dpkg-query -W -f='${Package}\t${Version}\t${binary:Summary}\n'", "r");
     if (!fp) {
@@ -35,101 +51,379 @@ static int countPackages(void) {
         packageCount++;
     }
     pclose(fp);
+    traceEnd("popen dpkg-query", start);
     
     return packageCount;
 }
 
-// 패키지 정보 파싱
-static bool parsePackageLine(char *buffer, Package *package) {
+// dpkg-query 한 줄 ("이름\t버전\t요약")을 필드로 나눔
+static bool splitPackageLine(char *buffer, PackageFields *fields) {
     char *name = strtok(buffer, "\t");
     char *version = strtok(NULL, "\t");
     char *description = strtok(NULL, "\n");
 
     if (!name) return false;
 
-    package->name = safeStrdup(name ? name : "(Unknown)");
-    package->version = safeStrdup(version ? version : "(Unknown)");
-    package->description = safeStrdup(description ? description : "(No description)");
-    
+    *fields = (PackageFields){
+        name, strlen(name),
+        version, version ? strlen(version) : 0,
+        description, description ? strlen(description) : 0,
+        NULL, 0, NULL, 0, APT_PRIORITY_INSTALLED,
+    };
+    return true;
+}
+
+// 패키지 정보 파싱
+static bool parsePackageLine(char *buffer, PackageStore *store) {
+    PackageFields fields;
+    if (!splitPackageLine(buffer, &fields)) return false;
+
+    return storeAdd(store, fields.name, fields.nameLen, fields.version, fields.versionLen,
+                    fields.description, fields.descLen) != NULL;
+}
+
+// 설치 목록에 표시할 상태인지 확인 (dpkg-query -W와 동일하게 not-installed 제외)
+static bool isListedStatus(const char *status, size_t length) {
+    static const char notInstalled[] = "not-installed";
+    size_t suffixLen = sizeof(notInstalled) - 1;
+
+    if (!status) return true;
+    while (length > 0 && (status[length - 1] == ' ' || status[length - 1] == '\r')) length--;
+    return !(length >= suffixLen && memcmp(status + length - suffixLen, notInstalled, suffixLen) == 0);
+}
+
+// status 스탠자에서 목록에 쓰는 필드를 꺼냄. 목록에 표시하지 않는 항목이면 false
+static bool statusFields(const Stanza *stanza, PackageFields *fields) {
+    size_t statusLen;
+    const char *status = stanzaGet(stanza, "Status", &statusLen);
+
+    fields->name = stanzaGet(stanza, "Package", &fields->nameLen);
+    if (!fields->name || fields->nameLen == 0 || !isListedStatus(status, statusLen)) return false;
+
+    fields->version = stanzaGet(stanza, "Version", &fields->versionLen);
+    fields->description = stanzaGet(stanza, "Description", &fields->descLen);
+    fields->descLen = firstLineLength(fields->description, fields->descLen);
+    fields->details = NULL;
+    fields->detailsLen = 0;
+    fields->descriptionMd5 = NULL;
+    fields->descriptionMd5Len = 0;
+    fields->priority = APT_PRIORITY_INSTALLED;
     return true;
 }
 
-int loadPackages(Package **p) {
+// status 스탠자 하나를 Package로 변환
+static bool parseStatusStanza(const Stanza *stanza, PackageStore *store) {
+    PackageFields fields;
+    if (!statusFields(stanza, &fields)) return false;
+
+    return storeAdd(store, fields.name, fields.nameLen, fields.version, fields.versionLen,
+                    fields.description, fields.descLen) != NULL;
+}
+
+// dpkg status 파일을 mmap 하여 한 번의 순회로 저장소 구성
+static int loadPackagesFromStatus(PackageStore *store) {
+    MappedFile file;
+    if (!mapFile(config.statusPath, &file)) {
+        return -1;
+    }
+
+    StanzaReader reader;
+    Stanza stanza;
+    stanzaReaderInit(&reader, file.data, file.size);
+
+    // 스탠자마다 기록하면 수만 개가 되므로 파싱 전체를 한 구간으로 기록
+    uint64_t start = traceBegin();
+    while (stanzaNext(&reader, &stanza)) {
+        parseStatusStanza(&stanza, store);
+    }
+    traceEnd("parseStatusStanza", start);
+    unmapFile(&file);
+
+    return store->count > 0 ? store->count : -1;
+}
+
+// 대체 경로: dpkg-query 실행 결과 파싱
+static int loadPackagesFromDpkgQuery(PackageStore *store) {
     int packageCount = countPackages();
     if (packageCount <= 0) {
         fprintf(stderr, "No packages found or error occurred\n");
         return 0;
     }
 
+    uint64_t start = traceBegin();
     FILE *fp = popen("dpkg-query -W -f='${Package}\t${Version}\t${binary:Summary}\n'", "r");
     if (!fp) {
         fprintf(stderr, "Failed to re-run command\n");
         return 0;
     }
 
-    *p = (Package *)calloc(packageCount, sizeof(Package));
-    if (!*p) {
-        fprintf(stderr, "Failed to allocate memory\n");
-        pclose(fp);
-        return 0;
-    }
-
+    // 읽기와 파싱이 번갈아 일어나므로 줄마다가 아니라 출력 전체를 한 구간으로 기록
     char buffer[BUFFER_SIZE];
-    int index = 0;
-    while (fgets(buffer, sizeof(buffer), fp) && index < packageCount) {
-        if (parsePackageLine(buffer, &(*p)[index])) {
-            index++;
-        }
+    while (fgets(buffer, sizeof(buffer), fp) && store->count < packageCount) {
+        parsePackageLine(buffer, store);
     }
     pclose(fp);
+    traceEnd("popen dpkg-query + parsePackageLine", start);
     
-    return index;
+    return store->count;
 }
 
-// 명령어 실행 결과 표시
-static void displayCommandOutput(FILE *fp) {
-    char buffer[BUFFER_SIZE];
-    int row = 2;
-    
-    while (fgets(buffer, sizeof(buffer), fp)) {
-        if (row < ROWS - 1) {
-            mvprintw(row++, 0, "%s", buffer);
-        } else {
-            mvprintw(ROWS - 1, 0, "Output exceeds screen height. Press any key to scroll.");
-            refresh();
-            getch();
-            clear();
-            row = 2;
+// 적재한 목록을 설치 목록으로 등록
+static int registerInstalled(PackageStore *store) {
+    for (int i = 0; i < store->count; i++) {
+        store->items[i].flags |= PKG_INSTALLED;
+    }
+    storeCheckSorted(store);
+    storeBuildIndex(store);
+    installedStore = store;
+    return store->count;
+}
+
+static int loadInstalled(PackageStore *store) {
+    if (!config.forceDpkgQuery) {
+        struct stat statusStat;
+        bool haveStat = stat(config.statusPath, &statusStat) == 0;
+
+        // 캐시가 최신이면 stat + mmap 만으로 적재 완료
+        if (config.useCache && haveStat && snapshotLoad(store, &statusStat)) {
+            return registerInstalled(store);
         }
-        refresh();
+
+        int packageCount = loadPackagesFromStatus(store);
+        if (packageCount > 0) {
+            // 캐시가 없거나 손상·만료된 경우 새로 기록 (실패해도 동작에는 영향 없음)
+            if (config.useCache && haveStat) {
+                snapshotSave(store, &statusStat);
+            }
+            return registerInstalled(store);
+        }
+        fprintf(stderr, "Failed to read %s, falling back to dpkg-query\n", config.statusPath);
     }
+    storeFree(store);
+    storeInit(store);
+    loadPackagesFromDpkgQuery(store);
+    return registerInstalled(store);
 }
 
-// 작업 결과 메시지 표시
-static void displayActionResult(int result, int action, const char *packageName, int row) {
-    if (result == 0) {
-        if (action == ACTION_UPDATE) {
-            mvprintw(row, 0, "System updated and upgraded successfully.");
-        } else {
-            mvprintw(row, 0, "Package '%s' was %s successfully.", 
-                     packageName, action == ACTION_INSTALL ? "installed" : "removed");
+int loadPackages(PackageStore *store) {
+    uint64_t start = traceBegin();
+    int count = loadInstalled(store);
+    traceEnd("loadPackages", start);
+    return count;
+}
+
+// 설치 목록을 저장소에 모으지 않고 읽는 대로 한 항목씩 넘김 (비대화형 --list)
+// 넘긴 항목 수, status 파일과 dpkg-query를 모두 읽지 못하면 -1
+int streamInstalled(PackageVisitor visit, void *context) {
+    MappedFile file;
+    int count = 0;
+
+    if (!config.forceDpkgQuery && mapFile(config.statusPath, &file)) {
+        StanzaReader reader;
+        Stanza stanza;
+        PackageFields fields;
+
+        stanzaReaderInit(&reader, file.data, file.size);
+        while (stanzaNext(&reader, &stanza)) {
+            if (!statusFields(&stanza, &fields)) continue;
+            count++;
+            if (!visit(&fields, context)) break;
         }
-    } else {
-        if (action == ACTION_UPDATE) {
-            mvprintw(row, 0, "Error: Failed to update and upgrade the system.");
-        } else {
-            mvprintw(row, 0, "Error: Failed to %s package '%s'.", 
-                     action == ACTION_INSTALL ? "install" : "remove", packageName);
+        unmapFile(&file);
+        return count;
+    }
+
+    uint64_t start = traceBegin();
+    FILE *fp = popen("dpkg-query -W -f='${Package}\t${Version}\t${binary:Summary}\n'", "r");
+    if (!fp) {
+        return -1;
+    }
+
+    char *line = NULL;
+    size_t lineSize = 0;
+    PackageFields fields;
+    while (getline(&line, &lineSize, fp) >= 0) {
+        if (!splitPackageLine(line, &fields)) continue;
+        count++;
+        if (!visit(&fields, context)) break;
+    }
+    free(line);
+    int status = pclose(fp);
+    traceEnd("popen dpkg-query", start);
+    return status == 0 || count > 0 ? count : -1;
+}
+
+static bool sameText(const char *current, const char *text, size_t length) {
+    return strncmp(current, text, length) == 0 && current[length] == '\0';
+}
+
+// index와 이름이 같으면서 아직 대응되지 않은 항목 (버전까지 같은 항목 우선). 없으면 -1
+// 같은 이름 항목은 정렬된 저장소에서는 붙어 있으므로 이웃만 보고, 아니면 앞쪽 전체를 훑음
+static int findUnseenDuplicate(const PackageStore *store, int index, int sortedCount,
+                               const unsigned char *seen, const char *version, size_t versionLen) {
+    const char *name = store->items[index].name;
+    int first = 0, last = sortedCount - 1;
+    int found = -1;
+
+    if (store->sorted) {
+        first = last = index;
+        while (first > 0 && strcmp(store->items[first - 1].name, name) == 0) first--;
+        while (last + 1 < sortedCount && strcmp(store->items[last + 1].name, name) == 0) last++;
+    }
+
+    for (int i = first; i <= last; i++) {
+        if (seen[i] || strcmp(store->items[i].name, name) != 0) continue;
+        if (version && sameText(store->items[i].version, version, versionLen)) return i;
+        if (found < 0) found = i;
+    }
+    return found;
+}
+
+// 새 status 파일과 저장소를 비교해 추가·삭제·변경된 항목만 반영. 비교할 수 없으면 -1
+// statusStat은 매핑하기 전에 얻은 것이라, 그 사이 dpkg가 파일을 바꿔도 스냅숏 키가 내용보다 오래되어
+// 다음 실행에서 다시 읽힐 뿐 오래된 내용이 새 키로 저장되지 않음
+static int applyStatusDiff(PackageStore *store, struct stat *statusStat, bool *haveStat) {
+    *haveStat = false;
+    if (!store->names.slots || config.forceDpkgQuery) return -1;
+
+    *haveStat = stat(config.statusPath, statusStat) == 0;
+    MappedFile file;
+    if (!mapFile(config.statusPath, &file)) return -1;
+
+    int sortedCount = store->count;
+    unsigned char *seen = (unsigned char *)calloc(sortedCount > 0 ? sortedCount : 1, 1);
+    if (!seen) {
+        unmapFile(&file);
+        return -1;
+    }
+
+    StanzaReader reader;
+    Stanza stanza;
+    int changes = 0;
+    bool failed = false;
+    stanzaReaderInit(&reader, file.data, file.size);
+
+    while (!failed && stanzaNext(&reader, &stanza)) {
+        size_t nameLen, versionLen, descLen, statusLen;
+        const char *name = stanzaGet(&stanza, "Package", &nameLen);
+        const char *version = stanzaGet(&stanza, "Version", &versionLen);
+        const char *description = stanzaGet(&stanza, "Description", &descLen);
+        const char *status = stanzaGet(&stanza, "Status", &statusLen);
+
+        if (!name || nameLen == 0 || !isListedStatus(status, statusLen)) continue;
+        if (description) descLen = firstLineLength(description, descLen);
+
+        int index = storeLookup(store, name, nameLen);
+        // 이름이 같은 항목이 이미 대응되었으면 (multi-arch same 등) 남은 같은 이름 항목과 비교
+        if (index >= 0 && index < sortedCount && seen[index]) {
+            index = findUnseenDuplicate(store, index, sortedCount, seen, version, versionLen);
+        }
+        // 없거나 이번에 추가한 이름이 다시 나오면 새 항목
+        if (index < 0 || index >= sortedCount) {
+            Package *added = storeAdd(store, name, nameLen, version, versionLen, description, descLen);
+            if (!added) failed = true;
+            else added->flags |= PKG_INSTALLED;
+            if (added) detailCacheInvalidate(added->name);
+            changes++;
+            continue;
+        }
+
+        seen[index] = 1;
+
+        const Package *package = &store->items[index];
+        bool versionSame = version ? sameText(package->version, version, versionLen)
+                                   : strcmp(package->version, "(Unknown)") == 0;
+        bool descSame = description ? sameText(package->description, description, descLen)
+                                    : strcmp(package->description, "(No description)") == 0;
+        if (!versionSame || !descSame) {
+            if (!versionSame) detailCacheInvalidate(package->name);
+            if (!storeUpdate(store, index, version, versionLen, description, descLen)) failed = true;
+            changes++;
         }
     }
+    unmapFile(&file);
+
+    if (!failed) {
+        bool added = store->count > sortedCount;
+        for (int i = 0; i < sortedCount; i++) {
+            if (!seen[i]) detailCacheInvalidate(store->items[i].name);
+        }
+        changes += storeRetain(store, seen, sortedCount);
+        // 같은 이름 항목은 loadPackages처럼 모두 남김
+        if (added) storeSortByName(store, false);
+    }
+    free(seen);
+    return failed ? -1 : changes;
 }
 
-void managePackage(Package *package, int action) {
-    char command[COMMAND_SIZE];
+// dpkg status 변경을 설치 목록에 반영. 가능하면 제자리 갱신, 아니면 전체 재적재
+int refreshInstalled(void) {
+    PackageStore *store = installedStore;
+    if (!store) return -1;
+
+    unsigned generation = store->generation;
+    struct stat statusStat;
+    bool haveStat;
+    int changes = applyStatusDiff(store, &statusStat, &haveStat);
+
+    // 의존 관계도 바뀌었을 수 있으므로 다음에 필요할 때 다시 구성
+    freeDependencyGraph();
+
+    if (changes < 0) {
+        // 무엇이 바뀌었는지 모르므로 상세 정보 캐시도 모두 버림
+        detailCacheClear();
+        storeFree(store);
+        storeInit(store);
+        // loadPackages가 스냅숏도 직접 기록함
+        if (loadPackages(store) <= 0) return -1;
+        store->generation = generation + 1;
+        return store->count;
+    }
+
+    if (changes > 0) {
+        store->generation = generation + 1;
+        if (config.useCache && haveStat) snapshotSave(store, &statusStat);
+    }
+    return changes;
+}
+
+// [sudo] apt-get 인자... 형태의 argv 구성 (문자열은 복사하지 않음)
+static int aptPrefix(char **argv) {
+    int count = 0;
+
+    if (config.sudoPath) argv[count++] = (char *)config.sudoPath;
+    argv[count++] = (char *)config.aptGetPath;
+    return count;
+}
+
+static void aptArgv(char **argv, const char *arg1, const char *arg2, const char *arg3) {
+    int count = aptPrefix(argv);
+
+    if (arg1) argv[count++] = (char *)arg1;
+    if (arg2) argv[count++] = (char *)arg2;
+    if (arg3) argv[count++] = (char *)arg3;
+    argv[count] = NULL;
+}
+
+static void showJobBusy(void) {
+    clear();
+    mvprintw(0, 0, "Another job is still running: %s", jobCurrent()->title);
+    mvprintw(ROWS - 1, 0, "Press any key to return.");
+    refresh();
+    getch();
     clear();
+}
+
+// 명령을 백그라운드 작업으로 시작. 결과는 목록 아래 출력 창에 표시
+void managePackage(Package *package, int action) {
+    char *first[6], *second[6];
+    char *const *steps[JOB_MAX_STEPS] = {first, second};
+    char title[JOB_TITLE_SIZE];
+    int stepCount = 1;
 
     // 패키지 이름 검증
     if (action != ACTION_UPDATE && (!package || !isValidPackageName(package->name))) {
+        clear();
         mvprintw(0, 0, "Error: Invalid package name");
         mvprintw(ROWS - 1, 0, "Press any key to return.");
         refresh();
@@ -138,124 +432,506 @@ void managePackage(Package *package, int action) {
         return;
     }
 
+    if (jobRunning()) {
+        showJobBusy();
+        return;
+    }
+
     switch (action) {
         case ACTION_INSTALL:
-            snprintf(command, sizeof(command), "sudo apt-get install -y %s 2>&1", package->name);
-            mvprintw(0, 0, "Installing package: %s", package->name);
+            aptArgv(first, "install", "-y", package->name);
+            snprintf(title, sizeof(title), "Installing package: %s", package->name);
             break;
         case ACTION_REMOVE:
-            snprintf(command, sizeof(command), "sudo apt-get remove -y %s 2>&1", package->name);
-            mvprintw(0, 0, "Removing package: %s", package->name);
+            aptArgv(first, "remove", "-y", package->name);
+            snprintf(title, sizeof(title), "Removing package: %s", package->name);
             break;
         case ACTION_UPDATE:
-            snprintf(command, sizeof(command), "sudo apt-get update && sudo apt-get upgrade -y");
-            mvprintw(0, 0, "Updating and upgrading the system...");
+            aptArgv(first, "update", NULL, NULL);
+            aptArgv(second, "upgrade", "-y", NULL);
+            stepCount = 2;
+            snprintf(title, sizeof(title), "Updating and upgrading the system");
             break;
         default:
-            mvprintw(0, 0, "Invalid action.");
-            refresh();
-            sleep(2);
             return;
     }
 
-    refresh();
+    uint64_t start = traceBegin();
+    jobStart(title, steps, stepCount);
+    traceEnd("managePackage", start);
+}
 
-    FILE *fp = popen(command, "r");
-    if (!fp) {
-        mvprintw(2, 0, "Error: Failed to execute command.");
-        mvprintw(ROWS - 1, 0, "Press any key to return.");
-        refresh();
-        getch();
-        clear();
+// 삭제하기 전에 함께 삭제될 패키지를 메모리 안의 의존 그래프로 계산해 보여 주고 확인을 받음
+void removePackage(Package *package) {
+    if (!package || !isValidPackageName(package->name)) {
+        managePackage(package, ACTION_REMOVE);
+        return;
+    }
+    if (jobRunning()) {
+        showJobBusy();
         return;
     }
 
-    int currentRow = 2;
-    displayCommandOutput(fp);
-    int result = pclose(fp);
+    const DepGraph *graph = getDependencyGraph();
+    DepImpact impact = { 0 };
+    int node = graph ? depGraphFind(graph, package->name) : -1;
+    if (node >= 0) {
+        uint64_t start = traceBegin();
+        depGraphRemovalImpact(graph, &node, 1, &impact);
+        traceEnd("removalImpact", start);
+    }
 
-    // 마지막 출력 줄 찾기
-    for (int i = ROWS - 2; i >= 2; i--) {
-        move(i, 0);
-        if (inch() != ' ' && inch() != '\0') {
-            currentRow = i + 1;
-            break;
+    int choice = reviewRemoval(package, impact.removed ? graph : NULL, &impact);
+    depImpactFree(&impact);
+    if (choice == REVIEW_APPLY) managePackage(package, ACTION_REMOVE);
+}
+
+// 표시한 설치·삭제를 검토 후 apt-get 한 번으로 실행 (apt-get install a b- ...)
+void commitMarks(PackageList *list) {
+    int total = list->installMarks + list->removeMarks;
+    if (total == 0) return;
+
+    if (jobRunning()) {
+        showJobBusy();
+        return;
+    }
+
+    // 표시한 삭제 전체의 영향 (설치 표시가 깨진 의존성을 채워 줄 수도 있지만 여기서는 따지지 않음)
+    const DepGraph *graph = getDependencyGraph();
+    DepImpact impact = { 0 };
+    if (graph && list->removeMarks > 0) {
+        int *nodes = (int *)malloc(list->removeMarks * sizeof(int));
+        int count = 0;
+        for (int i = 0; nodes && i < list->store->count; i++) {
+            const Package *package = &list->store->items[i];
+            if (package->flags & PKG_MARK_REMOVE) nodes[count++] = depGraphFind(graph, package->name);
         }
+        uint64_t start = traceBegin();
+        if (nodes) depGraphRemovalImpact(graph, nodes, count, &impact);
+        traceEnd("removalImpact", start);
+        free(nodes);
     }
 
-    const char *pkgName = (action != ACTION_UPDATE && package) ? package->name : "";
-    displayActionResult(result, action, pkgName, currentRow);
+    int choice = reviewMarks(list, impact.removed ? graph : NULL, impact.removed ? &impact : NULL);
+    depImpactFree(&impact);
+    if (choice == REVIEW_CLEAR) listClearMarks(list);
+    if (choice != REVIEW_APPLY) return;
 
-    refresh();
-    if (action != ACTION_UPDATE) { 
-        mvprintw(ROWS - 1, 0, "Press any key to return to the list.");
-        getch();
-        clear();
-    } else {
-        sleep(2);
-        clear();
+    // 이름 뒤의 '-'는 같은 트랜잭션에서 삭제하라는 뜻
+    Arena names;
+    char **argv = (char **)calloc(total + 5, sizeof(char *));
+    if (!argv) return;
+    arenaInit(&names, ARENA_BLOCK_SIZE);
+
+    int count = aptPrefix(argv);
+    argv[count++] = "install";
+    argv[count++] = "-y";
+
+    const PackageStore *store = list->store;
+    for (int i = 0; i < store->count; i++) {
+        const Package *package = &store->items[i];
+        if (!(package->flags & PKG_MARKS) || !isValidPackageName(package->name)) continue;
+
+        size_t length = strlen(package->name);
+        char *arg = (char *)arenaAlloc(&names, length + 2, 1);
+        if (!arg) break;
+        memcpy(arg, package->name, length);
+        arg[length] = (package->flags & PKG_MARK_REMOVE) ? '-' : '\0';
+        arg[length + 1] = '\0';
+        argv[count++] = arg;
     }
+    argv[count] = NULL;
+
+    char title[JOB_TITLE_SIZE];
+    char *const *steps[1] = {argv};
+    snprintf(title, sizeof(title), "Applying changes: %d to install, %d to remove",
+             list->installMarks, list->removeMarks);
+    if (jobStart(title, steps, 1)) listClearMarks(list);
+
+    arenaFree(&names);
+    free(argv);
 }
 
-// 패키지 상세 정보 가져오기
-static bool fetchPackageDetails(const char *packageName, Package *package) {
+// apt-cache show 출력을 text에 읽음 (버전을 알면 그 버전의 항목만)
+static bool readAptCacheShow(const char *name, const char *version, TextBuffer *text) {
     char command[COMMAND_SIZE];
-    char buffer[BUFFER_SIZE];
-    
-    snprintf(command, sizeof(command), "apt show %s 2>/dev/null", packageName);
+
+    if (version && isValidVersion(version)) {
+        snprintf(command, sizeof(command), "apt-cache show %s=%s 2>/dev/null", name, version);
+    } else {
+        snprintf(command, sizeof(command), "apt-cache show %s 2>/dev/null", name);
+    }
+
+    uint64_t start = traceBegin();
     FILE *fp = popen(command, "r");
     if (!fp) {
         return false;
     }
+    bool loaded = textReadStream(text, fp);
+    pclose(fp);
+    traceEnd("popen apt-cache show", start);
+    return loaded;
+}
 
-    char *name = NULL, *version = NULL, *description = NULL;
-    while (fgets(buffer, sizeof(buffer), fp)) {
-        if (strncmp(buffer, "Package:", 8) == 0) {
-            name = safeStrdup(strchr(buffer, ':') + 2);
-            name[strcspn(name, "\n")] = '\0';
-        } else if (strncmp(buffer, "Version:", 8) == 0) {
-            version = safeStrdup(strchr(buffer, ':') + 2);
-            version[strcspn(version, "\n")] = '\0';
-        } else if (strncmp(buffer, "Description:", 12) == 0) {
-            description = safeStrdup(strchr(buffer, ':') + 2);
-            description[strcspn(description, "\n")] = '\0';
+// 도우미를 쓸 수 없을 때: 패키지마다 popen
+static bool fetchWithPopen(const char *name, const char *version, TextBuffer *text) {
+    if (!isValidPackageName(name) || !readAptCacheShow(name, version, text)) {
+        return false;
+    }
+
+    // 설치된 버전이 저장소에 없으면 (로컬 설치 등) 이름만으로 다시 조회
+    if (text->lineCount == 0 && version && isValidVersion(version)) {
+        return readAptCacheShow(name, NULL, text);
+    }
+    return true;
+}
+
+// 캐시를 거치지 않고 상세 정보를 가져옴. 가능하면 도우미 프로세스에 한 묶음으로 요청
+// (도우미 연결은 잠금으로 보호하므로 작업 스레드에서도 호출. conn이 NULL이면 기본 연결)
+bool fetchPackageTexts(HelperConnection *conn, const DetailRequest *requests, int count, TextBuffer *texts) {
+    bool ok = true;
+    uint64_t start = traceBegin();
+
+    if (!helperAvailable(conn) || !helperShow(conn, requests, count, texts)) {
+        for (int i = 0; i < count; i++) {
+            textFree(&texts[i]);
+            if (!fetchWithPopen(requests[i].name, requests[i].version, &texts[i])) ok = false;
         }
     }
-    pclose(fp);
+    traceEnd("fetchPackageTexts", start);
+    return ok;
+}
+
+bool fetchPackageText(const char *name, const char *version, TextBuffer *text) {
+    DetailRequest request = { name, version };
+    return fetchPackageTexts(NULL, &request, 1, text);
+}
+
+// 패키지 상세 정보. 캐시에 없으면 apt-cache show를 실행하고 결과를 캐시에 넣음
+// 캐시에 넣지 못한 결과는 scratch에 남으므로 호출한 쪽이 사용 후 textFree 해야 함
+static const TextBuffer *lookupDetails(const char *name, const char *version, TextBuffer *scratch) {
+    // 미리 가져오는 중이면 그 결과를 기다려 씀
+    prefetchWait(name, version);
+
+    const TextBuffer *cached = detailCacheGet(name, version);
+    if (cached) {
+        return cached;
+    }
+    if (!fetchPackageText(name, version, scratch)) {
+        return NULL;
+    }
+    // 빈 결과는 캐시하지 않음 (apt update 후 다시 조회할 수 있게)
+    if (scratch->lineCount == 0) {
+        return scratch;
+    }
+
+    textShrink(scratch);
+    cached = detailCachePut(name, version, scratch);
+    return cached ? cached : scratch;
+}
+
+const TextBuffer *packageDetails(const char *name, const char *version, TextBuffer *scratch) {
+    uint64_t start = traceBegin();
+    const TextBuffer *text = lookupDetails(name, version, scratch);
+    traceEnd("packageDetails", start);
+    return text;
+}
+
+// 상세 정보의 첫 항목에서 필드 값 (한 줄). 버퍼 안을 가리키므로 길이 제한 없음
+static const char *detailField(const TextBuffer *text, const char *field) {
+    size_t fieldLen = strlen(field);
+
+    for (int i = 0; i < text->lineCount; i++) {
+        const char *line = textLine(text, i);
+        if (line[0] == '\0') break;
+        if (strncmp(line, field, fieldLen) == 0 && line[fieldLen] == ':' && line[fieldLen + 1] == ' ') {
+            return line + fieldLen + 2;
+        }
+    }
+    return NULL;
+}
+
+// 검색 결과의 상세 정보를 작업 스레드들이 가져오는 동안의 상태 (메인 스레드에서만 접근)
+typedef struct {
+    PackageStore *store;
+    int *slots;                 // 요청 번호 → 결과 항목 번호
+    unsigned char *found;       // 상세 정보를 찾은 결과 (모두 끝나면 나머지는 목록에서 뺌)
+    int count;
+    int requestCount;
+    int pending;
+    int focus;                  // 마지막으로 알린 화면 맨 위 결과 (바뀔 때만 다시 알림)
+} SearchFetch;
+
+static SearchFetch searchFetch;
+
+// 상세 정보의 버전과 요약으로 결과 항목을 채움
+static bool fillResult(PackageStore *store, int index, const TextBuffer *text) {
+    const char *version = detailField(text, "Version");
+    // 번역이 설치된 경우 요약은 Description-en 등에 있음
+    const char *description = detailField(text, "Description");
+    if (!description) description = detailField(text, "Description-en");
+
+    if (!version || !version[0] || !description || !description[0]) {
+        return false;
+    }
+    return storeUpdate(store, index, version, strlen(version), description, strlen(description));
+}
+
+// 모든 결과를 받았으면 상세 정보가 없는 항목을 빼고 정리
+static void finishSearchFetch(SearchFetch *fetch) {
+    if (fetch->pending > 0) return;
+
+    if (fetch->found && storeRetain(fetch->store, fetch->found, fetch->count) > 0) {
+        fetch->store->generation++;
+    }
+    free(fetch->slots);
+    free(fetch->found);
+    fetch->slots = NULL;
+    fetch->found = NULL;
+}
+
+static void applySearchDetail(void *context, int request, TextBuffer *text) {
+    SearchFetch *fetch = (SearchFetch *)context;
+    int index = fetch->slots[request];
+
+    if (fillResult(fetch->store, index, text)) {
+        const Package *package = &fetch->store->items[index];
+        fetch->found[index] = 1;
+        textShrink(text);
+        detailCachePut(package->name, package->version, text);
+    }
+    // 목록은 다음 listSync에서 커서를 유지한 채 다시 구성
+    fetch->store->generation++;
+    fetch->pending--;
+    finishSearchFetch(fetch);
+}
+
+// 화면 맨 위 결과부터 가져오도록 작업 스레드에 알림 (slots는 결과 순서대로 증가)
+static void focusSearchFetch(const PackageList *list) {
+    SearchFetch *fetch = &searchFetch;
+    if (!fetch->slots || fetch->pending == 0 || list->startIndex >= list->viewCount) return;
+
+    int index = list->view[list->startIndex];
+    if (index == fetch->focus) return;
+    fetch->focus = index;
+
+    int lo = 0, hi = fetch->requestCount;
+    while (lo < hi) {
+        int mid = lo + (hi - lo) / 2;
+        if (fetch->slots[mid] < index) lo = mid + 1;
+        else hi = mid;
+    }
+    poolFocus(lo);
+}
+
+// 검색 결과 상세 정보 가져오기를 멈추고 상태를 정리 (결과 저장소를 해제하기 전에 호출)
+static void stopSearchFetch(void) {
+    poolStop();
+    free(searchFetch.slots);
+    free(searchFetch.found);
+    memset(&searchFetch, 0, sizeof(searchFetch));
+}
+
+// 캐시에 있는 결과는 바로 채우고 나머지는 작업 스레드들에 나눠 요청
+// (자리 표시 항목의 버전은 apt search가 알려 준 버전이며 비어 있으면 후보 버전을 요청)
+static void fetchResultDetails(PackageStore *results) {
+    SearchFetch *fetch = &searchFetch;
+    int count = results->count;
+    DetailRequest *requests = (DetailRequest *)malloc((count > 0 ? count : 1) * sizeof(DetailRequest));
+
+    stopSearchFetch();
+    fetch->store = results;
+    fetch->count = count;
+    fetch->focus = 0;
+    fetch->slots = (int *)malloc((count > 0 ? count : 1) * sizeof(int));
+    fetch->found = (unsigned char *)calloc(count > 0 ? count : 1, 1);
+    if (!requests || !fetch->slots || !fetch->found) {
+        // 메모리가 부족하면 자리 표시 항목을 그대로 둠
+        free(requests);
+        stopSearchFetch();
+        return;
+    }
+
+    for (int i = 0; i < count; i++) {
+        const Package *package = &results->items[i];
+        const char *version = package->version[0] ? package->version : NULL;
+        const TextBuffer *cached = detailCacheGet(package->name, version);
+
+        if (cached && fillResult(results, i, cached)) {
+            fetch->found[i] = 1;
+            continue;
+        }
+        // 결과 저장소의 문자열은 poolStop까지 그대로 있음
+        fetch->slots[fetch->pending] = i;
+        requests[fetch->pending++] = (DetailRequest){ package->name, version };
+    }
+
+    fetch->requestCount = fetch->pending;
+    if (fetch->pending > 0 && !poolStart(requests, fetch->pending, config.searchJobs, applySearchDetail, fetch)) {
+        // 작업 스레드를 띄우지 못하면 여기서 차례로 가져옴
+        int pending = fetch->pending;
+        for (int i = 0; i < pending; i++) {
+            TextBuffer text;
+            textInit(&text);
+            fetchPackageText(requests[i].name, requests[i].version, &text);
+            applySearchDetail(fetch, i, &text);
+            textFree(&text);
+        }
+    }
+    free(requests);
+    finishSearchFetch(fetch);
+}
+
+// 셸 없이 apt search 단어... 를 실행하고 표준 출력을 읽는 스트림을 돌려줌 (표준 오류는 버림)
+static FILE *openAptSearch(char *const argv[], pid_t *pid) {
+    int fds[2];
+    if (pipe2(fds, O_CLOEXEC) < 0) return NULL;
+
+    *pid = fork();
+    if (*pid < 0) {
+        close(fds[0]);
+        close(fds[1]);
+        return NULL;
+    }
+    if (*pid == 0) {
+        int devNull = open("/dev/null", O_WRONLY);
+        dup2(fds[1], STDOUT_FILENO);
+        if (devNull >= 0) dup2(devNull, STDERR_FILENO);
+        execvp(argv[0], argv);
+        _exit(127);
+    }
+
+    close(fds[1]);
+    FILE *fp = fdopen(fds[0], "r");
+    if (!fp) {
+        close(fds[0]);
+        while (waitpid(*pid, NULL, 0) < 0 && errno == EINTR) {}
+    }
+    return fp;
+}
+
+// apt search 출력을 읽는 대로 한 항목씩 넘김 ("이름/배포판 버전 아키텍처 [상태]" 줄 + 들여 쓴 요약 줄)
+// 질의의 단어마다 인자 하나로 넘기므로 apt는 모든 단어가 맞는 패키지를 찾음
+// 줄 길이와 결과 개수에 제한 없음. 넘긴 항목 수, 단어가 이름 문자로만 되어 있지 않거나 실행하지 못하면 -1
+int streamAptSearch(const char *query, PackageVisitor visit, void *context) {
+    char words[PACKAGE_NAME_SIZE];
+    char *argv[FULLTEXT_QUERY_TERMS + 3] = { "apt", "search" };
+    int argc = 2;
+    char *line = NULL;
+    char *pending = NULL;       // 요약 줄을 기다리는 항목 줄
+    size_t lineSize = 0;
+    int count = 0;
+    bool stopped = false;
+    pid_t pid;
+
+    if (strlen(query) >= sizeof(words)) return -1;
+    strcpy(words, query);
+    // 순위 검색처럼 앞쪽 FULLTEXT_QUERY_TERMS개 단어만 씀
+    for (char *save, *word = strtok_r(words, " ", &save); word; word = strtok_r(NULL, " ", &save)) {
+        if (!isValidPackageName(word)) return -1;
+        if (argc < FULLTEXT_QUERY_TERMS + 2) argv[argc++] = word;
+    }
+    if (argc == 2) return -1;
+    argv[argc] = NULL;
+
+    uint64_t start = traceBegin();
+    FILE *fp = openAptSearch(argv, &pid);
+    if (!fp) {
+        return -1;
+    }
+
+    while (!stopped && getline(&line, &lineSize, fp) >= 0) {
+        if (strstr(line, "Sorting") || strstr(line, "Full Text Search") || strlen(line) <= 1) {
+            continue;
+        }
+
+        if (line[0] != ' ' && !pending) {
+            // 요약 줄을 읽을 때까지 보관 (getline 버퍼는 다음 줄에 다시 쓰임)
+            pending = line;
+            line = NULL;
+            lineSize = 0;
+            continue;
+        }
+        if (!pending) continue;
+
+        char *name = strtok(pending, " /");
+        char *suite = name ? strtok(NULL, " ") : NULL;
+        char *version = suite ? strtok(NULL, " ") : NULL;
+        char *summary = line[0] == ' ' ? line + strspn(line, " ") : NULL;
+        if (summary) summary[strcspn(summary, "\n")] = '\0';
+
+        if (name) {
+            PackageFields fields = {
+                name, strlen(name),
+                version, version ? strlen(version) : 0,
+                summary, summary ? strlen(summary) : 0,
+                NULL, 0, NULL, 0, APT_PRIORITY_DEFAULT,
+            };
+            count++;
+            stopped = !visit(&fields, context);
+        }
+
+        // 요약 없이 다음 항목 줄이 온 경우 그 줄을 새로 보관
+        free(pending);
+        pending = NULL;
+        if (line[0] != ' ') {
+            pending = line;
+            line = NULL;
+            lineSize = 0;
+        }
+    }
+    free(pending);
+    free(line);
+    fclose(fp);
+    while (waitpid(pid, NULL, 0) < 0 && errno == EINTR) {}
+    traceEnd("apt search", start);
+    return count;
+}
 
-    if (name && version && description) {
-        package->name = name;
-        package->version = version;
-        package->description = description;
+// 상세 정보가 오기 전에 apt 순서대로 자리 표시 항목을 먼저 넣어 목록을 바로 보여 줌
+static bool addSearchResult(const PackageFields *fields, void *context) {
+    PackageStore *results = (PackageStore *)context;
+    const char *name = fields->name;
+
+    // 패키지 이름 검증
+    if (!isValidPackageName(name)) {
+        fprintf(stderr, "Skipping invalid package name: %s\n", name);
         return true;
     }
-    
-    safeFree(&name);
-    safeFree(&version);
-    safeFree(&description);
-    return false;
+
+    Package *added = storeAdd(results, name, fields->nameLen, fields->version ? fields->version : "",
+                              fields->versionLen, SEARCH_FETCHING_TEXT, strlen(SEARCH_FETCHING_TEXT));
+    if (added && installedStore && storeFind(installedStore, name)) {
+        added->flags |= PKG_INSTALLED;
+    }
+    return true;
+}
+
+// 대체 경로: apt search 결과를 읽는 대로 결과 저장소에 넣고 상세 정보는 작업 스레드들이 채움
+static bool searchWithApt(const char *query, PackageStore *results) {
+    if (streamAptSearch(query, addSearchResult, results) < 0) {
+        return false;
+    }
+    fetchResultDetails(results);
+    return true;
 }
 
 void searchPackage() {
-    int count = 0;
     char query[PACKAGE_NAME_SIZE];
-    char command[COMMAND_SIZE];
-    char buffer[BUFFER_SIZE];
-    char packages[MAX_PACKAGES][PACKAGE_NAME_SIZE]; 
-    Package *p = NULL;
-    int currIndex = 0, startIndex = 0, exitFlag = 0, prevCh = 0;
+    PackageStore results;
+    PackageList list;
 
-    mvprintw(ROWS - 1, 0, "/");
+    mvprintw(ROWS - 1, 0, "Search: ");
     clrtoeol();
     echo();
 
-    getstr(query);
+    getnstr(query, sizeof(query) - 1);
     noecho();
     
-    // 입력 검증
-    if (!isValidPackageName(query)) {
+    // 입력 검증 (여러 단어는 순위 검색에서 각각 점수를 더함)
+    if (!isValidSearchQuery(query)) {
         clear();
-        mvprintw(0, 0, "Error: Invalid search query. Only alphanumeric characters, '-', '.', '_', '+', ':' are allowed.");
+        mvprintw(0, 0, "Error: Invalid search query. Only alphanumeric characters, spaces, '-', '.', '_', '+', ':' are allowed.");
         mvprintw(ROWS - 1, 0, "Press any key to return.");
         refresh();
         getch();
@@ -266,75 +942,247 @@ void searchPackage() {
     clear();
     mvprintw(0, 0, "Search results for '%s':", query);
     mvhline(1, 0, '-', COLS);
+    refresh();
 
-    snprintf(command, sizeof(command), "apt search %s 2>/dev/null", query);
+    const AptIndex *index = getSearchIndex();
 
-    FILE *fp = popen(command, "r");
-    if (!fp) {
+    // 목록 파일을 읽을 수 있으면 프로세스 실행 없이 검색, 아니면 apt 사용
+    storeInit(&results);
+    uint64_t start = traceBegin();
+    bool searched = index->packages.count > 0
+        ? aptIndexRankedSearch(index, installedStore, query, &results) >= 0
+        : searchWithApt(query, &results);
+    traceEnd("searchPackage", start);
+    if (!searched) {
         mvprintw(2, 0, "Failed to run apt search command.");
         mvprintw(ROWS - 1, 0, "Press any key to return.");
         refresh();
         getch();
+        storeFree(&results);
         return;
     }
 
-    bool isPackageLine = true;
-    while (fgets(buffer, sizeof(buffer), fp)) {
-        if (strstr(buffer, "Sorting") || strstr(buffer, "Full Text Search") || strlen(buffer) <= 1) {
-            isPackageLine = true;
-            continue;
-        }
+    // 패키지 목록 출력 및 키 입력 처리 (대체 경로는 상세 정보가 도착하는 대로 채워짐)
+    listInit(&list, &results);
+    while (!list.exitFlag) {
+        listSync(&list);
+        listScrollToCursor(&list, listVisibleRows());
+        focusSearchFetch(&list);
+        displayPackages(&list);
+        keyInput(&list);
+    }
 
-        if (isPackageLine) {
-            char *name = strtok(buffer, " /");
-            if (name && count < MAX_PACKAGES) {
-                strncpy(packages[count], name, sizeof(packages[count]) - 1);
-                packages[count][sizeof(packages[count]) - 1] = '\0';
-                count++;
-            }
-            isPackageLine = false;
+    // 메모리 해제
+    stopSearchFetch();
+    listFree(&list);
+    storeFree(&results);
+}
+
+static int collectUpgradable(const AptIndex *index, PackageStore *results) {
+    uint64_t start = traceBegin();
+    int count = aptIndexUpgradable(index, installedStore, results);
+    traceEnd("aptIndexUpgradable", start);
+    return count;
+}
+
+// 업그레이드할 수 있는 패키지 목록 (목록 파일의 후보 버전과 설치된 버전을 dpkg 순서로 비교하므로
+// apt 실행이나 네트워크 없이 바로 보여 줌). i로 한 패키지씩, +와 c로 여러 개를 업그레이드
+void showUpgradable(void) {
+    PackageStore results;
+    PackageList list;
+
+    if (!installedStore) return;
+    const AptIndex *index = getSearchIndex();
+
+    storeInit(&results);
+    unsigned installedGeneration = installedStore->generation;
+    int count = index->packages.count > 0 ? collectUpgradable(index, &results) : -1;
+    if (count <= 0) {
+        clear();
+        if (index->packages.count == 0) {
+            mvprintw(0, 0, "No package lists found in %s. Run update first.", config.listsDir);
         } else {
-            isPackageLine = false;
+            mvprintw(0, 0, count < 0 ? "Failed to compare package versions." : "All packages are up to date.");
         }
-    }
-    pclose(fp);
-
-    // 패키지 구조체 배열 메모리 할당
-    p = (Package *)calloc(count, sizeof(Package));
-    if (!p) {
-        mvprintw(2, 0, "Memory allocation failed.");
+        mvprintw(ROWS - 1, 0, "Press any key to return.");
         refresh();
         getch();
+        clear();
+        storeFree(&results);
         return;
     }
 
-    // 각 패키지 이름을 이용해 정보 추출
-    int validCount = 0;
-    for (int i = 0; i < count; i++) {
-        // 패키지 이름 검증
-        if (!isValidPackageName(packages[i])) {
-            fprintf(stderr, "Skipping invalid package name: %s\n", packages[i]);
-            continue;
-        }
-        
-        if (fetchPackageDetails(packages[i], &p[validCount])) {
-            validCount++;
+    listInit(&list, &results);
+    while (!list.exitFlag) {
+        // 작업이 끝나 설치 목록이 바뀌면 다시 비교 (업그레이드된 패키지는 사라짐)
+        if (installedStore->generation != installedGeneration) {
+            unsigned generation = results.generation;
+            installedGeneration = installedStore->generation;
+            storeFree(&results);
+            storeInit(&results);
+            collectUpgradable(index, &results);
+            // 목록은 다음 listSync에서 커서를 유지한 채 다시 구성
+            results.generation = generation + 1;
         }
+        listSync(&list);
+        listScrollToCursor(&list, listVisibleRows());
+        displayPackages(&list);
+        keyInput(&list);
     }
 
-    // 패키지 목록 출력 및 키 입력 처리
-    while (!exitFlag) {
-        if (currIndex < startIndex) {
-            startIndex = currIndex;
-        } else if (currIndex >= startIndex + ROWS - 3) {
-            startIndex = currIndex - (ROWS - 3) + 1;
+    listFree(&list);
+    storeFree(&results);
+}
+
+// 검색 인덱스 (처음 호출될 때 목록 파일을 읽어 구성)
+const AptIndex *getSearchIndex(void) {
+    if (!aptIndexLoaded) {
+        // 핀 설정을 읽지 못하면 (메모리 부족) 핀 없이 Release 우선순위와 아키텍처만 적용
+        if (!aptPolicyLoad(&aptPolicy, config.preferencesPath, config.architecture)) {
+            aptPolicyFree(&aptPolicy);
+            aptPolicy.architecture = config.architecture;
         }
-        displayPackages(p, validCount, startIndex, currIndex);
-        keyInput(&currIndex, &startIndex, &prevCh, &exitFlag, validCount, p);
+        aptIndexLoad(&aptIndex, config.listsDir, &aptPolicy);
+        aptIndexLoaded = true;
+
+        // 순위 검색용 전문 색인 (캐시를 쓰면 저장해 두고 다음 실행부터는 매핑만 함)
+        char cachePath[PATH_BUFFER_SIZE];
+        bool cached = config.useCache && cacheFilePath(cachePath, sizeof(cachePath), FULLTEXT_FILE_NAME)
+                   && cacheCreateParents(cachePath);
+        uint64_t start = traceBegin();
+        aptIndexBuildText(&aptIndex, config.listsDir, cached ? cachePath : NULL);
+        traceEnd("aptIndexBuildText", start);
     }
+    return &aptIndex;
+}
 
-    // 메모리 해제
-    freePackages(p, validCount);
+const DepGraph *getDependencyGraph(void) {
+    if (!dependencyGraphLoaded) {
+        uint64_t start = traceBegin();
+        dependencyGraphLoaded = depGraphBuild(&dependencyGraph, config.statusPath, config.extendedStatesPath);
+        traceEnd("depGraphBuild", start);
+    }
+    return dependencyGraphLoaded ? &dependencyGraph : NULL;
+}
+
+void freeDependencyGraph(void) {
+    if (dependencyGraphLoaded) {
+        depGraphFree(&dependencyGraph);
+        dependencyGraphLoaded = false;
+    }
+}
+
+static void appendLine(TextBuffer *text, const char *format, ...) {
+    char line[BUFFER_SIZE];
+    va_list args;
+
+    va_start(args, format);
+    int length = vsnprintf(line, sizeof(line) - 1, format, args);
+    va_end(args);
+    if (length < 0) return;
+    if (length > (int)sizeof(line) - 2) length = (int)sizeof(line) - 2;
+    line[length++] = '\n';
+    textAppend(text, line, (size_t)length);
 }
 
+static const char *nodeName(const DepGraph *graph, int node) {
+    return graph->nodes.items[node].name;
+}
+
+// 이 패키지를 필요로 하는 패키지 목록 (관계 종류별)
+static void appendDependents(TextBuffer *text, const DepGraph *graph, int node, bool strong) {
+    int shown = 0;
+    int lastOwner = -1;
+
+    for (uint32_t r = graph->reverseOffsets[node]; r < graph->reverseOffsets[node + 1]; r++) {
+        uint32_t group = graph->reverseGroups[r];
+        int owner = (int)graph->groupOwners[group];
+        if ((graph->groupKinds[group] == DEP_RECOMMENDS) == strong || owner == node || owner == lastOwner) continue;
 
+        if (shown++ == 0) appendLine(text, strong ? "Required by:" : "Recommended by:");
+        appendLine(text, "  %s %s", nodeName(graph, owner), graph->nodes.items[owner].version);
+        lastOwner = owner;
+    }
+    if (shown > 0) appendLine(text, "");
+}
+
+// 설치 이유 (직접 설치한 패키지에서 이 패키지까지의 의존 경로)와 정방향·역방향 의존 관계를 보여 줌
+void showWhyInstalled(const Package *package) {
+    char title[BUFFER_SIZE];
+    int path[DEP_WHY_PATH_MAX];
+    TextBuffer text;
+
+    const DepGraph *graph = getDependencyGraph();
+    int node = graph ? depGraphFind(graph, package->name) : -1;
+
+    textInit(&text);
+    snprintf(title, sizeof(title), "Why is %s installed?", package->name);
+    if (!graph) {
+        appendLine(&text, "Dependency information is unavailable (cannot read %s).", config.statusPath);
+    } else if (node < 0) {
+        appendLine(&text, "%s is not installed.", package->name);
+    } else {
+        uint64_t start = traceBegin();
+        int length = depGraphWhy(graph, node, path, DEP_WHY_PATH_MAX);
+        traceEnd("depGraphWhy", start);
+
+        if (length == 1) {
+            appendLine(&text, graph->autoKnown ? "%s was installed manually." : "No installed package depends on %s.",
+                       package->name);
+        } else if (length == 0) {
+            appendLine(&text, graph->autoKnown
+                       ? "%s was installed automatically and no manually installed package needs it any more."
+                       : "%s is only needed by packages that depend on each other in a cycle.", package->name);
+        } else if (length > 1) {
+            appendLine(&text, "%s is needed by %s%s:", package->name, nodeName(graph, path[0]),
+                       graph->autoKnown ? " (installed manually)" : " (nothing depends on it)");
+            appendLine(&text, "");
+            for (int i = 0; i < length; i++) {
+                appendLine(&text, "  %s %s", nodeName(graph, path[i]), graph->nodes.items[path[i]].version);
+                if (i + 1 < length) {
+                    appendLine(&text, "    %s: %s", depKindName(depGraphEdgeKind(graph, path[i], path[i + 1])),
+                               nodeName(graph, path[i + 1]));
+                }
+            }
+        }
+        appendLine(&text, "");
+
+        appendDependents(&text, graph, node, true);
+        appendDependents(&text, graph, node, false);
+
+        // 정방향: 그룹마다 이 패키지의 요구를 만족시키는 설치된 대안
+        for (uint32_t g = graph->groupOffsets[node]; g < graph->groupOffsets[node + 1]; g++) {
+            char alternatives[BUFFER_SIZE];
+            size_t used = 0;
+            if (g == graph->groupOffsets[node]) appendLine(&text, "Depends on (installed):");
+            alternatives[0] = '\0';
+            for (uint32_t t = graph->targetOffsets[g]; t < graph->targetOffsets[g + 1]; t++) {
+                int written = snprintf(alternatives + used, sizeof(alternatives) - used, "%s%s",
+                                       t > graph->targetOffsets[g] ? " | " : "", nodeName(graph, graph->targets[t]));
+                if (written < 0 || used + (size_t)written >= sizeof(alternatives)) break;
+                used += (size_t)written;
+            }
+            appendLine(&text, "  %s: %s", depKindName(graph->groupKinds[g]), alternatives);
+        }
+        if (graph->groupOffsets[node] < graph->groupOffsets[node + 1]) appendLine(&text, "");
+
+        DepImpact impact;
+        if (depGraphRemovalImpact(graph, &node, 1, &impact)) {
+            appendLine(&text, "Removing it would also remove %d other package%s.",
+                       impact.count - impact.requested, impact.count - impact.requested == 1 ? "" : "s");
+            depImpactFree(&impact);
+        }
+    }
+
+    pagerShow(title, &text);
+    textFree(&text);
+}
+
+// 프로그램 종료 시 검색 인덱스 해제
+void freeSearchIndex(void) {
+    if (aptIndexLoaded) {
+        aptIndexFree(&aptIndex);
+        aptPolicyFree(&aptPolicy);
+        aptIndexLoaded = false;
+    }
+}
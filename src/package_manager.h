@@ -2,16 +2,29 @@
 #define PACKAGE_MANAGER_H
 
 #include "constants.h"
+#include "package_store.h"
+#include "apt_index.h"
+#include "package_list.h"
+#include "pager.h"
+#include "helper.h"
+#include "dep_graph.h"
 
-typedef struct Package {
-    char *name;
-    char *version;
-    char *description;
-} Package;
-
-int loadPackages(Package **p);
+int loadPackages(PackageStore *store);
+int refreshInstalled(void);
+int streamInstalled(PackageVisitor visit, void *context);
+int streamAptSearch(const char *query, PackageVisitor visit, void *context);
 void managePackage(Package *package, int action);
+void removePackage(Package *package);
+void showWhyInstalled(const Package *package);
+void commitMarks(PackageList *list);
 void searchPackage();
-void freePackages(Package *p, int count);
+void showUpgradable(void);
+bool fetchPackageTexts(HelperConnection *conn, const DetailRequest *requests, int count, TextBuffer *texts);
+bool fetchPackageText(const char *name, const char *version, TextBuffer *text);
+const TextBuffer *packageDetails(const char *name, const char *version, TextBuffer *scratch);
+const AptIndex *getSearchIndex(void);
+void freeSearchIndex(void);
+const DepGraph *getDependencyGraph(void);
+void freeDependencyGraph(void);
 
 #endif // PACKAGE_MANAGER_H
@@ -0,0 +1,390 @@
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include "package_store.h"
+#include "constants.h"
+#include "text_width.h"
+#include "version.h"
+
+// FNV-1a 해시
+uint32_t hashString(const char *str, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)str[i];
+        hash *= 16777619u;
+    }
+    return hash ? hash : 1;  // 0은 빈 슬롯 표시용
+}
+
+void storeInit(PackageStore *store) {
+    memset(store, 0, sizeof(*store));
+    arenaInit(&store->arena, ARENA_BLOCK_SIZE);
+}
+
+void storeFree(PackageStore *store) {
+    if (!store) return;
+
+    free(store->items);
+    free(store->interned.hashes);
+    free(store->interned.strings);
+    free(store->names.slots);
+    arenaFree(&store->arena);
+    if (store->mapping) munmap((void *)store->mapping, store->mappingSize);
+    memset(store, 0, sizeof(*store));
+}
+
+static bool internGrow(InternTable *table) {
+    size_t capacity = table->capacity ? table->capacity * 2 : INTERN_INITIAL_CAPACITY;
+    uint32_t *hashes = (uint32_t *)calloc(capacity, sizeof(uint32_t));
+    const char **strings = (const char **)calloc(capacity, sizeof(char *));
+    if (!hashes || !strings) {
+        free(hashes);
+        free(strings);
+        return false;
+    }
+
+    for (size_t i = 0; i < table->capacity; i++) {
+        if (!table->hashes[i]) continue;
+        size_t slot = table->hashes[i] & (capacity - 1);
+        while (hashes[slot]) slot = (slot + 1) & (capacity - 1);
+        hashes[slot] = table->hashes[i];
+        strings[slot] = table->strings[i];
+    }
+
+    free(table->hashes);
+    free(table->strings);
+    table->hashes = hashes;
+    table->strings = strings;
+    table->capacity = capacity;
+    return true;
+}
+
+// 같은 내용의 문자열이 이미 있으면 그 포인터를, 없으면 아레나에 복사한 포인터를 반환
+const char *storeIntern(PackageStore *store, const char *str, size_t length) {
+    InternTable *table = &store->interned;
+
+    // 적재율 50% 초과 시 확장
+    if ((table->count + 1) * 2 > table->capacity && !internGrow(table)) {
+        return arenaStrndup(&store->arena, str, length);
+    }
+
+    uint32_t hash = hashString(str, length);
+    size_t slot = hash & (table->capacity - 1);
+
+    while (table->hashes[slot]) {
+        const char *candidate = table->strings[slot];
+        if (table->hashes[slot] == hash && strncmp(candidate, str, length) == 0 && candidate[length] == '\0') {
+            store->internHits++;
+            return candidate;
+        }
+        slot = (slot + 1) & (table->capacity - 1);
+    }
+
+    char *copy = arenaStrndup(&store->arena, str, length);
+    if (!copy) return NULL;
+
+    table->hashes[slot] = hash;
+    table->strings[slot] = copy;
+    table->count++;
+    return copy;
+}
+
+static void indexInsert(NameIndex *index, uint32_t hash, int32_t item) {
+    size_t mask = index->capacity - 1;
+    size_t slot = hash & mask;
+
+    while (index->slots[slot].hash) slot = (slot + 1) & mask;
+    index->slots[slot].hash = hash;
+    index->slots[slot].index = item;
+    index->count++;
+}
+
+// 적재율 50% 이하가 되도록 크기를 잡고 items 전체로 색인을 다시 만듦
+static bool indexRebuild(PackageStore *store, size_t minimum) {
+    NameIndex *index = &store->names;
+    size_t capacity = 16;
+    while (capacity < minimum * 2) capacity *= 2;
+
+    if (capacity != index->capacity) {
+        NameSlot *slots = (NameSlot *)malloc(capacity * sizeof(NameSlot));
+        if (!slots) return false;
+        free(index->slots);
+        index->slots = slots;
+        index->capacity = capacity;
+    }
+    memset(index->slots, 0, capacity * sizeof(NameSlot));
+    index->count = 0;
+
+    for (int i = 0; i < store->count; i++) {
+        const char *name = store->items[i].name;
+        indexInsert(index, hashString(name, strlen(name)), i);
+    }
+    return true;
+}
+
+// 번호가 바뀐 뒤 색인을 다시 만듦. 실패하면 옛 번호가 남지 않도록 색인을 버리고
+// 이진 탐색/선형 검색으로 돌아감
+static void indexRefresh(PackageStore *store, size_t minimum) {
+    NameIndex *index = &store->names;
+
+    if (!indexRebuild(store, minimum)) {
+        free(index->slots);
+        memset(index, 0, sizeof(*index));
+    }
+}
+
+bool storeBuildIndex(PackageStore *store) {
+    indexRefresh(store, (size_t)store->count);
+    return store->names.slots != NULL;
+}
+
+static uint16_t clampWidth(int width) {
+    return width > COLUMN_WIDTH_LIMIT ? COLUMN_WIDTH_LIMIT : (uint16_t)width;
+}
+
+static void countWidths(PackageStore *store, const Package *package) {
+    ColumnLayout *layout = &store->layout;
+
+    layout->nameCounts[package->nameWidth]++;
+    layout->versionCounts[package->versionWidth]++;
+    if (package->nameWidth > layout->nameWidth) layout->nameWidth = package->nameWidth;
+    if (package->versionWidth > layout->versionWidth) layout->versionWidth = package->versionWidth;
+}
+
+// 패키지의 표시 폭을 계산해 열 너비 히스토그램에 반영
+void storeTrackWidths(PackageStore *store, Package *package) {
+    package->nameWidth = clampWidth(textWidth(package->name));
+    package->versionWidth = clampWidth(textWidth(package->version));
+    countWidths(store, package);
+}
+
+static bool storeReserve(PackageStore *store) {
+    if (store->count == store->capacity) {
+        int capacity = store->capacity ? store->capacity * 2 : INITIAL_PACKAGE_CAPACITY;
+        Package *items = (Package *)realloc(store->items, capacity * sizeof(Package));
+        if (!items) return false;
+        store->items = items;
+        store->capacity = capacity;
+    }
+    return true;
+}
+
+// 마지막에 추가한 항목을 이름 색인에 넣음
+static void indexAppend(PackageStore *store, size_t nameLen) {
+    NameIndex *index = &store->names;
+    if (!index->slots) return;
+
+    if ((index->count + 1) * 2 > index->capacity) {
+        indexRefresh(store, index->count + 1);
+    } else {
+        indexInsert(index, hashString(store->items[store->count - 1].name, nameLen), store->count - 1);
+    }
+}
+
+Package *storeAdd(PackageStore *store,
+                  const char *name, size_t nameLen,
+                  const char *version, size_t versionLen,
+                  const char *description, size_t descLen) {
+    if (!storeReserve(store)) return NULL;
+
+    Package *package = &store->items[store->count];
+    package->name = arenaStrndup(&store->arena, name, nameLen);
+    package->version = version
+        ? storeIntern(store, version, versionLen)
+        : storeIntern(store, "(Unknown)", 9);
+    package->description = description
+        ? arenaStrndup(&store->arena, description, descLen)
+        : storeIntern(store, "(No description)", 16);
+
+    package->flags = 0;
+    if (!package->name || !package->version || !package->description) return NULL;
+
+    storeTrackWidths(store, package);
+    store->count++;
+    indexAppend(store, nameLen);
+    return package;
+}
+
+// 다른 저장소의 패키지를 문자열 복사 없이 추가 (검색 결과처럼 원본보다 먼저 해제되는 저장소용)
+// 항목 하나당 Package 구조체만 늘어나며 표시 폭도 원본에서 계산한 값을 그대로 씀
+Package *storeAddShared(PackageStore *store, const Package *source) {
+    if (!storeReserve(store)) return NULL;
+
+    Package *package = &store->items[store->count];
+    *package = *source;
+    package->flags = 0;
+
+    countWidths(store, package);
+    store->count++;
+    indexAppend(store, strlen(package->name));
+    return package;
+}
+
+// 최댓값을 가진 마지막 항목이 빠지면 다음으로 큰 폭까지 내려감
+static void shrinkWidth(const uint32_t *counts, int *width) {
+    while (*width > 0 && counts[*width] == 0) (*width)--;
+}
+
+void storeUntrackWidths(PackageStore *store, const Package *package) {
+    ColumnLayout *layout = &store->layout;
+
+    if (layout->nameCounts[package->nameWidth]) layout->nameCounts[package->nameWidth]--;
+    if (layout->versionCounts[package->versionWidth]) layout->versionCounts[package->versionWidth]--;
+    shrinkWidth(layout->nameCounts, &layout->nameWidth);
+    shrinkWidth(layout->versionCounts, &layout->versionWidth);
+}
+
+// index 번째 패키지의 버전·설명을 새 값으로 교체 (이전 문자열은 저장소가 해제될 때 함께 반환)
+bool storeUpdate(PackageStore *store, int index,
+                 const char *version, size_t versionLen,
+                 const char *description, size_t descLen) {
+    Package *package = &store->items[index];
+    const char *newVersion = version
+        ? storeIntern(store, version, versionLen)
+        : storeIntern(store, "(Unknown)", 9);
+    const char *newDescription = description
+        ? arenaStrndup(&store->arena, description, descLen)
+        : storeIntern(store, "(No description)", 16);
+    if (!newVersion || !newDescription) return false;
+
+    storeUntrackWidths(store, package);
+    package->version = newVersion;
+    package->description = newDescription;
+    storeTrackWidths(store, package);
+    return true;
+}
+
+// 앞쪽 count개 중 keep[i]가 0인 항목을 제거하고 순서를 유지한 채 당김. 제거한 수를 반환
+int storeRetain(PackageStore *store, const unsigned char *keep, int count) {
+    int out = 0;
+    int removed = 0;
+
+    for (int i = 0; i < store->count; i++) {
+        if (i < count && !keep[i]) {
+            storeUntrackWidths(store, &store->items[i]);
+            removed++;
+            continue;
+        }
+        if (out != i) store->items[out] = store->items[i];
+        out++;
+    }
+    store->count = out;
+    if (removed > 0 && store->names.slots) indexRefresh(store, (size_t)out);
+    return removed;
+}
+
+// 이름순, 같은 이름은 핀 우선순위가 높은 것, 그다음 높은 버전이 먼저 (결과가 입력 순서에 좌우되지 않도록)
+// apt 목록 저장소에서는 unique로 남는 첫 항목이 apt_policy.h의 규칙으로 고른 후보 버전
+// (우선순위가 없는 저장소는 모두 같은 값이라 버전만 비교)
+static int compareByName(const void *a, const void *b) {
+    const Package *pa = (const Package *)a;
+    const Package *pb = (const Package *)b;
+    int cmp = strcmp(pa->name, pb->name);
+    if (cmp) return cmp;
+    if (packagePriority(pa) != packagePriority(pb)) return packagePriority(pb) - packagePriority(pa);
+    return versionCompare(pb->version, pa->version);
+}
+
+// 이름순 정렬. unique면 같은 이름은 첫 항목 (후보 버전) 하나만 남김
+void storeSortByName(PackageStore *store, bool unique) {
+    if (store->count > 1) {
+        qsort(store->items, store->count, sizeof(Package), compareByName);
+    }
+
+    if (unique && store->count > 1) {
+        int out = 1;
+        for (int i = 1; i < store->count; i++) {
+            if (strcmp(store->items[i].name, store->items[out - 1].name) != 0) {
+                store->items[out++] = store->items[i];
+            } else {
+                storeUntrackWidths(store, &store->items[i]);
+            }
+        }
+        store->count = out;
+    }
+    store->sorted = true;
+
+    // 정렬로 번호가 바뀌었으므로 색인을 다시 만듦
+    if (store->names.slots) indexRefresh(store, (size_t)store->count);
+}
+
+void storeCheckSorted(PackageStore *store) {
+    store->sorted = true;
+    for (int i = 1; i < store->count; i++) {
+        if (strcmp(store->items[i - 1].name, store->items[i].name) > 0) {
+            store->sorted = false;
+            return;
+        }
+    }
+}
+
+// 이름(NUL 종료가 아니어도 됨)으로 items 번호 검색. 색인이 있으면 해시, 없으면 이진/선형 검색
+int storeLookup(const PackageStore *store, const char *name, size_t length) {
+    const NameIndex *index = &store->names;
+
+    if (index->slots) {
+        uint32_t hash = hashString(name, length);
+        size_t mask = index->capacity - 1;
+
+        for (size_t slot = hash & mask; index->slots[slot].hash; slot = (slot + 1) & mask) {
+            if (index->slots[slot].hash != hash) continue;
+            const char *candidate = store->items[index->slots[slot].index].name;
+            if (strncmp(candidate, name, length) == 0 && candidate[length] == '\0') {
+                return index->slots[slot].index;
+            }
+        }
+        return -1;
+    }
+
+    if (store->sorted) {
+        int lo = 0, hi = store->count - 1;
+        while (lo <= hi) {
+            int mid = lo + (hi - lo) / 2;
+            const char *candidate = store->items[mid].name;
+            int cmp = strncmp(candidate, name, length);
+            if (cmp == 0 && candidate[length] != '\0') cmp = 1;
+            if (cmp == 0) return mid;
+            if (cmp < 0) lo = mid + 1;
+            else hi = mid - 1;
+        }
+        return -1;
+    }
+
+    for (int i = 0; i < store->count; i++) {
+        const char *candidate = store->items[i].name;
+        if (strncmp(candidate, name, length) == 0 && candidate[length] == '\0') return i;
+    }
+    return -1;
+}
+
+const Package *storeFind(const PackageStore *store, const char *name) {
+    int index = storeLookup(store, name, strlen(name));
+    return index >= 0 ? &store->items[index] : NULL;
+}
+
+// 저장소 전체가 차지하는 바이트 (아레나 블록 + 스냅샷 매핑 + 패키지 배열 + 인턴 테이블)
+size_t storeBytesUsed(const PackageStore *store) {
+    return store->arena.bytesReserved
+         + store->mappingSize
+         + (size_t)store->capacity * sizeof(Package)
+         + store->interned.capacity * (sizeof(uint32_t) + sizeof(char *))
+         + store->names.capacity * sizeof(NameSlot);
+}
+
+// glibc malloc 청크 크기 (헤더 8바이트, 16바이트 정렬, 최소 32바이트)
+static size_t mallocChunkSize(size_t size) {
+    size_t chunk = (size + 8 + 15) & ~(size_t)15;
+    return chunk < 32 ? 32 : chunk;
+}
+
+// 필드마다 strdup 하던 이전 구조였다면 필요했을 바이트 추정치
+size_t storeLegacyBytes(const PackageStore *store) {
+    size_t total = mallocChunkSize((size_t)store->count * sizeof(Package));
+
+    for (int i = 0; i < store->count; i++) {
+        total += mallocChunkSize(strlen(store->items[i].name) + 1);
+        total += mallocChunkSize(strlen(store->items[i].version) + 1);
+        total += mallocChunkSize(strlen(store->items[i].description) + 1);
+    }
+    return total;
+}
@@ -0,0 +1,126 @@
+#ifndef PACKAGE_STORE_H
+#define PACKAGE_STORE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "arena.h"
+#include "constants.h"
+
+// Package.flags 비트
+#define PKG_INSTALLED 0x01
+#define PKG_MARK_INSTALL 0x02     // 다음 트랜잭션에서 설치
+#define PKG_MARK_REMOVE 0x04      // 다음 트랜잭션에서 삭제
+#define PKG_MARKS (PKG_MARK_INSTALL | PKG_MARK_REMOVE)
+
+// apt 목록 저장소의 항목은 flags 위쪽 16비트에 핀 우선순위(+PKG_PRIORITY_BIAS)를 둠
+#define PKG_PRIORITY_SHIFT 16
+#define PKG_PRIORITY_BIAS 32768
+
+typedef struct Package {
+    const char *name;
+    const char *version;
+    const char *description;
+    unsigned int flags;
+    uint16_t nameWidth;       // 화면 표시 폭 (칸 수, COLUMN_WIDTH_LIMIT로 제한)
+    uint16_t versionWidth;
+} Package;
+
+// 저장소에 넣지 않고 한 항목씩 넘겨받을 때의 필드 (매핑된 파일을 가리키므로 NUL 종료되지 않을 수 있음)
+typedef struct PackageFields {
+    const char *name;
+    size_t nameLen;
+    const char *version;      // NULL이면 없음
+    size_t versionLen;
+    const char *description;  // 요약 한 줄. NULL이면 없음
+    size_t descLen;
+    const char *details;      // 요약 다음 줄부터의 긴 설명 (목록 파일을 훑을 때만). NULL이면 없음
+    size_t detailsLen;
+    const char *descriptionMd5;  // 긴 설명이 Translation 파일에 있을 때 잇는 키. NULL이면 없음
+    size_t descriptionMd5Len;
+    int priority;             // apt 핀 우선순위 (목록 파일을 훑을 때만 의미 있음)
+} PackageFields;
+
+static inline int packagePriority(const Package *package) {
+    return (int)(package->flags >> PKG_PRIORITY_SHIFT) - PKG_PRIORITY_BIAS;
+}
+
+static inline void packageSetPriority(Package *package, int priority) {
+    if (priority < -PKG_PRIORITY_BIAS) priority = -PKG_PRIORITY_BIAS;
+    if (priority >= PKG_PRIORITY_BIAS) priority = PKG_PRIORITY_BIAS - 1;
+    package->flags = (package->flags & ((1u << PKG_PRIORITY_SHIFT) - 1))
+                   | ((unsigned)(priority + PKG_PRIORITY_BIAS) << PKG_PRIORITY_SHIFT);
+}
+
+// false를 반환하면 순회를 멈춤
+typedef bool (*PackageVisitor)(const PackageFields *fields, void *context);
+
+// 반복되는 문자열(버전, "(Unknown)" 등)을 한 번만 저장하기 위한 해시 테이블
+typedef struct InternTable {
+    uint32_t *hashes;
+    const char **strings;
+    size_t capacity;
+    size_t count;
+} InternTable;
+
+// 열 너비 = 표시 폭별 항목 수의 최댓값. 추가·삭제 시 O(1)~O(폭)으로 갱신
+typedef struct ColumnLayout {
+    int nameWidth;
+    int versionWidth;
+    uint32_t nameCounts[COLUMN_WIDTH_LIMIT + 1];
+    uint32_t versionCounts[COLUMN_WIDTH_LIMIT + 1];
+} ColumnLayout;
+
+// 이름 → items 번호 해시 색인. 개방 주소법(선형 탐사)이며 해시를 함께 저장해
+// 문자열 비교 전에 대부분의 후보를 걸러냄 (hash 0은 빈 칸)
+typedef struct NameSlot {
+    uint32_t hash;
+    int32_t index;
+} NameSlot;
+
+typedef struct NameIndex {
+    NameSlot *slots;
+    size_t capacity;
+    size_t count;
+} NameIndex;
+
+// 패키지 배열과 모든 문자열을 한곳에서 소유하는 저장소
+typedef struct PackageStore {
+    Package *items;
+    int count;
+    int capacity;
+    Arena arena;
+    InternTable interned;
+    size_t internHits;
+    const void *mapping;      // 스냅샷에서 적재한 경우 문자열이 있는 매핑
+    size_t mappingSize;
+    bool sorted;              // 이름순 정렬 여부 (storeFind가 이진 탐색 사용)
+    unsigned generation;      // 제자리 갱신(추가·삭제·변경)마다 증가
+    ColumnLayout layout;
+    NameIndex names;          // storeBuildIndex 이후 추가·삭제·정렬 시 함께 유지
+} PackageStore;
+
+uint32_t hashString(const char *str, size_t length);
+void storeInit(PackageStore *store);
+void storeFree(PackageStore *store);
+Package *storeAdd(PackageStore *store,
+                  const char *name, size_t nameLen,
+                  const char *version, size_t versionLen,
+                  const char *description, size_t descLen);
+Package *storeAddShared(PackageStore *store, const Package *source);
+void storeTrackWidths(PackageStore *store, Package *package);
+void storeUntrackWidths(PackageStore *store, const Package *package);
+bool storeUpdate(PackageStore *store, int index,
+                 const char *version, size_t versionLen,
+                 const char *description, size_t descLen);
+int storeRetain(PackageStore *store, const unsigned char *keep, int count);
+const char *storeIntern(PackageStore *store, const char *str, size_t length);
+void storeSortByName(PackageStore *store, bool unique);
+void storeCheckSorted(PackageStore *store);
+bool storeBuildIndex(PackageStore *store);
+int storeLookup(const PackageStore *store, const char *name, size_t length);
+const Package *storeFind(const PackageStore *store, const char *name);
+size_t storeBytesUsed(const PackageStore *store);
+size_t storeLegacyBytes(const PackageStore *store);
+
+#endif // PACKAGE_STORE_H
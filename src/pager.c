@@ -0,0 +1,347 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <strings.h>
+#include <ncurses.h>
+#include "pager.h"
+#include "constants.h"
+#include "text_width.h"
+#include "utils.h"
+
+void textInit(TextBuffer *text) {
+    memset(text, 0, sizeof(*text));
+}
+
+// 쓰기 공간을 extra 바이트 이상 확보 (끝의 '\0' 자리 포함)
+static bool textReserve(TextBuffer *text, size_t extra) {
+    size_t needed = text->length + extra + 1;
+    if (needed <= text->capacity) return true;
+
+    size_t capacity = text->capacity ? text->capacity : PAGER_INITIAL_SIZE;
+    while (capacity < needed) capacity *= 2;
+
+    char *data = (char *)realloc(text->data, capacity);
+    if (!data) return false;
+    text->data = data;
+    text->capacity = capacity;
+    return true;
+}
+
+static bool addLine(TextBuffer *text, size_t start) {
+    if (text->lineCount == text->lineCapacity) {
+        int capacity = text->lineCapacity ? text->lineCapacity * 2 : PAGER_INITIAL_LINES;
+        size_t *lines = (size_t *)realloc(text->lines, capacity * sizeof(size_t));
+        if (!lines) return false;
+        text->lines = lines;
+        text->lineCapacity = capacity;
+    }
+    text->lines[text->lineCount++] = start;
+    return true;
+}
+
+// from 이후에 추가된 바이트에서 줄 경계를 찾아 색인에 추가
+static bool indexLines(TextBuffer *text, size_t from) {
+    size_t offset = from;
+
+    text->data[text->length] = '\0';
+    while (offset < text->length) {
+        if (!text->lineOpen) {
+            if (!addLine(text, offset)) return false;
+            text->lineOpen = true;
+        }
+
+        char *newline = (char *)memchr(text->data + offset, '\n', text->length - offset);
+        if (!newline) break;
+        *newline = '\0';
+        text->lineOpen = false;
+        offset = (size_t)(newline - text->data) + 1;
+    }
+    return true;
+}
+
+bool textAppend(TextBuffer *text, const char *data, size_t length) {
+    if (!textReserve(text, length)) return false;
+
+    size_t from = text->length;
+    memcpy(text->data + from, data, length);
+    text->length += length;
+    return indexLines(text, from);
+}
+
+// 파이프 출력을 끝까지 읽음 (임시 버퍼 없이 텍스트 버퍼에 바로 읽어 들임)
+bool textReadStream(TextBuffer *text, FILE *fp) {
+    for (;;) {
+        if (!textReserve(text, BUFFER_SIZE * 4)) return false;
+
+        size_t room = text->capacity - text->length - 1;
+        size_t n = fread(text->data + text->length, 1, room, fp);
+        if (n == 0) break;
+
+        size_t from = text->length;
+        text->length += n;
+        if (!indexLines(text, from)) return false;
+    }
+    return !ferror(fp);
+}
+
+const char *textLine(const TextBuffer *text, int index) {
+    if (index < 0 || index >= text->lineCount) return "";
+    return text->data + text->lines[index];
+}
+
+size_t textBytesUsed(const TextBuffer *text) {
+    return text->capacity + (size_t)text->lineCapacity * sizeof(size_t);
+}
+
+// 다 읽은 뒤 남는 공간을 돌려줌 (캐시에 오래 둘 버퍼용)
+void textShrink(TextBuffer *text) {
+    if (text->data && text->capacity > text->length + 1) {
+        char *data = (char *)realloc(text->data, text->length + 1);
+        if (data) {
+            text->data = data;
+            text->capacity = text->length + 1;
+        }
+    }
+    if (text->lines && text->lineCapacity > text->lineCount) {
+        size_t *lines = (size_t *)realloc(text->lines, text->lineCount * sizeof(size_t));
+        if (lines) {
+            text->lines = lines;
+            text->lineCapacity = text->lineCount;
+        }
+    }
+}
+
+void textFree(TextBuffer *text) {
+    free(text->data);
+    free(text->lines);
+    textInit(text);
+}
+
+// 화면의 한 줄: 원문 줄 번호와 그 줄 안에서의 시작 바이트
+typedef struct {
+    int line;
+    size_t start;
+} PagerRow;
+
+// start부터 width 칸에 들어가는 바이트 수 (넓은 문자 하나가 안 들어가도 최소 한 글자는 진행)
+static size_t rowLength(const char *line, size_t start, int width) {
+    size_t length = textFit(line + start, width, NULL);
+    if (length == 0 && line[start]) {
+        int charLength = mblen(line + start, MB_CUR_MAX);
+        length = charLength > 0 ? (size_t)charLength : 1;
+    }
+    return length;
+}
+
+// offset 바이트를 포함하는 화면 줄의 시작 위치
+static size_t rowStartFor(const char *line, size_t offset, int width) {
+    size_t start = 0;
+
+    for (;;) {
+        size_t next = start + rowLength(line, start, width);
+        if (offset < next || !line[next]) return start;
+        start = next;
+    }
+}
+
+static bool nextRow(const TextBuffer *text, PagerRow *row, int width) {
+    const char *line = textLine(text, row->line);
+    size_t end = row->start + rowLength(line, row->start, width);
+
+    if (line[end]) {
+        row->start = end;
+        return true;
+    }
+    if (row->line + 1 < text->lineCount) {
+        row->line++;
+        row->start = 0;
+        return true;
+    }
+    return false;
+}
+
+static bool prevRow(const TextBuffer *text, PagerRow *row, int width) {
+    if (row->start > 0) {
+        row->start = rowStartFor(textLine(text, row->line), row->start - 1, width);
+        return true;
+    }
+    if (row->line > 0) {
+        row->line--;
+        row->start = rowStartFor(textLine(text, row->line), SIZE_MAX, width);
+        return true;
+    }
+    return false;
+}
+
+// top에서 한 화면 아래에 더 보여 줄 줄이 있는지
+static bool hasRowBelow(const TextBuffer *text, PagerRow top, int page, int width) {
+    for (int i = 0; i < page; i++) {
+        if (!nextRow(text, &top, width)) return false;
+    }
+    return true;
+}
+
+// 검색어와 일치하는 부분을 반전해서 한 화면 줄을 출력
+static void drawRow(int y, const char *str, size_t length, const char *query) {
+    size_t queryLength = strlen(query);
+    size_t plain = 0;
+
+    move(y, 0);
+    if (queryLength == 0) {
+        addnstr(str, (int)length);
+        return;
+    }
+
+    for (size_t i = 0; i + queryLength <= length; ) {
+        if (strncasecmp(str + i, query, queryLength) != 0) {
+            i++;
+            continue;
+        }
+        addnstr(str + plain, (int)(i - plain));
+        attron(A_REVERSE);
+        addnstr(str + i, (int)queryLength);
+        attroff(A_REVERSE);
+        i += queryLength;
+        plain = i;
+    }
+    addnstr(str + plain, (int)(length - plain));
+}
+
+// from 다음 줄부터 (backward면 이전 줄부터) 검색어가 있는 줄을 찾음. 끝에 닿으면 반대쪽에서 계속
+static int findLine(const TextBuffer *text, int from, const char *query, bool backward, bool *wrapped) {
+    int step = backward ? -1 : 1;
+
+    *wrapped = false;
+    for (int i = 1; i <= text->lineCount; i++) {
+        int line = from + step * i;
+        if (line < 0 || line >= text->lineCount) {
+            *wrapped = true;
+            line = (line + text->lineCount) % text->lineCount;
+        }
+        if (strcasestr(textLine(text, line), query)) return line;
+    }
+    return -1;
+}
+
+void pagerShow(const char *title, const TextBuffer *text) {
+    PagerRow top = { 0, 0 };
+    char query[PAGER_QUERY_SIZE] = "";
+    char message[BUFFER_SIZE] = "";
+    int matchLine = -1;     // 마지막으로 찾은 줄 (n/N은 여기서부터 찾음)
+
+    for (;;) {
+        int width = COLS;
+        int page = ROWS - 3;
+        PagerRow row = top;
+        int lastLine = top.line;
+
+        erase();
+        mvprintw(0, 0, "%s", title);
+        mvhline(1, 0, '-', COLS);
+
+        if (text->lineCount == 0) {
+            mvprintw(2, 0, "No details available.");
+        }
+        for (int i = 0; i < page && text->lineCount > 0; i++) {
+            const char *line = textLine(text, row.line);
+            drawRow(2 + i, line + row.start, rowLength(line, row.start, width), query);
+            lastLine = row.line;
+            if (!nextRow(text, &row, width)) break;
+        }
+
+        if (message[0]) {
+            mvprintw(ROWS - 1, 0, "%.*s", COLS - 1, message);
+        } else {
+            char footer[BUFFER_SIZE];
+            int percent = text->lineCount ? (lastLine + 1) * 100 / text->lineCount : 100;
+            snprintf(footer, sizeof(footer),
+                     "Lines %d-%d/%d (%d%%)  j/k: scroll  PgUp/PgDn: page  /: search  n/N: next/prev  q: back",
+                     text->lineCount ? top.line + 1 : 0, text->lineCount ? lastLine + 1 : 0,
+                     text->lineCount, percent);
+            mvprintw(ROWS - 1, 0, "%.*s", COLS - 1, footer);
+        }
+        refresh();
+
+        int ch = getch();
+        message[0] = '\0';
+
+        switch (ch) {
+            case 'q':
+                clear();
+                return;
+            case 'j':
+            case KEY_DOWN:
+                if (hasRowBelow(text, top, page, width)) nextRow(text, &top, width);
+                break;
+            case 'k':
+            case KEY_UP:
+                prevRow(text, &top, width);
+                break;
+            case ' ':
+            case 'f':
+            case KEY_NPAGE:
+                for (int i = 0; i < page - 1 && hasRowBelow(text, top, page, width); i++) {
+                    nextRow(text, &top, width);
+                }
+                break;
+            case 'b':
+            case KEY_PPAGE:
+                for (int i = 0; i < page - 1 && prevRow(text, &top, width); i++) {}
+                break;
+            case 'g':
+            case KEY_HOME:
+                top = (PagerRow){ 0, 0 };
+                break;
+            case 'G':
+            case KEY_END:
+                if (text->lineCount == 0) break;
+                top.line = text->lineCount - 1;
+                top.start = rowStartFor(textLine(text, top.line), SIZE_MAX, width);
+                for (int i = 0; i < page - 1 && prevRow(text, &top, width); i++) {}
+                break;
+            case KEY_RESIZE:
+                // 새 폭에 맞는 줄 경계로 맞춤 (page는 다음 그리기에서 새 ROWS로 다시 계산)
+                updateScreenSize();
+                width = COLS;
+                if (text->lineCount > 0) top.start = rowStartFor(textLine(text, top.line), top.start, width);
+                break;
+            case '/': {
+                char input[PAGER_QUERY_SIZE];
+
+                mvprintw(ROWS - 1, 0, "/");
+                clrtoeol();
+                echo();
+                getnstr(input, sizeof(input) - 1);
+                noecho();
+
+                // 빈 입력이면 이전 검색어로 다시 찾음
+                if (input[0]) snprintf(query, sizeof(query), "%s", input);
+                // 새 검색은 화면 맨 위 줄부터 찾음
+                matchLine = top.line - 1;
+            }
+                // fall through
+            case 'n':
+            case 'N': {
+                if (!query[0] || text->lineCount == 0) break;
+
+                bool wrapped;
+                int line = findLine(text, matchLine, query, ch == 'N', &wrapped);
+                if (line < 0) {
+                    snprintf(message, sizeof(message), "Pattern not found: %s", query);
+                    break;
+                }
+
+                const char *str = textLine(text, line);
+                matchLine = line;
+                top.line = line;
+                top.start = rowStartFor(str, (size_t)(strcasestr(str, query) - str), width);
+                if (wrapped) {
+                    snprintf(message, sizeof(message), "Search wrapped: %s", query);
+                }
+                break;
+            }
+            default:
+                break;
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef PAGER_H
+#define PAGER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+
+// 가변 크기 텍스트 버퍼: 원문 하나와 줄 시작 오프셋 색인 ('\n'은 '\0'으로 바꿔 둠)
+typedef struct {
+    char *data;
+    size_t length;
+    size_t capacity;
+    size_t *lines;
+    int lineCount;
+    int lineCapacity;
+    bool lineOpen;       // 마지막 줄이 아직 '\n'으로 끝나지 않음
+} TextBuffer;
+
+void textInit(TextBuffer *text);
+bool textAppend(TextBuffer *text, const char *data, size_t length);
+bool textReadStream(TextBuffer *text, FILE *fp);
+const char *textLine(const TextBuffer *text, int index);
+size_t textBytesUsed(const TextBuffer *text);
+void textShrink(TextBuffer *text);
+void textFree(TextBuffer *text);
+
+// 화면 폭에 맞춰 그릴 때 줄을 나누는 전체 화면 뷰어 (j/k, PgUp/PgDn, g/G, / 검색, n/N)
+void pagerShow(const char *title, const TextBuffer *text);
+
+#endif // PAGER_H
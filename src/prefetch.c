@@ -0,0 +1,266 @@
+#include <stdlib.h>
+#include <string.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "prefetch.h"
+#include "package_manager.h"
+#include "detail_cache.h"
+#include "constants.h"
+
+typedef struct {
+    char name[PACKAGE_NAME_SIZE];
+    char version[PACKAGE_NAME_SIZE];
+} PrefetchItem;
+
+typedef struct PrefetchResult {
+    struct PrefetchResult *next;
+    PrefetchItem item;
+    TextBuffer text;
+} PrefetchResult;
+
+static struct {
+    pthread_t thread;
+    pthread_mutex_t lock;
+    pthread_cond_t wake;         // 새 작업이 들어왔거나 종료 요청
+    pthread_cond_t done;         // 가져오기 하나가 끝남
+    bool running;
+    bool stopping;
+    int window;
+    PrefetchItem queue[PREFETCH_QUEUE_SIZE];
+    int queueCount;
+    int queueNext;
+    PrefetchItem current[PREFETCH_BATCH];  // 작업 스레드가 가져오는 중인 묶음
+    int currentCount;
+    unsigned generation;         // 취소할 때마다 증가 (진행 중이던 결과는 버림)
+    bool cancelPending;          // 다음 예약 때 진행 중인 묶음이 새 범위 밖이면 취소
+    PrefetchResult *results;     // 메인 스레드가 아직 캐시에 넣지 않은 결과
+    int pipe[2];                 // 결과가 생기면 한 바이트 써서 메인 루프의 poll을 깨움
+    unsigned long fetched;
+    unsigned long discarded;
+} prefetch = { .pipe = { -1, -1 } };
+
+static bool sameItem(const PrefetchItem *item, const char *name, const char *version) {
+    return strcmp(item->name, name) == 0 && strcmp(item->version, version ? version : "") == 0;
+}
+
+static bool inFlight(const char *name, const char *version) {
+    for (int i = 0; i < prefetch.currentCount; i++) {
+        if (sameItem(&prefetch.current[i], name, version)) return true;
+    }
+    return false;
+}
+
+static void *prefetchWorker(void *arg) {
+    (void)arg;
+
+    pthread_mutex_lock(&prefetch.lock);
+    while (!prefetch.stopping) {
+        if (prefetch.queueNext >= prefetch.queueCount) {
+            pthread_cond_wait(&prefetch.wake, &prefetch.lock);
+            continue;
+        }
+
+        // 예약된 항목을 묶음으로 가져감 (메인 스레드가 직접 가져가기로 한 빈 항목은 건너뜀)
+        int count = 0;
+        while (count < PREFETCH_BATCH && prefetch.queueNext < prefetch.queueCount) {
+            PrefetchItem *item = &prefetch.queue[prefetch.queueNext++];
+            if (item->name[0]) prefetch.current[count++] = *item;
+        }
+        if (count == 0) continue;
+
+        unsigned generation = prefetch.generation;
+        prefetch.currentCount = count;
+        pthread_mutex_unlock(&prefetch.lock);
+
+        // 도우미·apt-cache 호출은 잠금 없이 (current는 작업 스레드만 바꿈)
+        DetailRequest requests[PREFETCH_BATCH];
+        TextBuffer texts[PREFETCH_BATCH];
+        for (int i = 0; i < count; i++) {
+            const PrefetchItem *item = &prefetch.current[i];
+            requests[i] = (DetailRequest){ item->name, item->version[0] ? item->version : NULL };
+            textInit(&texts[i]);
+        }
+        fetchPackageTexts(NULL, requests, count, texts);
+
+        pthread_mutex_lock(&prefetch.lock);
+        for (int i = 0; i < count; i++) {
+            PrefetchResult *result = NULL;
+            if (texts[i].lineCount > 0 && generation == prefetch.generation && !prefetch.stopping) {
+                result = (PrefetchResult *)malloc(sizeof(PrefetchResult));
+            }
+            if (!result) {
+                if (generation != prefetch.generation) prefetch.discarded++;
+                textFree(&texts[i]);
+                continue;
+            }
+
+            textShrink(&texts[i]);
+            result->item = prefetch.current[i];
+            result->text = texts[i];
+            result->next = prefetch.results;
+            prefetch.results = result;
+            prefetch.fetched++;
+        }
+        prefetch.currentCount = 0;
+        if (prefetch.results && write(prefetch.pipe[1], "", 1) < 0) {
+            // 파이프가 가득 차 있으면 이미 깨울 바이트가 남아 있음
+        }
+        pthread_cond_broadcast(&prefetch.done);
+    }
+    pthread_mutex_unlock(&prefetch.lock);
+    return NULL;
+}
+
+bool prefetchStart(int window) {
+    if (prefetch.running || window <= 0) return false;
+    if (window > PREFETCH_WINDOW_MAX) window = PREFETCH_WINDOW_MAX;
+
+    if (pipe2(prefetch.pipe, O_NONBLOCK | O_CLOEXEC) < 0) {
+        prefetch.pipe[0] = prefetch.pipe[1] = -1;
+        return false;
+    }
+
+    pthread_mutex_init(&prefetch.lock, NULL);
+    pthread_cond_init(&prefetch.wake, NULL);
+    pthread_cond_init(&prefetch.done, NULL);
+    prefetch.window = window;
+    prefetch.stopping = false;
+
+    if (pthread_create(&prefetch.thread, NULL, prefetchWorker, NULL) != 0) {
+        close(prefetch.pipe[0]);
+        close(prefetch.pipe[1]);
+        prefetch.pipe[0] = prefetch.pipe[1] = -1;
+        return false;
+    }
+    prefetch.running = true;
+    return true;
+}
+
+// 커서 위치부터 가까운 순서(0, +1, -1, +2, -2 ...)로 캐시에 없는 항목을 예약. 이전 예약은 대체
+void prefetchAround(const PackageList *list) {
+    if (!prefetch.running) return;
+
+    PrefetchItem wanted[PREFETCH_QUEUE_SIZE];
+    int count = 0;
+
+    for (int distance = 0; distance <= prefetch.window; distance++) {
+        for (int side = 0; side < (distance ? 2 : 1); side++) {
+            const Package *package = listAt(list, list->currIndex + (side ? -distance : distance));
+            if (!package || detailCacheContains(package->name, package->version)) continue;
+
+            snprintf(wanted[count].name, sizeof(wanted[count].name), "%s", package->name);
+            snprintf(wanted[count].version, sizeof(wanted[count].version), "%s", package->version);
+            count++;
+        }
+    }
+
+    pthread_mutex_lock(&prefetch.lock);
+    if (prefetch.cancelPending) {
+        bool keep = false;
+        for (int i = 0; i < count && !keep; i++) {
+            keep = inFlight(wanted[i].name, wanted[i].version);
+        }
+        if (prefetch.currentCount > 0 && !keep) prefetch.generation++;
+        prefetch.cancelPending = false;
+    }
+
+    prefetch.queueCount = 0;
+    prefetch.queueNext = 0;
+    for (int i = 0; i < count; i++) {
+        // 가져오는 중이거나 이미 받아 둔 항목은 건너뜀
+        bool pending = inFlight(wanted[i].name, wanted[i].version);
+        for (PrefetchResult *result = prefetch.results; result && !pending; result = result->next) {
+            pending = sameItem(&result->item, wanted[i].name, wanted[i].version);
+        }
+        if (!pending) prefetch.queue[prefetch.queueCount++] = wanted[i];
+    }
+    if (prefetch.queueCount > 0) pthread_cond_signal(&prefetch.wake);
+    pthread_mutex_unlock(&prefetch.lock);
+}
+
+// 커서가 멀리 이동한 경우: 예약을 비우고, 가져오는 중인 묶음은 새 위치 주변과 겹치지 않으면 결과를 버림
+void prefetchCancel(void) {
+    if (!prefetch.running) return;
+
+    pthread_mutex_lock(&prefetch.lock);
+    prefetch.discarded += prefetch.queueCount - prefetch.queueNext;
+    prefetch.queueCount = 0;
+    prefetch.queueNext = 0;
+    prefetch.cancelPending = true;
+    pthread_mutex_unlock(&prefetch.lock);
+}
+
+int prefetchFd(void) {
+    return prefetch.pipe[0];
+}
+
+// 작업 스레드가 가져온 결과를 상세 정보 캐시로 옮김
+void prefetchCollect(void) {
+    if (!prefetch.running) return;
+
+    char drain[64];
+    while (read(prefetch.pipe[0], drain, sizeof(drain)) > 0) {}
+
+    pthread_mutex_lock(&prefetch.lock);
+    PrefetchResult *result = prefetch.results;
+    prefetch.results = NULL;
+    pthread_mutex_unlock(&prefetch.lock);
+
+    while (result) {
+        PrefetchResult *next = result->next;
+        const char *version = result->item.version[0] ? result->item.version : NULL;
+        if (!detailCachePut(result->item.name, version, &result->text)) textFree(&result->text);
+        free(result);
+        result = next;
+    }
+}
+
+// 상세 정보를 열기 직전: 같은 항목을 가져오는 중이면 끝날 때까지 기다리고, 예약만 된 항목은 직접 가져가도록 뺌
+void prefetchWait(const char *name, const char *version) {
+    if (!prefetch.running) return;
+
+    pthread_mutex_lock(&prefetch.lock);
+    for (int i = prefetch.queueNext; i < prefetch.queueCount; i++) {
+        if (sameItem(&prefetch.queue[i], name, version)) prefetch.queue[i].name[0] = '\0';
+    }
+    while (inFlight(name, version)) {
+        pthread_cond_wait(&prefetch.done, &prefetch.lock);
+    }
+    pthread_mutex_unlock(&prefetch.lock);
+
+    prefetchCollect();
+}
+
+void prefetchStats(unsigned long *fetched, unsigned long *discarded) {
+    if (prefetch.running) pthread_mutex_lock(&prefetch.lock);
+    *fetched = prefetch.fetched;
+    *discarded = prefetch.discarded;
+    if (prefetch.running) pthread_mutex_unlock(&prefetch.lock);
+}
+
+// 프로그램 종료 시 작업 스레드를 끝냄 (진행 중인 apt-cache 한 번은 기다림)
+void prefetchStop(void) {
+    if (!prefetch.running) return;
+
+    pthread_mutex_lock(&prefetch.lock);
+    prefetch.stopping = true;
+    prefetch.queueCount = prefetch.queueNext = 0;
+    pthread_cond_signal(&prefetch.wake);
+    pthread_mutex_unlock(&prefetch.lock);
+    pthread_join(prefetch.thread, NULL);
+
+    while (prefetch.results) {
+        PrefetchResult *next = prefetch.results->next;
+        textFree(&prefetch.results->text);
+        free(prefetch.results);
+        prefetch.results = next;
+    }
+    close(prefetch.pipe[0]);
+    close(prefetch.pipe[1]);
+    pthread_cond_destroy(&prefetch.done);
+    pthread_cond_destroy(&prefetch.wake);
+    pthread_mutex_destroy(&prefetch.lock);
+    memset(&prefetch, 0, sizeof(prefetch));
+    prefetch.pipe[0] = prefetch.pipe[1] = -1;
+}
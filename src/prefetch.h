@@ -0,0 +1,18 @@
+#ifndef PREFETCH_H
+#define PREFETCH_H
+
+#include <stdbool.h>
+#include "package_list.h"
+
+// 커서 주변 패키지의 상세 정보를 작업 스레드가 미리 가져옴
+// 결과는 메인 스레드가 prefetchCollect에서 상세 정보 캐시에 넣음 (캐시는 메인 스레드에서만 접근)
+bool prefetchStart(int window);
+void prefetchAround(const PackageList *list);
+void prefetchCancel(void);
+int prefetchFd(void);
+void prefetchCollect(void);
+void prefetchWait(const char *name, const char *version);
+void prefetchStats(unsigned long *fetched, unsigned long *discarded);
+void prefetchStop(void);
+
+#endif // PREFETCH_H
@@ -0,0 +1,222 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include "snapshot.h"
+#include "constants.h"
+
+// 파일 형식 (리틀 엔디언, 모든 오프셋은 파일 시작 기준)
+//   SnapshotHeader
+//   SnapshotRecord[count]
+//   문자열 영역 (NUL 종료 문자열 연속)
+#define SNAPSHOT_MAGIC "PMSNAP\0\0"
+#define SNAPSHOT_VERSION 1
+
+typedef struct SnapshotHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t count;
+    uint64_t statusDev;
+    uint64_t statusIno;
+    uint64_t statusSize;
+    int64_t statusMtimeSec;
+    int64_t statusMtimeNsec;
+    uint64_t recordsOffset;
+    uint64_t stringsOffset;
+    uint64_t stringsSize;
+} SnapshotHeader;
+
+typedef struct SnapshotRecord {
+    uint32_t name;
+    uint32_t version;
+    uint32_t description;
+} SnapshotRecord;
+
+// $XDG_CACHE_HOME/package_manager/<fileName> (없으면 ~/.cache 사용)
+bool cacheFilePath(char *buffer, size_t size, const char *fileName) {
+    const char *base = getenv("XDG_CACHE_HOME");
+    int written;
+
+    if (base && base[0] == '/') {
+        written = snprintf(buffer, size, "%s/%s/%s", base, CACHE_DIR_NAME, fileName);
+    } else {
+        const char *home = getenv("HOME");
+        if (!home || home[0] != '/') return false;
+        written = snprintf(buffer, size, "%s/.cache/%s/%s", home, CACHE_DIR_NAME, fileName);
+    }
+    return written > 0 && (size_t)written < size;
+}
+
+bool snapshotPath(char *buffer, size_t size) {
+    return cacheFilePath(buffer, size, SNAPSHOT_FILE_NAME);
+}
+
+// 캐시 파일의 상위 디렉터리를 모두 만듦
+bool cacheCreateParents(const char *path) {
+    char dir[PATH_BUFFER_SIZE];
+
+    if (snprintf(dir, sizeof(dir), "%s", path) >= (int)sizeof(dir)) return false;
+    for (char *slash = strchr(dir + 1, '/'); slash; slash = strchr(slash + 1, '/')) {
+        *slash = '\0';
+        if (mkdir(dir, 0700) < 0 && errno != EEXIST) return false;
+        *slash = '/';
+    }
+    return true;
+}
+
+static bool headerMatches(const SnapshotHeader *header, const struct stat *st) {
+    return memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) == 0
+        && header->version == SNAPSHOT_VERSION
+        && header->statusDev == (uint64_t)st->st_dev
+        && header->statusIno == (uint64_t)st->st_ino
+        && header->statusSize == (uint64_t)st->st_size
+        && header->statusMtimeSec == (int64_t)st->st_mtim.tv_sec
+        && header->statusMtimeNsec == (int64_t)st->st_mtim.tv_nsec;
+}
+
+// 스냅샷을 매핑하여 저장소를 구성. 문자열은 복사하지 않고 매핑을 직접 가리킴
+bool snapshotLoad(PackageStore *store, const struct stat *statusStat) {
+    char path[PATH_BUFFER_SIZE];
+    struct stat st;
+
+    if (!snapshotPath(path, sizeof(path))) return false;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+    if (fstat(fd, &st) < 0 || (size_t)st.st_size < sizeof(SnapshotHeader)) {
+        close(fd);
+        return false;
+    }
+
+    size_t size = (size_t)st.st_size;
+    const char *data = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+
+    const SnapshotHeader *header = (const SnapshotHeader *)data;
+    uint64_t recordsEnd = header->recordsOffset + (uint64_t)header->count * sizeof(SnapshotRecord);
+
+    // 손상되었거나 오래된 스냅샷은 사용하지 않음
+    if (!headerMatches(header, statusStat)
+        || header->count == 0
+        || header->recordsOffset < sizeof(SnapshotHeader)
+        || header->recordsOffset % sizeof(uint32_t) != 0
+        || recordsEnd > header->stringsOffset
+        || header->stringsOffset > size
+        || header->stringsSize == 0
+        || header->stringsOffset + header->stringsSize != size
+        || data[size - 1] != '\0') {
+        munmap((void *)data, size);
+        return false;
+    }
+
+    Package *items = (Package *)malloc(header->count * sizeof(Package));
+    if (!items) {
+        munmap((void *)data, size);
+        return false;
+    }
+
+    const SnapshotRecord *records = (const SnapshotRecord *)(data + header->recordsOffset);
+    const char *strings = data + header->stringsOffset;
+
+    for (uint32_t i = 0; i < header->count; i++) {
+        if (records[i].name >= header->stringsSize
+            || records[i].version >= header->stringsSize
+            || records[i].description >= header->stringsSize) {
+            free(items);
+            munmap((void *)data, size);
+            return false;
+        }
+        items[i].name = strings + records[i].name;
+        items[i].version = strings + records[i].version;
+        items[i].description = strings + records[i].description;
+        items[i].flags = 0;
+    }
+
+    storeFree(store);
+    storeInit(store);
+    for (uint32_t i = 0; i < header->count; i++) {
+        storeTrackWidths(store, &items[i]);
+    }
+    store->items = items;
+    store->count = (int)header->count;
+    store->capacity = (int)header->count;
+    store->mapping = data;
+    store->mappingSize = size;
+    return true;
+}
+
+static bool writeString(FILE *fp, const char *str, uint64_t *offset, uint32_t *out) {
+    size_t length = strlen(str) + 1;
+
+    if (*offset + length > UINT32_MAX) return false;
+    *out = (uint32_t)*offset;
+    *offset += length;
+    return fwrite(str, 1, length, fp) == length;
+}
+
+// 임시 파일에 기록한 뒤 rename 하여 읽는 쪽이 반쯤 쓰인 파일을 보지 않도록 함
+bool snapshotSave(const PackageStore *store, const struct stat *statusStat) {
+    char path[PATH_BUFFER_SIZE];
+    char tmpPath[PATH_BUFFER_SIZE];
+
+    if (store->count <= 0 || !snapshotPath(path, sizeof(path)) || !cacheCreateParents(path)) return false;
+
+    if (snprintf(tmpPath, sizeof(tmpPath), "%s.XXXXXX", path) >= (int)sizeof(tmpPath)) return false;
+    int fd = mkstemp(tmpPath);
+    if (fd < 0) return false;
+
+    FILE *fp = fdopen(fd, "wb");
+    if (!fp) {
+        close(fd);
+        unlink(tmpPath);
+        return false;
+    }
+
+    SnapshotRecord *records = (SnapshotRecord *)malloc(store->count * sizeof(SnapshotRecord));
+    if (!records) {
+        fclose(fp);
+        unlink(tmpPath);
+        return false;
+    }
+
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = SNAPSHOT_VERSION;
+    header.count = (uint32_t)store->count;
+    header.statusDev = (uint64_t)statusStat->st_dev;
+    header.statusIno = (uint64_t)statusStat->st_ino;
+    header.statusSize = (uint64_t)statusStat->st_size;
+    header.statusMtimeSec = (int64_t)statusStat->st_mtim.tv_sec;
+    header.statusMtimeNsec = (int64_t)statusStat->st_mtim.tv_nsec;
+    header.recordsOffset = sizeof(SnapshotHeader);
+    header.stringsOffset = header.recordsOffset + (uint64_t)store->count * sizeof(SnapshotRecord);
+
+    // 문자열 영역을 먼저 쓰고 레코드는 마지막에 헤더와 함께 기록
+    bool ok = fseek(fp, (long)header.stringsOffset, SEEK_SET) == 0;
+    uint64_t offset = 0;
+    for (int i = 0; ok && i < store->count; i++) {
+        const Package *package = &store->items[i];
+        ok = writeString(fp, package->name, &offset, &records[i].name)
+          && writeString(fp, package->version, &offset, &records[i].version)
+          && writeString(fp, package->description, &offset, &records[i].description);
+    }
+    header.stringsSize = offset;
+
+    ok = ok && fseek(fp, 0, SEEK_SET) == 0
+            && fwrite(&header, sizeof(header), 1, fp) == 1
+            && fwrite(records, sizeof(SnapshotRecord), store->count, fp) == (size_t)store->count;
+    free(records);
+
+    ok = (fclose(fp) == 0) && ok;
+    if (!ok || rename(tmpPath, path) < 0) {
+        unlink(tmpPath);
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,17 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdbool.h>
+#include <sys/stat.h>
+#include "package_store.h"
+
+// 캐시 디렉터리의 파일 경로 (스냅샷, 전문 검색 색인 등)
+bool cacheFilePath(char *buffer, size_t size, const char *fileName);
+bool cacheCreateParents(const char *path);
+
+// 설치 목록 스냅샷 캐시 (dpkg status 파일의 mtime/size/inode로 유효성 판단)
+bool snapshotPath(char *buffer, size_t size);
+bool snapshotLoad(PackageStore *store, const struct stat *statusStat);
+bool snapshotSave(const PackageStore *store, const struct stat *statusStat);
+
+#endif // SNAPSHOT_H
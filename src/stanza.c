@@ -0,0 +1,239 @@
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "stanza.h"
+
+bool mapFile(const char *path, MappedFile *file) {
+    struct stat st;
+
+    file->data = NULL;
+    file->size = 0;
+
+    int fd = open(path, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) return false;
+
+    if (fstat(fd, &st) < 0 || st.st_size <= 0) {
+        close(fd);
+        return false;
+    }
+
+    void *data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return false;
+
+    // 처음부터 끝까지 한 번만 읽으므로 커널에 순차 접근을 알림
+    madvise(data, (size_t)st.st_size, MADV_SEQUENTIAL);
+
+    file->data = data;
+    file->size = (size_t)st.st_size;
+    return true;
+}
+
+void unmapFile(MappedFile *file) {
+    if (file->data) {
+        munmap((void *)file->data, file->size);
+        file->data = NULL;
+        file->size = 0;
+    }
+}
+
+void stanzaReaderInit(StanzaReader *reader, const char *buffer, size_t length) {
+    reader->cur = buffer;
+    reader->end = buffer + length;
+}
+
+// 현재 위치부터 줄 끝(개행 문자 위치 또는 버퍼 끝) 반환
+static const char *lineEnd(const char *p, const char *end) {
+    const char *nl = memchr(p, '\n', (size_t)(end - p));
+    return nl ? nl : end;
+}
+
+// 다음 스탠자를 읽어 필드 목록을 채움. 더 이상 없으면 false
+bool stanzaNext(StanzaReader *reader, Stanza *stanza) {
+    const char *p = reader->cur;
+    const char *end = reader->end;
+    StanzaField *field = NULL;
+
+    stanza->fieldCount = 0;
+
+    // 스탠자 사이의 빈 줄 건너뛰기
+    while (p < end && (*p == '\n' || *p == '\r')) p++;
+    if (p >= end) {
+        reader->cur = end;
+        return false;
+    }
+
+    while (p < end) {
+        const char *eol = lineEnd(p, end);
+
+        // 빈 줄이면 스탠자 종료
+        if (eol == p || (eol - p == 1 && *p == '\r')) {
+            p = eol < end ? eol + 1 : end;
+            break;
+        }
+
+        if (*p == ' ' || *p == '\t') {
+            // 연속 줄: 직전 필드의 값을 현재 줄 끝까지 확장
+            if (field) field->valueLen = (size_t)(eol - field->value);
+        } else if (*p != '#') {
+            const char *colon = memchr(p, ':', (size_t)(eol - p));
+            if (colon && stanza->fieldCount < STANZA_MAX_FIELDS) {
+                const char *value = colon + 1;
+                while (value < eol && (*value == ' ' || *value == '\t')) value++;
+
+                field = &stanza->fields[stanza->fieldCount++];
+                field->name = p;
+                field->nameLen = (size_t)(colon - p);
+                field->value = value;
+                field->valueLen = (size_t)(eol - value);
+            } else {
+                field = NULL;
+            }
+        }
+
+        p = eol < end ? eol + 1 : end;
+    }
+
+    reader->cur = p;
+    return stanza->fieldCount > 0 || p < end;
+}
+
+// 필드 이름(대소문자 무시)으로 값 검색
+const char *stanzaGet(const Stanza *stanza, const char *name, size_t *length) {
+    size_t nameLen = strlen(name);
+
+    for (int i = 0; i < stanza->fieldCount; i++) {
+        const StanzaField *field = &stanza->fields[i];
+        if (field->nameLen == nameLen && strncasecmp(field->name, name, nameLen) == 0) {
+            if (length) *length = field->valueLen;
+            return field->value;
+        }
+    }
+    if (length) *length = 0;
+    return NULL;
+}
+
+// 여러 줄 값의 첫 줄 길이 (Description의 요약 부분)
+size_t firstLineLength(const char *value, size_t length) {
+    const char *nl = value ? memchr(value, '\n', length) : NULL;
+    size_t len = nl ? (size_t)(nl - value) : length;
+
+    while (len > 0 && (value[len - 1] == '\r' || value[len - 1] == ' ')) len--;
+    return len;
+}
+
+bool stanzaStreamOpen(StanzaStream *stream, const char *path) {
+    memset(stream, 0, sizeof(*stream));
+    if (!decompressOpen(&stream->source, path)) return false;
+
+    // 압축되지 않은 파일은 복사 없이 매핑해서 읽음
+    if (stream->source.format == FORMAT_PLAIN) {
+        decompressClose(&stream->source);
+        if (!mapFile(path, &stream->file)) return false;
+        stanzaReaderInit(&stream->reader, stream->file.data, stream->file.size);
+        stream->mapped = true;
+        return true;
+    }
+
+    stream->buffer = (char *)malloc(STANZA_STREAM_INITIAL_SIZE);
+    if (!stream->buffer) {
+        decompressClose(&stream->source);
+        return false;
+    }
+    stream->capacity = STANZA_STREAM_INITIAL_SIZE;
+    return true;
+}
+
+// 버퍼에 완성된 스탠자가 있으면 그 끝(빈 줄 다음) 위치를 end에 넣음
+static bool findStanzaEnd(StanzaStream *stream, size_t *end) {
+    const char *buffer = stream->buffer;
+    size_t length = stream->length;
+
+    while (stream->start < length && (buffer[stream->start] == '\n' || buffer[stream->start] == '\r')) {
+        stream->start++;
+    }
+
+    size_t p = stream->scanned > stream->start ? stream->scanned : stream->start;
+    while (p < length) {
+        const char *nl = memchr(buffer + p, '\n', length - p);
+        if (!nl) break;
+
+        size_t next = (size_t)(nl - buffer) + 1;
+        if (next < length && buffer[next] == '\n') {
+            *end = next + 1;
+            return true;
+        }
+        if (next + 1 < length && buffer[next] == '\r' && buffer[next + 1] == '\n') {
+            *end = next + 2;
+            return true;
+        }
+        p = next;
+    }
+    // 청크 경계에 걸친 빈 줄을 놓치지 않도록 마지막 두 바이트는 다음에 다시 봄
+    stream->scanned = length >= 2 ? length - 2 : 0;
+    return false;
+}
+
+// 넘긴 스탠자를 버리고 남은 조각을 앞으로 옮긴 뒤 다음 청크를 풂
+static bool refillStream(StanzaStream *stream) {
+    if (stream->start > 0) {
+        memmove(stream->buffer, stream->buffer + stream->start, stream->length - stream->start);
+        stream->length -= stream->start;
+        stream->scanned = stream->scanned > stream->start ? stream->scanned - stream->start : 0;
+        stream->start = 0;
+    }
+
+    // 스탠자 하나가 버퍼보다 길 때만 늘어남
+    if (stream->capacity - stream->length < DECOMPRESS_CHUNK_SIZE) {
+        char *buffer = (char *)realloc(stream->buffer, stream->capacity * 2);
+        if (!buffer) return false;
+        stream->buffer = buffer;
+        stream->capacity *= 2;
+    }
+
+    ssize_t n = decompressRead(&stream->source, stream->buffer + stream->length, stream->capacity - stream->length);
+    if (n < 0) return false;
+    if (n == 0) stream->eof = true;
+    stream->length += (size_t)n;
+    return true;
+}
+
+// 다음 스탠자. 필드는 다음 호출 전까지만 유효함 (버퍼가 옮겨지거나 다시 채워짐)
+bool stanzaStreamNext(StanzaStream *stream, Stanza *stanza) {
+    if (stream->mapped) return stanzaNext(&stream->reader, stanza);
+
+    for (;;) {
+        size_t end;
+        bool complete = findStanzaEnd(stream, &end);
+
+        if (complete || (stream->eof && stream->start < stream->length)) {
+            StanzaReader reader;
+            if (!complete) end = stream->length;
+
+            stanzaReaderInit(&reader, stream->buffer + stream->start, end - stream->start);
+            bool found = stanzaNext(&reader, stanza);
+            stream->start = (size_t)(reader.cur - stream->buffer);
+            if (found) return true;
+            continue;
+        }
+        if (stream->eof || stream->failed) return false;
+        if (!refillStream(stream)) {
+            stream->failed = true;
+            return false;
+        }
+    }
+}
+
+void stanzaStreamClose(StanzaStream *stream) {
+    if (stream->mapped) {
+        unmapFile(&stream->file);
+    } else {
+        decompressClose(&stream->source);
+        free(stream->buffer);
+        stream->buffer = NULL;
+    }
+}
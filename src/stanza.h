@@ -0,0 +1,61 @@
+#ifndef STANZA_H
+#define STANZA_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "constants.h"
+#include "decompress.h"
+
+// deb822 형식(dpkg status, apt Packages) 필드 하나. 문자열은 NUL 종료되지 않음
+typedef struct StanzaField {
+    const char *name;
+    size_t nameLen;
+    const char *value;
+    size_t valueLen;
+} StanzaField;
+
+typedef struct Stanza {
+    StanzaField fields[STANZA_MAX_FIELDS];
+    int fieldCount;
+} Stanza;
+
+typedef struct StanzaReader {
+    const char *cur;
+    const char *end;
+} StanzaReader;
+
+// 읽기 전용으로 메모리 매핑된 파일
+typedef struct MappedFile {
+    const char *data;
+    size_t size;
+} MappedFile;
+
+// 목록 파일을 스탠자 단위로 읽음. 압축되지 않은 파일은 매핑하고, 압축된 파일은 청크 단위로 풀어
+// 완성된 스탠자만 넘기므로 파일 전체가 메모리에 풀리지 않음 (버퍼는 가장 긴 스탠자 + 청크 정도)
+typedef struct StanzaStream {
+    DecompressStream source;
+    MappedFile file;
+    StanzaReader reader;    // 매핑한 경우
+    char *buffer;           // 푼 내용 중 아직 넘기지 않은 부분
+    size_t capacity;
+    size_t start;           // 다음 스탠자 시작
+    size_t length;
+    size_t scanned;         // 스탠자 끝(빈 줄)을 찾아본 위치
+    bool mapped;
+    bool eof;
+    bool failed;            // 손상되었거나 잘린 파일 (앞쪽의 스탠자는 이미 넘김)
+} StanzaStream;
+
+bool mapFile(const char *path, MappedFile *file);
+void unmapFile(MappedFile *file);
+
+void stanzaReaderInit(StanzaReader *reader, const char *buffer, size_t length);
+bool stanzaNext(StanzaReader *reader, Stanza *stanza);
+const char *stanzaGet(const Stanza *stanza, const char *name, size_t *length);
+size_t firstLineLength(const char *value, size_t length);
+
+bool stanzaStreamOpen(StanzaStream *stream, const char *path);
+bool stanzaStreamNext(StanzaStream *stream, Stanza *stanza);
+void stanzaStreamClose(StanzaStream *stream);
+
+#endif // STANZA_H
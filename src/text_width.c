@@ -0,0 +1,62 @@
+#include <stdlib.h>
+#include <string.h>
+#include <wchar.h>
+#include "text_width.h"
+
+// str 위치의 문자 하나를 해석해 바이트 수와 칸 수를 반환
+static size_t nextChar(const char *str, mbstate_t *state, int *columns) {
+    unsigned char c = (unsigned char)*str;
+
+    // ASCII는 로캘과 관계없이 1칸 (제어 문자는 출력하지 않으므로 0칸)
+    if (c < 0x80) {
+        *columns = c >= 0x20 && c != 0x7f;
+        return 1;
+    }
+
+    wchar_t wc;
+    size_t length = mbrtowc(&wc, str, MB_CUR_MAX, state);
+    if (length == (size_t)-1 || length == (size_t)-2 || length == 0) {
+        memset(state, 0, sizeof(*state));
+        *columns = 1;
+        return 1;
+    }
+
+    int w = wcwidth(wc);
+    *columns = w < 0 ? 1 : w;
+    return length;
+}
+
+int textWidth(const char *str) {
+    mbstate_t state;
+    int width = 0;
+
+    memset(&state, 0, sizeof(state));
+    while (*str) {
+        int columns;
+        str += nextChar(str, &state, &columns);
+        width += columns;
+    }
+    return width;
+}
+
+size_t textFit(const char *str, int maxWidth, int *width) {
+    mbstate_t state;
+    size_t offset = 0;
+    int used = 0;
+
+    memset(&state, 0, sizeof(state));
+    while (str[offset]) {
+        int columns;
+        mbstate_t saved = state;
+        size_t length = nextChar(str + offset, &state, &columns);
+        if (used + columns > maxWidth) {
+            state = saved;
+            break;
+        }
+        offset += length;
+        used += columns;
+    }
+
+    if (width) *width = used;
+    return offset;
+}
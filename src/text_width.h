@@ -0,0 +1,12 @@
+#ifndef TEXT_WIDTH_H
+#define TEXT_WIDTH_H
+
+#include <stddef.h>
+
+// 문자열이 터미널에서 차지하는 칸 수 (현재 로캘 기준, 잘못된 바이트는 1칸)
+int textWidth(const char *str);
+
+// maxWidth 칸 안에 들어가는 앞부분의 바이트 수. width에는 실제 칸 수를 저장
+size_t textFit(const char *str, int maxWidth, int *width);
+
+#endif // TEXT_WIDTH_H
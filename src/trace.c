@@ -0,0 +1,114 @@
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <pthread.h>
+#include "trace.h"
+#include "constants.h"
+
+atomic_bool traceEnabled = false;
+
+static struct {
+    pthread_mutex_t lock;       // 작업 스레드(미리 가져오기, 검색 결과)도 기록함
+    FILE *file;
+    bool firstEvent;
+    bool overlay;
+    uint64_t origin;            // 파일의 ts 기준 시각 (열었을 때)
+    TraceStat stats[TRACE_MAX_NAMES];
+    int statCount;
+} trace = { .lock = PTHREAD_MUTEX_INITIALIZER };
+
+uint64_t traceNowUs(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    // 0은 "기록 안 함"을 뜻하므로 피함
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000 + 1;
+}
+
+static void updateEnabled(void) {
+    atomic_store_explicit(&traceEnabled, trace.file || trace.overlay, memory_order_relaxed);
+}
+
+static TraceStat *findStat(const char *name) {
+    // 이름은 보통 같은 문자열 상수이므로 주소부터 비교
+    for (int i = 0; i < trace.statCount; i++) {
+        if (trace.stats[i].name == name || strcmp(trace.stats[i].name, name) == 0) return &trace.stats[i];
+    }
+    if (trace.statCount == TRACE_MAX_NAMES) return NULL;
+
+    TraceStat *stat = &trace.stats[trace.statCount++];
+    memset(stat, 0, sizeof(*stat));
+    stat->name = name;
+    return stat;
+}
+
+// 구간 하나를 집계하고 파일이 열려 있으면 완료 이벤트("ph":"X")로 기록
+void traceEnd(const char *name, uint64_t start) {
+    if (!atomic_load_explicit(&traceEnabled, memory_order_relaxed) || start == 0) return;
+
+    uint64_t end = traceNowUs();
+    uint64_t duration = end > start ? end - start : 0;
+
+    pthread_mutex_lock(&trace.lock);
+    TraceStat *stat = findStat(name);
+    if (stat) {
+        stat->count++;
+        stat->totalUs += duration;
+        if (duration > stat->maxUs) stat->maxUs = duration;
+    }
+    if (trace.file) {
+        fprintf(trace.file, "%s{\"name\":\"%s\",\"cat\":\"package_manager\",\"ph\":\"X\","
+                "\"ts\":%llu,\"dur\":%llu,\"pid\":%d,\"tid\":%d}",
+                trace.firstEvent ? "" : ",\n", name,
+                (unsigned long long)(start > trace.origin ? start - trace.origin : 0),
+                (unsigned long long)duration, (int)getpid(), (int)gettid());
+        trace.firstEvent = false;
+    }
+    pthread_mutex_unlock(&trace.lock);
+}
+
+// Chrome trace의 JSON 배열 형식 (chrome://tracing, Perfetto에서 열 수 있음)
+bool traceOpen(const char *path) {
+    FILE *file = fopen(path, "w");
+    if (!file) return false;
+
+    pthread_mutex_lock(&trace.lock);
+    trace.file = file;
+    trace.firstEvent = true;
+    trace.origin = traceNowUs();
+    fputs("[\n", file);
+    updateEnabled();
+    pthread_mutex_unlock(&trace.lock);
+    return true;
+}
+
+void traceToggleOverlay(void) {
+    pthread_mutex_lock(&trace.lock);
+    trace.overlay = !trace.overlay;
+    updateEnabled();
+    pthread_mutex_unlock(&trace.lock);
+}
+
+bool traceOverlayVisible(void) {
+    return trace.overlay;
+}
+
+// 화면 출력용 집계 복사본 (작업 스레드가 갱신하는 중에도 일관된 값)
+int traceSnapshot(TraceStat *stats, int capacity) {
+    pthread_mutex_lock(&trace.lock);
+    int count = trace.statCount < capacity ? trace.statCount : capacity;
+    memcpy(stats, trace.stats, count * sizeof(TraceStat));
+    pthread_mutex_unlock(&trace.lock);
+    return count;
+}
+
+void traceClose(void) {
+    pthread_mutex_lock(&trace.lock);
+    if (trace.file) {
+        fputs("\n]\n", trace.file);
+        fclose(trace.file);
+        trace.file = NULL;
+    }
+    updateEnabled();
+    pthread_mutex_unlock(&trace.lock);
+}
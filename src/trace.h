@@ -0,0 +1,37 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdatomic.h>
+#include <stdbool.h>
+#include <stdint.h>
+
+// 주요 구간의 소요 시간 기록. 화면 통계(T 키)와 --trace 파일(Chrome trace JSON)에 쓰임
+// 둘 다 꺼져 있으면 traceBegin은 0을 반환하고 traceEnd는 바로 돌아옴
+//
+//   uint64_t start = traceBegin();
+//   ...
+//   traceEnd("loadPackages", start);
+typedef struct TraceStat {
+    const char *name;         // 구간 이름 (문자열 상수)
+    unsigned long count;
+    uint64_t totalUs;
+    uint64_t maxUs;
+} TraceStat;
+
+// 작업 스레드가 잠금 없이 읽으므로 원자적 변수 (순서는 필요 없어 relaxed)
+extern atomic_bool traceEnabled;
+
+uint64_t traceNowUs(void);
+
+static inline uint64_t traceBegin(void) {
+    return atomic_load_explicit(&traceEnabled, memory_order_relaxed) ? traceNowUs() : 0;
+}
+
+void traceEnd(const char *name, uint64_t start);
+bool traceOpen(const char *path);
+void traceToggleOverlay(void);
+bool traceOverlayVisible(void);
+int traceSnapshot(TraceStat *stats, int capacity);
+void traceClose(void);
+
+#endif // TRACE_H
@@ -0,0 +1,210 @@
+#include <stdlib.h>
+#include <string.h>
+#include "trigram.h"
+#include "constants.h"
+#include "trace.h"
+
+// 바이트를 6비트 기호로 축약 (영문은 대소문자 구분 없음). 기타 문자는 충돌을 허용하고 검증 단계에서 걸러냄
+static inline uint32_t foldByte(unsigned char c) {
+    if (c >= 'A' && c <= 'Z') return (uint32_t)(c - 'A' + 1);
+    if (c >= 'a' && c <= 'z') return (uint32_t)(c - 'a' + 1);
+    if (c >= '0' && c <= '9') return (uint32_t)(c - '0' + 27);
+    return 37 + (c % 27);
+}
+
+static inline uint32_t trigramKey(const char *s) {
+    return (foldByte((unsigned char)s[0]) << 12)
+         | (foldByte((unsigned char)s[1]) << 6)
+         | foldByte((unsigned char)s[2]);
+}
+
+// 문서(패키지)의 각 트라이그램마다 visit 호출. 같은 문서에서 같은 키는 한 번만
+typedef void (*TrigramVisitor)(uint32_t key, uint32_t document, void *ctx);
+
+static void forEachTrigram(const char *text, uint32_t document, uint32_t *lastSeen,
+                           TrigramVisitor visit, void *ctx) {
+    size_t length = strlen(text);
+    for (size_t i = 0; i + 2 < length; i++) {
+        uint32_t key = trigramKey(text + i);
+        if (lastSeen[key] != document + 1) {
+            lastSeen[key] = document + 1;
+            visit(key, document, ctx);
+        }
+    }
+}
+
+static void countVisitor(uint32_t key, uint32_t document, void *ctx) {
+    (void)document;
+    ((uint32_t *)ctx)[key + 1]++;
+}
+
+typedef struct FillContext {
+    uint32_t *cursor;
+    uint32_t *postings;
+} FillContext;
+
+static void fillVisitor(uint32_t key, uint32_t document, void *ctx) {
+    FillContext *fill = (FillContext *)ctx;
+    fill->postings[fill->cursor[key]++] = document;
+}
+
+// 두 번의 순회로 구성: 키별 개수를 센 뒤 누적합 위치에 번호를 채움
+bool trigramBuild(TrigramIndex *index, const PackageStore *store) {
+    uint64_t start = traceNowUs();
+
+    memset(index, 0, sizeof(*index));
+    index->offsets = (uint32_t *)calloc(TRIGRAM_KEYS + 1, sizeof(uint32_t));
+    uint32_t *lastSeen = (uint32_t *)calloc(TRIGRAM_KEYS, sizeof(uint32_t));
+    uint32_t *cursor = (uint32_t *)malloc(TRIGRAM_KEYS * sizeof(uint32_t));
+    if (!index->offsets || !lastSeen || !cursor) {
+        free(lastSeen);
+        free(cursor);
+        trigramFree(index);
+        return false;
+    }
+
+    for (int i = 0; i < store->count; i++) {
+        forEachTrigram(store->items[i].name, (uint32_t)i, lastSeen, countVisitor, index->offsets);
+        forEachTrigram(store->items[i].description, (uint32_t)i, lastSeen, countVisitor, index->offsets);
+    }
+    for (uint32_t key = 0; key < TRIGRAM_KEYS; key++) {
+        index->offsets[key + 1] += index->offsets[key];
+    }
+
+    index->postingCount = index->offsets[TRIGRAM_KEYS];
+    index->postings = (uint32_t *)malloc((index->postingCount ? index->postingCount : 1) * sizeof(uint32_t));
+    if (!index->postings) {
+        free(lastSeen);
+        free(cursor);
+        trigramFree(index);
+        return false;
+    }
+
+    memcpy(cursor, index->offsets, TRIGRAM_KEYS * sizeof(uint32_t));
+    memset(lastSeen, 0, TRIGRAM_KEYS * sizeof(uint32_t));
+    FillContext fill = { cursor, index->postings };
+    for (int i = 0; i < store->count; i++) {
+        forEachTrigram(store->items[i].name, (uint32_t)i, lastSeen, fillVisitor, &fill);
+        forEachTrigram(store->items[i].description, (uint32_t)i, lastSeen, fillVisitor, &fill);
+    }
+
+    free(lastSeen);
+    free(cursor);
+    index->documentCount = store->count;
+    index->buildMs = (traceNowUs() - start) / 1e3;
+    return true;
+}
+
+void trigramFree(TrigramIndex *index) {
+    free(index->offsets);
+    free(index->postings);
+    memset(index, 0, sizeof(*index));
+}
+
+size_t trigramBytes(const TrigramIndex *index) {
+    if (!index->offsets) return 0;
+    return (TRIGRAM_KEYS + 1) * sizeof(uint32_t) + index->postingCount * sizeof(uint32_t);
+}
+
+// 이름 또는 요약에 질의 문자열이 포함되는지 확인 (대소문자 무시)
+bool packageMatches(const Package *package, const char *query) {
+    return strcasestr(package->name, query) || strcasestr(package->description, query);
+}
+
+typedef struct PostingList {
+    const uint32_t *ids;
+    uint32_t length;
+} PostingList;
+
+static int compareByLength(const void *a, const void *b) {
+    uint32_t la = ((const PostingList *)a)->length;
+    uint32_t lb = ((const PostingList *)b)->length;
+    return (la > lb) - (la < lb);
+}
+
+// 정렬된 목록 list 안에서 from 이후 target 이상인 첫 위치 (지수 탐색 후 이진 탐색)
+static uint32_t gallop(const uint32_t *list, uint32_t length, uint32_t from, uint32_t target) {
+    uint32_t step = 1, lo = from, hi = from;
+    while (hi < length && list[hi] < target) {
+        lo = hi + 1;
+        hi = from + step;
+        step <<= 1;
+    }
+    if (hi > length) hi = length;
+    while (lo < hi) {
+        uint32_t mid = lo + (hi - lo) / 2;
+        if (list[mid] < target) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// 질의의 트라이그램 목록을 짧은 것부터 교집합한 뒤 후보를 실제 문자열로 검증
+// 결과 번호 배열은 *matches에 할당되며 호출자가 해제
+int trigramQuery(const TrigramIndex *index, const PackageStore *store, const char *query, int **matches) {
+    size_t length = strlen(query);
+    *matches = NULL;
+
+    if (!index->offsets || index->documentCount != store->count) return -1;
+
+    int *result = (int *)malloc((store->count ? store->count : 1) * sizeof(int));
+    if (!result) return -1;
+    int count = 0;
+
+    // 트라이그램이 없는 짧은 질의는 전체 검사
+    if (length < 3) {
+        for (int i = 0; i < store->count; i++) {
+            if (packageMatches(&store->items[i], query)) result[count++] = i;
+        }
+        *matches = result;
+        return count;
+    }
+
+    size_t listCount = length - 2;
+    PostingList *lists = (PostingList *)malloc(listCount * sizeof(PostingList));
+    if (!lists) {
+        free(result);
+        return -1;
+    }
+
+    for (size_t i = 0; i < listCount; i++) {
+        uint32_t key = trigramKey(query + i);
+        lists[i].ids = index->postings + index->offsets[key];
+        lists[i].length = index->offsets[key + 1] - index->offsets[key];
+    }
+    qsort(lists, listCount, sizeof(PostingList), compareByLength);
+
+    uint32_t *cursors = (uint32_t *)calloc(listCount, sizeof(uint32_t));
+    if (!cursors) {
+        free(lists);
+        free(result);
+        return -1;
+    }
+
+    for (uint32_t i = 0; i < lists[0].length; i++) {
+        uint32_t candidate = lists[0].ids[i];
+        bool inAll = true;
+
+        for (size_t l = 1; l < listCount; l++) {
+            cursors[l] = gallop(lists[l].ids, lists[l].length, cursors[l], candidate);
+            if (cursors[l] >= lists[l].length) {
+                i = lists[0].length;  // 더 이상 교집합 불가
+                inAll = false;
+                break;
+            }
+            if (lists[l].ids[cursors[l]] != candidate) {
+                inAll = false;
+                break;
+            }
+        }
+
+        if (inAll && packageMatches(&store->items[candidate], query)) {
+            result[count++] = (int)candidate;
+        }
+    }
+
+    free(cursors);
+    free(lists);
+    *matches = result;
+    return count;
+}
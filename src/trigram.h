@@ -0,0 +1,23 @@
+#ifndef TRIGRAM_H
+#define TRIGRAM_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "package_store.h"
+
+// 이름·요약의 트라이그램 → 패키지 번호 목록 (CSR 형식 역색인)
+typedef struct TrigramIndex {
+    uint32_t *offsets;     // 키별 postings 시작 위치 (TRIGRAM_KEYS + 1개)
+    uint32_t *postings;    // 패키지 번호, 키마다 오름차순
+    size_t postingCount;
+    int documentCount;
+    double buildMs;
+} TrigramIndex;
+
+bool trigramBuild(TrigramIndex *index, const PackageStore *store);
+void trigramFree(TrigramIndex *index);
+int trigramQuery(const TrigramIndex *index, const PackageStore *store, const char *query, int **matches);
+size_t trigramBytes(const TrigramIndex *index);
+bool packageMatches(const Package *package, const char *query);
+
+#endif // TRIGRAM_H
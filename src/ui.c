@@ -1,50 +1,328 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
+#include <time.h>
 #include <sys/ioctl.h>
+#include <ncurses.h>
 #include "ui.h"
 #include "utils.h"
 #include "constants.h"
+#include "trigram.h"
+#include "config.h"
+#include "io_counter.h"
+#include "text_width.h"
+#include "job.h"
+#include "pager.h"
+#include "detail_cache.h"
+#include "prefetch.h"
+#include "detail_pool.h"
+#include "trace.h"
 
-void displayPackages(Package *p, int packageCount, int startIndex, int currentIndex) {
-    if (!p || packageCount <= 0) {
-        erase();
-        mvprintw(0, 0, "No packages to display.");
-        refresh();
+// 맨 아래 줄: 필터 입력 중이거나 필터가 적용된 경우, 설치/삭제 표시가 있는 경우 표시
+static void displayFooter(const PackageList *list) {
+    bool filtered = list->filtering || list->filterLength > 0;
+    bool fetching = poolActive();
+    if (!filtered && !fetching && list->installMarks == 0 && list->removeMarks == 0) return;
+
+    move(ROWS - 1, 0);
+    if (filtered) {
+        printw("/%s", list->filter);
+        if (list->filtering) {
+            printw("  (%d/%d)  ", list->viewCount, list->store->count);
+        } else {
+            printw("  (%d/%d, Esc to clear)  ", list->viewCount, list->store->count);
+        }
+    }
+    if (list->installMarks > 0 || list->removeMarks > 0) {
+        printw("[+%d -%d, c: review]  ", list->installMarks, list->removeMarks);
+    }
+    if (fetching) {
+        int done, total;
+        poolProgress(&done, &total);
+        printw("Fetching details: %d/%d", done, total);
+    }
+}
+
+// 직전 프레임 상태. 커서 이동·스크롤만 있으면 바뀐 줄만 다시 그림
+typedef struct FrameCache {
+    bool valid;
+    const PackageList *list;
+    unsigned version;
+    int rows, cols;
+    int visible;          // 목록 영역 줄 수 (작업 출력 창이 보이면 줄어듦)
+    unsigned jobVersion;
+    int startIndex, currIndex;
+    int nameWidth, versionWidth;
+    char *lines;          // 목록 영역 각 줄의 내용 (rows * lineBytes(cols))
+    size_t lastBytes;     // 직전 프레임에서 터미널로 보낸 바이트
+} FrameCache;
+
+static FrameCache frame;
+
+// 다른 화면이 터미널을 덮어쓴 뒤에는 전체를 다시 그리도록 표시
+void invalidateFrame(void) {
+    frame.valid = false;
+}
+
+void freeFrameCache(void) {
+    free(frame.lines);
+    memset(&frame, 0, sizeof(frame));
+}
+
+// UTF-8 한 글자는 최대 4바이트이므로 줄 버퍼는 칸 수의 4배
+static size_t lineBytes(int cols) {
+    return (size_t)cols * 4 + 1;
+}
+
+static char *frameLine(int row) {
+    return frame.lines + (size_t)row * lineBytes(frame.cols);
+}
+
+static int padding(int columnWidth, int textWidth) {
+    return columnWidth > textWidth ? columnWidth - textWidth : 0;
+}
+
+static void formatRow(const PackageList *list, int index, char *line) {
+    const Package *package = listAt(list, index);
+    size_t size = lineBytes(COLS);
+    int maxDescLen = COLS - frame.nameWidth - frame.versionWidth - 4;
+
+    if (!package) {
+        line[0] = '\0';
         return;
     }
 
+    // 첫 열: 설치 여부, 둘째 열: 설치(+)/삭제(-) 표시. 폭은 바이트가 아니라 미리 계산한 표시 폭 기준
+    int length = snprintf(line, size, "%c%c%s%*s %s%*s ",
+                          (package->flags & PKG_INSTALLED) ? 'i' : ' ',
+                          (package->flags & PKG_MARK_INSTALL) ? '+' : (package->flags & PKG_MARK_REMOVE) ? '-' : ' ',
+                          package->name, padding(frame.nameWidth, package->nameWidth), "",
+                          package->version, padding(frame.versionWidth, package->versionWidth), "");
+    if (length < 0 || (size_t)length + 2 >= size || maxDescLen <= 0) return;
+
+    size_t descBytes = textFit(package->description, maxDescLen, NULL);
+    bool truncated = package->description[descBytes] != '\0';
+    if (truncated) descBytes = textFit(package->description, maxDescLen - 1, NULL);
+    if (descBytes > size - length - 2) descBytes = size - length - 2;
+
+    memcpy(line + length, package->description, descBytes);
+    length += descBytes;
+    if (truncated) line[length++] = '>';
+    line[length] = '\0';
+}
+
+// 캐시된 내용으로 목록의 row번째 줄을 다시 출력
+static void paintRow(int row, bool highlight) {
+    move(2 + row, 0);
+    clrtoeol();
+    printLine(frameLine(row), 2 + row, highlight);
+}
+
+static void displayFrameBytes(void) {
+    if (!config.showFrameStats) return;
+
+    char stats[32];
+    int length = snprintf(stats, sizeof(stats), " %8zu B/frame ", frame.lastBytes);
+    mvprintw(ROWS - 1, COLS - length - 1, "%s", stats);
+}
+
+static void redrawAll(const PackageList *list, int visible) {
+    const PackageStore *store = list->store;
+
     erase();
 
-    int maxNameLen, maxVersionLen;
-    getMaxLen(p, packageCount, &maxNameLen, &maxVersionLen);
-    int maxDescLen = COLS - maxNameLen - maxVersionLen - 2;
+    // 열 너비는 저장소가 적재·추가 시점에 유지하므로 프레임마다 전체를 훑지 않음
+    frame.nameWidth = store->layout.nameWidth;
+    frame.versionWidth = store->layout.versionWidth;
+    int maxDescLen = COLS - frame.nameWidth - frame.versionWidth - 4;
 
     char header[COLS + 1];
-    snprintf(header, sizeof(header), "%-*s %-*s %-.*s", 
-             maxNameLen, "Package", 
-             maxVersionLen, "Version", 
-             maxDescLen, "Description");
+    snprintf(header, sizeof(header), "  %-*s %-*s %-.*s", 
+             frame.nameWidth, "Package", 
+             frame.versionWidth, "Version", 
+             maxDescLen > 0 ? maxDescLen : 0, "Description");
     printLine(header, 0, false);
     mvhline(1, 0, '-', COLS);
 
-    int endIndex = startIndex + ROWS - 3;
-    if (endIndex > packageCount) endIndex = packageCount;
+    for (int row = 0; row < visible; row++) {
+        int index = list->startIndex + row;
+        formatRow(list, index, frameLine(row));
+        if (index < list->viewCount) {
+            printLine(frameLine(row), 2 + row, index == list->currIndex);
+        }
+    }
+
+    displayFooter(list);
+}
+
+// 시작 위치가 delta 만큼 바뀐 경우 스크롤 영역을 밀고 새로 드러난 줄만 그림
+static void scrollRows(const PackageList *list, int visible, int delta) {
+    size_t stride = lineBytes(frame.cols);
 
-    for (int i = startIndex; i < endIndex; i++) {
-        char line[COLS + 1];
-        snprintf(line, sizeof(line), "%-*s %-*s ", 
-                 maxNameLen, p[i].name, 
-                 maxVersionLen, p[i].version);
-        strncat(line, p[i].description, maxDescLen);
+    setscrreg(2, 2 + visible - 1);
+    scrollok(stdscr, TRUE);
+    scrl(delta);
+    scrollok(stdscr, FALSE);
+    setscrreg(0, ROWS - 1);
 
-        if (strlen(p[i].description) > (size_t)maxDescLen) {
-            line[COLS - 1] = '>';
+    if (delta > 0) {
+        memmove(frame.lines, frameLine(delta), (visible - delta) * stride);
+        for (int row = visible - delta; row < visible; row++) {
+            formatRow(list, list->startIndex + row, frameLine(row));
+            paintRow(row, false);
+        }
+    } else {
+        memmove(frameLine(-delta), frame.lines, (visible + delta) * stride);
+        for (int row = 0; row < -delta; row++) {
+            formatRow(list, list->startIndex + row, frameLine(row));
+            paintRow(row, false);
         }
-        printLine(line, 2 + (i - startIndex), i == currentIndex);
     }
+}
 
+// 작업 출력 창 높이 (제목 줄 포함). 목록이 최소 절반은 보이도록 제한
+static int jobPaneRows(void) {
+    if (!jobPaneVisible()) return 0;
+
+    int rows = JOB_PANE_ROWS;
+    if (rows > (ROWS - 3) / 2) rows = (ROWS - 3) / 2;
+    return rows;
+}
+
+int listVisibleRows(void) {
+    return ROWS - 3 - jobPaneRows();
+}
+
+// 작업 출력 창: 상태 제목 줄 아래에 마지막 출력 줄들
+static void displayJobPane(int top, int rows) {
+    static const char *const stateNames[] = {"", "running", "done", "failed", "cancelled"};
+    const Job *job = jobCurrent();
+    char title[BUFFER_SIZE];
+
+    if (!job || rows <= 0) return;
+
+    int length = snprintf(title, sizeof(title), " [%s] %s", stateNames[job->state], job->title);
+    if (job->state == JOB_FAILED && length < (int)sizeof(title)) {
+        length += snprintf(title + length, sizeof(title) - length, " (exit %d)", job->exitStatus);
+    }
+    if (length < (int)sizeof(title)) {
+        const char *keys = job->inputFocus ? "   typing into job, Tab/Esc: back"
+                         : job->state == JOB_RUNNING ? "   x: cancel  Tab: input  o: hide"
+                         : "   o: hide";
+        snprintf(title + length, sizeof(title) - length, "%s", keys);
+    }
+
+    attron(COLOR_PAIR(1));
+    mvhline(top, 0, ' ', COLS);
+    mvaddnstr(top, 0, title, (int)textFit(title, COLS, NULL));
+    attroff(COLOR_PAIR(1));
+
+    // 마지막 개행 뒤의 빈 줄은 세지 않음
+    int lineCount = job->lineCount;
+    if (lineCount > 0 && jobLine(lineCount - 1)[0] == '\0') lineCount--;
+
+    int outputRows = rows - 1;
+    int first = lineCount > outputRows ? lineCount - outputRows : 0;
+    for (int row = 0; row < outputRows; row++) {
+        move(top + 1 + row, 0);
+        clrtoeol();
+        if (first + row < lineCount) {
+            const char *line = jobLine(first + row);
+            addnstr(line, (int)textFit(line, COLS - 1, NULL));
+        }
+    }
+}
+
+// 구간별 소요 시간 (T 키로 켜고 끔). 목록 오른쪽 위에 겹쳐 그리므로 프레임마다 다시 그림
+static void displayTraceOverlay(void) {
+    TraceStat stats[TRACE_MAX_NAMES];
+    int count = traceSnapshot(stats, TRACE_MAX_NAMES);
+    int width = COLS < TRACE_OVERLAY_WIDTH ? COLS : TRACE_OVERLAY_WIDTH;
+    int x = COLS - width;
+    char line[BUFFER_SIZE];
+
+    attron(A_REVERSE);
+    snprintf(line, sizeof(line), " %-24s %7s %8s %8s", "span (T: hide)", "count", "avg ms", "max ms");
+    mvprintw(HEADER_LINES, x, "%-*.*s", width, width, line);
+    for (int i = 0; i < count && HEADER_LINES + 1 + i < ROWS - FOOTER_LINES; i++) {
+        snprintf(line, sizeof(line), " %-24.24s %7lu %8.2f %8.2f", stats[i].name, stats[i].count,
+                 stats[i].totalUs / 1000.0 / stats[i].count, stats[i].maxUs / 1000.0);
+        mvprintw(HEADER_LINES + 1 + i, x, "%-*.*s", width, width, line);
+    }
+    if (count == 0) {
+        mvprintw(HEADER_LINES + 1, x, "%-*.*s", width, width, " (nothing recorded yet)");
+    }
+    attroff(A_REVERSE);
+}
+
+static void drawPackages(const PackageList *list) {
+    const PackageStore *store = list->store;
+    int visible = listVisibleRows();
+    size_t before = config.showFrameStats ? threadBytesWritten() : 0;
+
+    if (!store->items || store->count <= 0) {
+        erase();
+        mvprintw(0, 0, "No packages to display.");
+        refresh();
+        invalidateFrame();
+        return;
+    }
+
+    bool reusable = frame.valid && frame.list == list && frame.version == list->version
+                 && frame.rows == ROWS && frame.cols == COLS && frame.visible == visible;
+
+    if (!reusable) {
+        if (!frame.lines || frame.rows != ROWS || frame.cols != COLS) {
+            free(frame.lines);
+            frame.lines = (char *)calloc((size_t)(ROWS - 3) * lineBytes(COLS), 1);
+            frame.rows = ROWS;
+            frame.cols = COLS;
+            if (!frame.lines) return;
+        }
+        redrawAll(list, visible);
+    } else {
+        int delta = list->startIndex - frame.startIndex;
+
+        if (delta != 0 && abs(delta) < visible) {
+            scrollRows(list, visible, delta);
+        } else if (delta != 0) {
+            redrawAll(list, visible);
+            reusable = false;
+        }
+
+        // 이전 커서 줄의 강조를 지우고 새 커서 줄을 강조
+        if (reusable) {
+            int prevRow = frame.currIndex - list->startIndex;
+            int currRow = list->currIndex - list->startIndex;
+            if (prevRow >= 0 && prevRow < visible && prevRow != currRow) paintRow(prevRow, false);
+            if (currRow >= 0 && currRow < visible) paintRow(currRow, true);
+        }
+    }
+
+    const Job *job = jobCurrent();
+    if (job && (!reusable || job->version != frame.jobVersion)) {
+        displayJobPane(2 + visible, jobPaneRows());
+        frame.jobVersion = job->version;
+    }
+
+    frame.valid = true;
+    frame.list = list;
+    frame.visible = visible;
+    frame.version = list->version;
+    frame.startIndex = list->startIndex;
+    frame.currIndex = list->currIndex;
+
+    if (traceOverlayVisible()) displayTraceOverlay();
+    displayFrameBytes();
+    if (list->filtering) move(ROWS - 1, 1 + list->filterLength);
     refresh();
+    if (config.showFrameStats) frame.lastBytes = threadBytesWritten() - before;
+}
+
+void displayPackages(const PackageList *list) {
+    uint64_t start = traceBegin();
+    drawPackages(list);
+    traceEnd("displayPackages", start);
 }
 
 void displayPackagesDetail(Package *package) {
@@ -70,69 +348,161 @@ void displayPackagesDetail(Package *package) {
         return;
     }
 
-    mvprintw(0, 0, "Package Details");
-    mvhline(1, 0, '-', COLS);
-
-    char command[COMMAND_SIZE];
-    snprintf(command, sizeof(command), "apt-cache show %s", package->name);
+    // 출력 전체를 버퍼 하나에 받고 줄 나눔은 그릴 때 화면 폭에 맞춰 계산 (같은 이름·버전은 캐시에서)
+    TextBuffer scratch;
+    textInit(&scratch);
 
-    FILE *fp = popen(command, "r");
-    if (fp == NULL) {
+    const TextBuffer *text = packageDetails(package->name, package->version, &scratch);
+    if (!text) {
+        textFree(&scratch);
+        mvprintw(0, 0, "Package Details");
+        mvhline(1, 0, '-', COLS);
         mvprintw(4, 0, "Failed to retrieve package details.");
-        mvprintw(6, 0, "Press 'q' to return to the package list.");
+        mvprintw(ROWS - 1, 0, "Press any key to return.");
         refresh();
+        getch();
+        clear();
         return;
     }
 
-    char buffer[BUFFER_SIZE];
-    char lines[MAX_LINES][BUFFER_SIZE];
-    int lineCount = 0;
-
-    while (fgets(buffer, sizeof(buffer), fp) != NULL && lineCount < MAX_LINES) {
-        size_t len = strlen(buffer);
-        if ((int)len > COLS) {
-            int start = 0;
-            while (start < (int)len) {
-                strncpy(lines[lineCount], &buffer[start], COLS - 1);
-                lines[lineCount][COLS - 1] = '\0';
-                lineCount++;
-                start += COLS - 1;
-                if (lineCount >= MAX_LINES) break;
-            }
+    char title[BUFFER_SIZE];
+    int length = snprintf(title, sizeof(title), "Package Details: %s", package->name);
+    if (config.showFrameStats) {
+        DetailCacheStats stats;
+        detailCacheStats(&stats);
+        unsigned long fetched, discarded;
+        prefetchStats(&fetched, &discarded);
+        snprintf(title + length, sizeof(title) - length,
+                 "   [cache %lu hits / %lu misses, %zu KB, prefetched %lu, dropped %lu]",
+                 stats.hits, stats.misses, stats.bytes / 1024, fetched, discarded);
+    }
+    pagerShow(title, text);
+    textFree(&scratch);
+}
+
+// 설치/삭제 표시 목록을 보여주고 적용 여부를 물음 (REVIEW_* 반환)
+// 삭제 영향의 한 줄: 함께 삭제되는 패키지와 그것을 깨뜨리는 패키지
+static void printImpactRow(int y, const char *label, const DepGraph *graph, const DepImpact *impact, int index) {
+    const Package *node = &graph->nodes.items[impact->removed[index]];
+    bool essential = graph->nodeFlags[impact->removed[index]] & DEP_NODE_ESSENTIAL;
+
+    mvprintw(y, 0, "  %-8s %s %s  (needs %s)%s", label, node->name, node->version,
+             graph->nodes.items[impact->causes[index]].name, essential ? "  [essential]" : "");
+}
+
+// 표시한 설치·삭제와, 표시한 삭제 때문에 함께 삭제되는 패키지 (impact가 NULL이면 의존 정보 없음)
+int reviewMarks(const PackageList *list, const DepGraph *graph, const DepImpact *impact) {
+    const PackageStore *store = list->store;
+    int total = list->installMarks + list->removeMarks;
+    const Package **marked = (const Package **)malloc((total > 0 ? total : 1) * sizeof(Package *));
+    int count = 0;
+    int extra = graph && impact ? impact->count - impact->requested : 0;
+
+    if (!marked) return REVIEW_BACK;
+
+    // 설치 항목을 먼저, 그다음 삭제 항목
+    for (int pass = 0; pass < 2; pass++) {
+        unsigned int mark = pass == 0 ? PKG_MARK_INSTALL : PKG_MARK_REMOVE;
+        for (int i = 0; i < store->count && count < total; i++) {
+            if (store->items[i].flags & mark) marked[count++] = &store->items[i];
+        }
+    }
+
+    int offset = 0;
+    int result = REVIEW_BACK;
+    int rows = count + extra;
+
+    while (true) {
+        int displayLines = ROWS - 3;
+
+        erase();
+        if (extra > 0) {
+            mvprintw(0, 0, "Pending changes: %d to install, %d to remove, %d more removed as dependents",
+                     list->installMarks, list->removeMarks, extra);
         } else {
-            strncpy(lines[lineCount++], buffer, sizeof(buffer));
+            mvprintw(0, 0, "Pending changes: %d to install, %d to remove", list->installMarks, list->removeMarks);
+        }
+        mvhline(1, 0, '-', COLS);
+
+        for (int i = 0; i < displayLines && offset + i < rows; i++) {
+            int row = offset + i;
+            if (row >= count) {
+                printImpactRow(2 + i, "also", graph, impact, impact->requested + row - count);
+                continue;
+            }
+            const Package *package = marked[row];
+            mvprintw(2 + i, 0, "  %-8s %s %s",
+                     (package->flags & PKG_MARK_INSTALL) ? "install" : "remove",
+                     package->name, package->version);
+        }
+
+        mvprintw(ROWS - 1, 0, "y: apply in one apt-get run   C: clear all marks   q: back");
+        refresh();
+
+        int ch = getch();
+        if (ch == 'y') {
+            result = REVIEW_APPLY;
+            break;
+        } else if (ch == 'C') {
+            result = REVIEW_CLEAR;
+            break;
+        } else if (ch == 'q' || ch == KEY_ESCAPE) {
+            break;
+        } else if (ch == 'j' && offset + displayLines < rows) {
+            offset++;
+        } else if (ch == 'k' && offset > 0) {
+            offset--;
         }
     }
 
-    pclose(fp);
+    clear();
+    free(marked);
+    return result;
+}
 
+// 'd'로 삭제하기 전에 함께 삭제될 패키지를 보여 줌 (graph가 NULL이면 의존 정보 없이 확인만)
+int reviewRemoval(const Package *package, const DepGraph *graph, const DepImpact *impact) {
+    int extra = graph ? impact->count - impact->requested : 0;
     int offset = 0;
-    int ch;
+    int result = REVIEW_BACK;
 
     while (true) {
-        erase();
+        int displayLines = ROWS - 5;
 
-        mvprintw(0, 0, "Package Details");
+        erase();
+        mvprintw(0, 0, "Remove %s %s", package->name, package->version);
         mvhline(1, 0, '-', COLS);
 
-        int displayLines = ROWS - 3;
-        for (int i = 0; i < displayLines && offset + i < lineCount; i++) {
-            mvprintw(2 + i, 0, "%s", lines[offset + i]);
+        if (!graph) {
+            mvprintw(2, 0, "Dependency information is unavailable; apt-get decides what else is removed.");
+        } else if (extra == 0) {
+            mvprintw(2, 0, "No other installed package depends on %s.", package->name);
+        } else {
+            mvprintw(2, 0, "Also removes %d package%s that depend%s on it (computed in %.0f us):",
+                     extra, extra == 1 ? "" : "s", extra == 1 ? "s" : "", impact->elapsedUs);
+            for (int i = 0; i < displayLines && offset + i < extra; i++) {
+                printImpactRow(4 + i, "also", graph, impact, impact->requested + offset + i);
+            }
         }
 
-        mvprintw(ROWS - 1, 0, "Press 'q' to return");
+        mvprintw(ROWS - 1, 0, "y: remove   j/k: scroll   q: cancel");
         refresh();
 
-        ch = getch();
-        if (ch == 'q') {
-            clear();
+        int ch = getch();
+        if (ch == 'y') {
+            result = REVIEW_APPLY;
+            break;
+        } else if (ch == 'q' || ch == 'n' || ch == KEY_ESCAPE) {
             break;
-        } else if (ch == 'j' && offset + displayLines < lineCount) {
+        } else if (ch == 'j' && offset + displayLines < extra) {
             offset++;
         } else if (ch == 'k' && offset > 0) {
             offset--;
         }
     }
+
+    clear();
+    return result;
 }
 
 void printHelp() {
@@ -142,22 +512,178 @@ void printHelp() {
     printf("\nOptions:\n");
     printf("  -help, --help        Show this help message and exit.\n");
     printf("  -U, --auto-update    Run system update & upgrade on startup (requires sudo).\n");
+    printf("  --status-file PATH   Read installed packages from PATH (default: %s).\n", DPKG_STATUS_PATH);
+    printf("  --lists-dir DIR      Search apt Packages indexes in DIR (default: %s).\n", APT_LISTS_DIR);
+    printf("  --dpkg-query         Load packages through dpkg-query instead of the built-in parser.\n");
+    printf("  --no-cache           Ignore and do not write the installed-package snapshot cache.\n");
+    printf("  --apt-get PATH       Run PATH instead of apt-get for install/remove/update (e.g. a stand-in script).\n");
+    printf("  --no-sudo            Run apt-get directly instead of through sudo.\n");
+    printf("  --detail-cache MB    Memory cap of the package detail cache (default: %d, 0 disables it).\n", DETAIL_CACHE_DEFAULT_MB);
+    printf("  --helper-path PATH   Run PATH --helper as the detail helper process (default: this program).\n");
+    printf("  --no-helper          Run apt-cache show once per detail request instead of through the helper.\n");
+    printf("  --prefetch N         Fetch details of N rows above and below the cursor in the background (default: %d, 0 disables it).\n", PREFETCH_WINDOW);
+    printf("  --jobs N             Fetch search result details with N parallel workers (default: %d, max %d).\n", SEARCH_JOBS, SEARCH_JOBS_MAX);
+    printf("  --frame-stats        Show the bytes sent to the terminal for each list frame.\n");
+    printf("  --trace FILE         Write timings of loading, drawing, searching and apt calls to FILE (Chrome trace JSON).\n");
+    printf("  --stats              Print package store, search index and dependency graph statistics and exit.\n");
+    printf("  --extended-states PATH  Read apt's automatically-installed marks from PATH (default: %s).\n", APT_EXTENDED_STATES_PATH);
+    printf("  --preferences PATH   Read apt pins from PATH and PATH.d/ for candidate versions (default: %s).\n", APT_PREFERENCES_PATH);
+    printf("  --arch ARCH          Take candidate versions from ARCH and 'all' packages only (default: %s).\n",
+           NATIVE_ARCHITECTURE ? NATIVE_ARCHITECTURE : "any");
+    printf("  --list               Print installed packages and exit.\n");
+    printf("  --search QUERY       Print packages whose name or summary contains QUERY and exit.\n");
+    printf("  --show PKG...        Print the apt-cache show fields of each PKG and exit.\n");
+    printf("  --install PKG...     Run apt-get install -y PKG... without the UI and print the resulting states.\n");
+    printf("  --format tsv|json    Output of the commands above: tab-separated columns (default) or one JSON object per line.\n");
     printf("\nKeyboard Shortcuts:\n");
     printf("  j        Move down the package list.\n");
     printf("  k        Move up the package list.\n");
     printf("  G        Jump to the bottom of the list.\n");
     printf("  gg       Jump to the top of the list.\n");
     printf("  i        Install the selected package.\n");
-    printf("  d        Remove the selected package.\n");
+    printf("  d        Remove the selected package (shows what else its removal takes first).\n");
+    printf("  w        Show why the selected package is installed and what depends on it.\n");
     printf("  u        Update and upgrade the system (sudo prompt when pressed).\n");
-    printf("  /        Search for a package.\n");
+    printf("  U        List packages with a newer version in the apt lists (i upgrades one).\n");
+    printf("  +        Mark the selected package for installation (again to unmark).\n");
+    printf("  -        Mark the selected package for removal (again to unmark).\n");
+    printf("  c        Review the marks and apply them in a single apt-get run.\n");
+    printf("  o        Show or hide the job output pane.\n");
+    printf("  x        Cancel the running job (press again to terminate it).\n");
+    printf("  Tab      Type into the running job (e.g. the sudo password); Tab/Esc to return.\n");
+    printf("  /        Filter the list as you type (Enter keeps the filter, Esc clears it).\n");
+    printf("  :        Jump to a package by exact name.\n");
+    printf("  s        Search the package archive (ranked by name and description words).\n");
     printf("  Enter    Show details of the selected package.\n");
-    printf("  q        Quit the program.\n");
+    printf("  T        Show or hide the timing overlay (time spent per traced span).\n");
+    printf("  q        Quit the program (waits for a running job).\n");
     printf("\nExample:\n");
     printf("  ./package_manager              Launch the program.\n");
     printf("  ./package_manager -help        Show this help message.\n");
 }
 
+void printStats(const PackageStore *store) {
+    size_t used = storeBytesUsed(store);
+    size_t legacy = storeLegacyBytes(store);
+
+    printf("packages:         %d\n", store->count);
+    printf("arena used:       %zu bytes\n", store->arena.bytesUsed);
+    printf("arena reserved:   %zu bytes\n", store->arena.bytesReserved);
+    printf("snapshot mapped:  %zu bytes\n", store->mappingSize);
+    printf("interned strings: %zu (%zu reused)\n", store->interned.count, store->internHits);
+    printf("store total:      %zu bytes\n", used);
+    printf("strdup layout:    %zu bytes (estimated)\n", legacy);
+}
+
+static double nowMs(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e3 + ts.tv_nsec / 1e6;
+}
+
+// 검색 색인 구성 비용과 질의 지연 시간 (트라이그램 대 선형 검사) 출력
+void printSearchStats(void) {
+    static const char *probes[] = { "lib", "python", "editor", "xml", "server", "gtk3", "zzzq" };
+    const int repeat = 20;
+    const AptIndex *index = getSearchIndex();
+    const PackageStore *packages = &index->packages;
+
+    printf("list packages:    %d\n", packages->count);
+    if (packages->count == 0) return;
+    printf("trigram build:    %.2f ms\n", index->trigrams.buildMs);
+    printf("trigram memory:   %zu bytes (%zu postings)\n",
+           trigramBytes(&index->trigrams), index->trigrams.postingCount);
+
+    for (size_t q = 0; q < sizeof(probes) / sizeof(probes[0]); q++) {
+        int *matches = NULL;
+        int hits = 0, linearHits = 0;
+
+        double start = nowMs();
+        for (int r = 0; r < repeat; r++) {
+            free(matches);
+            hits = trigramQuery(&index->trigrams, packages, probes[q], &matches);
+        }
+        double indexed = (nowMs() - start) / repeat;
+        free(matches);
+
+        start = nowMs();
+        for (int r = 0; r < repeat; r++) {
+            linearHits = 0;
+            for (int i = 0; i < packages->count; i++) {
+                if (packageMatches(&packages->items[i], probes[q])) linearHits++;
+            }
+        }
+        double linear = (nowMs() - start) / repeat;
+
+        printf("query %-10s  %6d hits  trigram %8.3f ms  linear %8.3f ms%s\n",
+               probes[q], hits, indexed, linear, hits == linearHits ? "" : "  (MISMATCH)");
+    }
+
+    const FullTextIndex *text = &index->text;
+    if (!text->postings) {
+        printf("full-text index:  unavailable\n");
+        return;
+    }
+    printf("full-text %s:   %.2f ms\n", text->mapping ? "load " : "build", text->buildMs);
+    printf("full-text memory: %zu bytes (%u terms, %u postings, avg length %.1f)\n",
+           fullTextBytes(text), text->termCount, text->postingCount, text->averageLength);
+
+    static const char *rankedProbes[] = { "python", "text editor", "compression library", "network daemon", "zzzq" };
+    FullTextHit hits[FULLTEXT_TOP_K];
+    for (size_t q = 0; q < sizeof(rankedProbes) / sizeof(rankedProbes[0]); q++) {
+        int count = 0;
+        double start = nowMs();
+        for (int r = 0; r < repeat; r++) {
+            count = fullTextQuery(text, rankedProbes[q], hits, FULLTEXT_TOP_K);
+        }
+        double elapsed = (nowMs() - start) / repeat;
+        printf("ranked %-20s  top %3d  %8.3f ms%s%s\n", rankedProbes[q], count, elapsed,
+               count > 0 ? "  first " : "", count > 0 ? packages->items[hits[0].document].name : "");
+    }
+}
+
+// 의존 관계 그래프 구성 비용과 삭제 영향·설치 이유 질의 지연 시간 (노드를 고르게 골라 측정)
+void printDependencyStats(void) {
+    const DepGraph *graph = getDependencyGraph();
+    if (!graph) {
+        printf("dependency graph: unavailable (%s)\n", config.statusPath);
+        return;
+    }
+
+    int nodeCount = graph->nodes.count;
+    printf("graph nodes:      %d (%s)\n", nodeCount, graph->autoKnown ? "auto-installed marks loaded" : "no extended_states");
+    printf("graph groups:     %u (%u alternatives)\n", graph->groupCount, graph->targetCount);
+    printf("graph build:      %.2f ms\n", graph->buildMs);
+    printf("graph memory:     %zu bytes\n", depGraphBytes(graph));
+    if (nodeCount == 0) return;
+
+    int step = nodeCount > DEP_STATS_SAMPLES ? nodeCount / DEP_STATS_SAMPLES : 1;
+    int samples = 0, largest = 0, largestNode = 0;
+    double impactTotal = 0, impactMax = 0, whyTotal = 0;
+    int path[DEP_WHY_PATH_MAX];
+
+    for (int node = 0; node < nodeCount; node += step, samples++) {
+        DepImpact impact;
+        if (!depGraphRemovalImpact(graph, &node, 1, &impact)) break;
+        impactTotal += impact.elapsedUs;
+        if (impact.elapsedUs > impactMax) impactMax = impact.elapsedUs;
+        if (impact.count > largest) {
+            largest = impact.count;
+            largestNode = node;
+        }
+        depImpactFree(&impact);
+
+        double start = nowMs();
+        depGraphWhy(graph, node, path, DEP_WHY_PATH_MAX);
+        whyTotal += nowMs() - start;
+    }
+    if (samples == 0) return;
+
+    printf("removal impact:   avg %.1f us, max %.1f us over %d packages (largest: %s, %d removed)\n",
+           impactTotal / samples, impactMax, samples, graph->nodes.items[largestNode].name, largest);
+    printf("why installed:    avg %.1f us\n", whyTotal * 1e3 / samples);
+}
+
 void printLine(const char *line, int row, bool highlight) {
     if (highlight) attron(COLOR_PAIR(1));
     mvprintw(row, 0, "%s", line);
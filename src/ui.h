@@ -3,10 +3,20 @@
 
 #include <stdbool.h>
 #include "package_manager.h"
+#include "package_list.h"
+#include "dep_graph.h"
 
-void displayPackages(Package *p, int packageCount, int startIndex, int currentIndex);
+void displayPackages(const PackageList *list);
+int listVisibleRows(void);
+void invalidateFrame(void);
+void freeFrameCache(void);
 void displayPackagesDetail(Package *package);
+int reviewMarks(const PackageList *list, const DepGraph *graph, const DepImpact *impact);
+int reviewRemoval(const Package *package, const DepGraph *graph, const DepImpact *impact);
 void printHelp(void);
+void printStats(const PackageStore *store);
+void printSearchStats(void);
+void printDependencyStats(void);
 void printLine(const char *line, int row, bool highlight);
 
 #endif // UI_H
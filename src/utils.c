@@ -1,11 +1,23 @@
 #include <ncurses.h>
 #include <sys/ioctl.h>
+#include <poll.h>
+#include <unistd.h>
+#include <time.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include <stdio.h>
 #include "utils.h"
 #include "ui.h"
 #include "constants.h"
+#include "io_counter.h"
+#include "job.h"
+#include "watcher.h"
+#include "detail_cache.h"
+#include "prefetch.h"
+#include "detail_pool.h"
+#include "trace.h"
+#include "helper.h"
 
 int ROWS, COLS;
 static struct winsize w;
@@ -25,11 +37,42 @@ bool isValidPackageName(const char *name) {
     return true;
 }
 
+// 검색어 검증: 패키지 이름에 허용되는 문자와 단어를 나누는 공백 (apt search에는 단어별 인자로 넘어감)
+bool isValidSearchQuery(const char *query) {
+    bool hasWord = false;
+
+    if (!query || strlen(query) > MAX_PACKAGE_NAME_LENGTH) return false;
+    for (int i = 0; query[i]; i++) {
+        char c = query[i];
+        if (c == ' ') continue;
+        if (!isalnum(c) && c != '-' && c != '.' && c != '_' && c != '+' && c != ':') return false;
+        hasWord = true;
+    }
+    return hasWord;
+}
+
+// 데비안 버전 문자열 검증 (apt-cache show 이름=버전 인자에 사용)
+bool isValidVersion(const char *version) {
+    if (!version || strlen(version) == 0 || strlen(version) > MAX_PACKAGE_NAME_LENGTH) {
+        return false;
+    }
+
+    for (int i = 0; version[i]; i++) {
+        char c = version[i];
+        // 버전에 허용되는 문자만: 영문, 숫자, 점, 플러스, 하이픈, 물결표, 콜론
+        if (!isalnum(c) && c != '.' && c != '+' && c != '-' && c != '~' && c != ':') {
+            return false;
+        }
+    }
+    return true;
+}
+
 void init() {
     initscr();
     noecho();
     cbreak();
     keypad(stdscr, TRUE);
+    set_escdelay(ESCAPE_DELAY_MS);
     start_color();
     use_default_colors();
     init_pair(1, COLOR_BLACK, COLOR_WHITE);
@@ -52,8 +95,24 @@ void init() {
     refresh();
 }
 
-void deinit(Package *p, int packageCount) {
-    freePackages(p, packageCount);
+// KEY_RESIZE를 받은 뒤 ROWS/COLS를 새 화면 크기로 맞춤
+void updateScreenSize(void) {
+    getmaxyx(stdscr, ROWS, COLS);
+}
+
+void deinit(PackageStore *store) {
+    storeFree(store);
+    freeSearchIndex();
+    freeDependencyGraph();
+    freeFrameCache();
+    closeIoCounter();
+    jobShutdown();
+    watcherStop();
+    prefetchStop();
+    poolStop();
+    helperStop(NULL);
+    detailCacheFree();
+    traceClose();
     endwin();
 }
 
@@ -68,61 +127,259 @@ void safeFree(char **ptr) {
     }
 }
 
-void getMaxLen(Package *p, int packageCount, int *maxNameLen, int *maxVersionLen) {
-    *maxNameLen = *maxVersionLen = 0;
+// 필터 입력 모드의 키 처리: 입력할 때마다 목록을 다시 거름
+static void filterInput(PackageList *list, int ch) {
+    char filter[FILTER_QUERY_SIZE];
+    snprintf(filter, sizeof(filter), "%s", list->filter);
+    size_t length = strlen(filter);
 
-    for (int i = 0; i < packageCount; i++) {
-        int nameLen = strlen(p[i].name);
-        int versionLen = strlen(p[i].version);
+    if (ch != KEY_UP && ch != KEY_DOWN) {
+        invalidateFrame();
+    }
 
-        if (nameLen > *maxNameLen) *maxNameLen = nameLen;
-        if (versionLen > *maxVersionLen) *maxVersionLen = versionLen;
+    switch (ch) {
+        case '\n':
+            list->filtering = false;
+            return;
+        case KEY_ESCAPE:
+            list->filtering = false;
+            listSetFilter(list, "");
+            return;
+        case KEY_UP:
+            if (list->currIndex > 0) list->currIndex--;
+            return;
+        case KEY_DOWN:
+            if (list->currIndex < list->viewCount - 1) list->currIndex++;
+            return;
+        case KEY_BACKSPACE:
+        case 127:
+        case '\b':
+            if (length == 0) {
+                list->filtering = false;
+                return;
+            }
+            filter[length - 1] = '\0';
+            break;
+        default:
+            if (ch < 32 || ch > 126 || length >= sizeof(filter) - 1) return;
+            filter[length] = (char)ch;
+            filter[length + 1] = '\0';
+            break;
     }
+    listSetFilter(list, filter);
 }
 
-void keyInput(int *currIndex, int *startIndex, int *prevCh, int *exitFlag, int packageCount, Package *p) {
-    if (!currIndex || !startIndex || !prevCh || !exitFlag || !p) {
+// 키 입력 대신 작업 출력이 도착했거나 설치 목록·검색 결과를 갱신했음을 알리는 값 (화면만 다시 그림)
+#define KEY_JOB_UPDATE (KEY_MAX + 1)
+#define KEY_INVENTORY_UPDATE (KEY_MAX + 2)
+#define KEY_RESULTS_UPDATE (KEY_MAX + 3)
+
+static long long monotonicMs(void) {
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (long long)now.tv_sec * 1000 + now.tv_nsec / 1000000;
+}
+
+// 키 입력을 기다리는 동안 실행 중인 작업의 출력과 dpkg status 변경도 함께 감시
+static int readKey(void) {
+    static long long refreshDue = 0;
+
+    for (;;) {
+        int jobFd = jobPollFd();
+        int watchFd = watcherFd();
+        int prefetchPipe = prefetchFd();
+        int poolPipe = poolFd();
+        if (jobFd < 0 && watchFd < 0 && prefetchPipe < 0 && poolPipe < 0) return getch();
+
+        // ncurses가 이미 읽어 둔 입력이 있으면 poll보다 먼저 처리
+        nodelay(stdscr, TRUE);
+        int ch = getch();
+        nodelay(stdscr, FALSE);
+        if (ch != ERR) return ch;
+
+        struct pollfd fds[5] = { { .fd = STDIN_FILENO, .events = POLLIN } };
+        int count = 1;
+        if (jobFd >= 0) fds[count++] = (struct pollfd){ .fd = jobFd, .events = POLLIN };
+        if (watchFd >= 0) fds[count++] = (struct pollfd){ .fd = watchFd, .events = POLLIN };
+        if (prefetchPipe >= 0) fds[count++] = (struct pollfd){ .fd = prefetchPipe, .events = POLLIN };
+        if (poolPipe >= 0) fds[count++] = (struct pollfd){ .fd = poolPipe, .events = POLLIN };
+
+        int timeout = jobFd >= 0 ? JOB_POLL_MS : -1;
+        if (refreshDue) {
+            long long remaining = refreshDue - monotonicMs();
+            if (remaining < 0) remaining = 0;
+            if (timeout < 0 || remaining < timeout) timeout = (int)remaining;
+        }
+        poll(fds, count, timeout);
+
+        // 미리 가져온 상세 정보는 화면과 관계없으므로 캐시에 넣기만 함
+        prefetchCollect();
+        // 검색 결과는 도착하는 대로 목록에 채워 보여 줌
+        if (poolCollect()) return KEY_RESULTS_UPDATE;
+        if (watcherConsume()) refreshDue = monotonicMs() + REFRESH_DELAY_MS;
+        if (refreshDue && monotonicMs() >= refreshDue) {
+            refreshDue = 0;
+            return KEY_INVENTORY_UPDATE;
+        }
+        if (jobPump()) return KEY_JOB_UPDATE;
+    }
+}
+
+// 출력 창에 입력 중이면 키를 작업의 터미널로 전달 (sudo 암호 입력 등)
+static void jobInput(int ch) {
+    char byte;
+
+    switch (ch) {
+        case '\t':
+        case KEY_ESCAPE:
+            jobSetInputFocus(false);
+            return;
+        case '\n':
+            byte = '\r';
+            break;
+        case KEY_BACKSPACE:
+        case 127:
+        case '\b':
+            byte = 127;
+            break;
+        default:
+            if (ch < 32 || ch > 126) return;
+            byte = (char)ch;
+            break;
+    }
+    jobSendInput(&byte, 1);
+}
+
+// 맨 아래 줄에서 이름을 입력받아 그 패키지로 이동
+static void jumpToPackage(PackageList *list) {
+    char name[PACKAGE_NAME_SIZE];
+
+    mvprintw(ROWS - 1, 0, "Jump to: ");
+    clrtoeol();
+    echo();
+    getnstr(name, sizeof(name) - 1);
+    noecho();
+
+    if (name[0] == '\0' || listJumpTo(list, name)) return;
+
+    mvprintw(ROWS - 1, 0, "No package named '%s'. Press any key.", name);
+    clrtoeol();
+    refresh();
+    getch();
+}
+
+void keyInput(PackageList *list) {
+    if (!list) {
         return;
     }
     
-    int ch = getch();
-    if (ch == 'g' && *prevCh == 'g') {
-        *currIndex = 0;
-        *prevCh = 0;
+    // 키를 기다리는 동안 커서 주변의 상세 정보를 미리 가져옴
+    prefetchAround(list);
+
+    int ch = readKey();
+    if (ch == KEY_JOB_UPDATE || ch == KEY_RESULTS_UPDATE) {
+        return;
+    }
+    if (ch == KEY_INVENTORY_UPDATE) {
+        // 목록은 다음 listSync에서 커서를 유지한 채 다시 구성
+        refreshInstalled();
+        return;
+    }
+
+    const Job *job = jobCurrent();
+    if (job && job->inputFocus) {
+        jobInput(ch);
+        if (!jobCurrent()->inputFocus) invalidateFrame();
+        return;
+    }
+
+    if (list->filtering) {
+        filterInput(list, ch);
+        return;
+    }
+
+    // 커서 이동 외의 키는 다른 화면을 띄울 수 있으므로 다음 프레임은 전체를 다시 그림
+    if (ch != 'j' && ch != 'k' && ch != 'g' && ch != 'G') {
+        invalidateFrame();
+    }
+
+    Package *current = listCurrent(list);
+    // 멀리 건너뛰면 이전 위치 주변의 미리 가져오기는 쓸모없음
+    if ((ch == 'g' && list->prevCh == 'g') || ch == 'G' || ch == ':') {
+        prefetchCancel();
+    }
+
+    if (ch == 'g' && list->prevCh == 'g') {
+        list->currIndex = 0;
+        list->prevCh = 0;
     } else {
         switch (ch) {
             case 'j':
-                if (*currIndex < packageCount - 1) (*currIndex)++;
+                if (list->currIndex < list->viewCount - 1) list->currIndex++;
                 break;
             case 'k':
-                if (*currIndex > 0) (*currIndex)--;
+                if (list->currIndex > 0) list->currIndex--;
                 break;
             case 'G':
-                *currIndex = packageCount - 1;
+                if (list->viewCount > 0) list->currIndex = list->viewCount - 1;
                 break;
             case '\n':
-                displayPackagesDetail(&p[*currIndex]);
+                if (current) displayPackagesDetail(current);
                 break;
             case '/':
+                list->filtering = true;
+                break;
+            case KEY_ESCAPE:
+                if (list->filterLength > 0) listSetFilter(list, "");
+                break;
+            case 's':
                 searchPackage();
                 break;
             case 'i':
-                managePackage(&p[*currIndex], ACTION_INSTALL);
+                if (current) managePackage(current, ACTION_INSTALL);
                 break;
             case 'd':
-                managePackage(&p[*currIndex], ACTION_REMOVE);
+                if (current) removePackage(current);
+                break;
+            case 'w':
+                if (current) showWhyInstalled(current);
                 break;
             case 'u':
                 managePackage(NULL, ACTION_UPDATE);
                 break;
+            case 'U':
+                showUpgradable();
+                break;
+            case '+':
+            case '-':
+                // 표시 후 다음 패키지로 이동해 연속으로 표시할 수 있게 함
+                listToggleMark(list, ch == '+' ? PKG_MARK_INSTALL : PKG_MARK_REMOVE);
+                if (list->currIndex < list->viewCount - 1) list->currIndex++;
+                break;
+            case 'c':
+                commitMarks(list);
+                break;
+            case ':':
+                jumpToPackage(list);
+                break;
+            case 'o':
+                jobToggleHidden();
+                break;
+            case 'T':
+                traceToggleOverlay();
+                break;
+            case 'x':
+                jobCancel();
+                break;
+            case '\t':
+                jobSetInputFocus(true);
+                break;
             case 'q':
-                *exitFlag = 1;
+                list->exitFlag = 1;
                 break;
             default:
                 break;
         }
-        *prevCh = ch;
+        list->prevCh = ch;
     }
 }
-
-
@@ -3,15 +3,18 @@
 
 #include <stdbool.h>
 #include "package_manager.h"
+#include "package_list.h"
 
 extern int ROWS, COLS;
 
 void init();
-void deinit(Package *p, int packageCount);
+void updateScreenSize(void);
+void deinit(PackageStore *store);
 char *safeStrdup(const char *str);
 void safeFree(char **ptr);
-void getMaxLen(Package *p, int packageCount, int *maxNameLen, int *maxVersionLen);
-void keyInput(int *currIndex, int *startIndex, int *prevCh, int *exitFlag, int packageCount, Package *p);
+void keyInput(PackageList *list);
 bool isValidPackageName(const char *name);
+bool isValidSearchQuery(const char *query);
+bool isValidVersion(const char *version);
 
 #endif // UTILS_H
@@ -0,0 +1,97 @@
+#include <stdbool.h>
+#include <string.h>
+#include "version.h"
+
+static inline int isDigit(char c) {
+    return c >= '0' && c <= '9';
+}
+
+static inline int isAlpha(char c) {
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+}
+
+// 숫자가 아닌 부분의 문자 순서: '~' < 끝 < 영문 < 그 밖의 문자
+static inline int charOrder(char c) {
+    if (isDigit(c)) return 0;
+    if (isAlpha(c)) return (unsigned char)c;
+    if (c == '~') return -1;
+    if (c) return (unsigned char)c + 256;
+    return 0;
+}
+
+// 업스트림 또는 리비전 비교: 숫자가 아닌 부분과 숫자 부분을 번갈아 비교 (숫자는 앞의 0을 무시하고 값으로)
+static int compareSegment(const char *a, const char *aEnd, const char *b, const char *bEnd) {
+    while (a < aEnd || b < bEnd) {
+        int firstDiff = 0;
+
+        while ((a < aEnd && !isDigit(*a)) || (b < bEnd && !isDigit(*b))) {
+            int ac = a < aEnd ? charOrder(*a) : 0;
+            int bc = b < bEnd ? charOrder(*b) : 0;
+            if (ac != bc) return ac - bc;
+            // 같으면 둘 다 숫자도 끝도 아닌 문자
+            a++;
+            b++;
+        }
+
+        while (a < aEnd && *a == '0') a++;
+        while (b < bEnd && *b == '0') b++;
+        while (a < aEnd && isDigit(*a) && b < bEnd && isDigit(*b)) {
+            if (!firstDiff) firstDiff = *a - *b;
+            a++;
+            b++;
+        }
+        // 자릿수가 많은 쪽이 큼
+        if (a < aEnd && isDigit(*a)) return 1;
+        if (b < bEnd && isDigit(*b)) return -1;
+        if (firstDiff) return firstDiff;
+    }
+    return 0;
+}
+
+typedef struct VersionParts {
+    unsigned long epoch;
+    const char *upstream;
+    const char *upstreamEnd;
+    const char *revision;       // 리비전이 없으면 빈 구간 ("0"과 같음)
+    const char *revisionEnd;
+} VersionParts;
+
+static void splitVersion(const char *version, VersionParts *parts) {
+    const char *end = version + strlen(version);
+    const char *colon = strchr(version, ':');
+    const char *hyphen = NULL;
+
+    parts->epoch = 0;
+    parts->upstream = version;
+    if (colon) {
+        for (const char *p = version; p < colon; p++) {
+            if (isDigit(*p)) parts->epoch = parts->epoch * 10 + (unsigned long)(*p - '0');
+        }
+        parts->upstream = colon + 1;
+    }
+
+    // 리비전은 마지막 '-' 뒤 (업스트림 버전에는 '-'가 들어갈 수 있음)
+    for (const char *p = parts->upstream; p < end; p++) {
+        if (*p == '-') hyphen = p;
+    }
+    parts->upstreamEnd = hyphen ? hyphen : end;
+    parts->revision = hyphen ? hyphen + 1 : end;
+    parts->revisionEnd = end;
+}
+
+int versionCompare(const char *a, const char *b) {
+    VersionParts pa, pb;
+
+    // dpkg처럼 빈 버전은 '~'로 시작하는 버전보다도 앞
+    bool aEmpty = !a || !*a, bEmpty = !b || !*b;
+    if (aEmpty || bEmpty) return bEmpty - aEmpty;
+
+    splitVersion(a, &pa);
+    splitVersion(b, &pb);
+
+    if (pa.epoch != pb.epoch) return pa.epoch < pb.epoch ? -1 : 1;
+
+    int result = compareSegment(pa.upstream, pa.upstreamEnd, pb.upstream, pb.upstreamEnd);
+    if (result) return result;
+    return compareSegment(pa.revision, pa.revisionEnd, pb.revision, pb.revisionEnd);
+}
@@ -0,0 +1,10 @@
+#ifndef VERSION_H
+#define VERSION_H
+
+#include <stddef.h>
+
+// dpkg와 같은 Debian 버전 비교 ([에포크:]업스트림[-리비전], '~'는 빈 문자열보다도 앞)
+// a < b이면 음수, 같으면 0, a > b이면 양수. NULL·빈 문자열은 가장 낮은 버전 (설치되지 않음)
+int versionCompare(const char *a, const char *b);
+
+#endif // VERSION_H
@@ -0,0 +1,63 @@
+#include <stdio.h>
+#include <string.h>
+#include <limits.h>
+#include <unistd.h>
+#include <sys/inotify.h>
+#include "watcher.h"
+#include "constants.h"
+
+static int watchFd = -1;
+static char watchName[NAME_MAX + 1];
+
+bool watcherStart(const char *path) {
+    char directory[PATH_BUFFER_SIZE];
+    const char *slash = strrchr(path, '/');
+
+    if (slash) {
+        snprintf(directory, sizeof(directory), "%.*s", (int)(slash - path), path);
+        if (directory[0] == '\0') snprintf(directory, sizeof(directory), "/");
+        snprintf(watchName, sizeof(watchName), "%s", slash + 1);
+    } else {
+        snprintf(directory, sizeof(directory), ".");
+        snprintf(watchName, sizeof(watchName), "%s", path);
+    }
+
+    watcherStop();
+    watchFd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (watchFd < 0) return false;
+
+    if (inotify_add_watch(watchFd, directory, IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE) < 0) {
+        watcherStop();
+        return false;
+    }
+    return true;
+}
+
+int watcherFd(void) {
+    return watchFd;
+}
+
+// 쌓인 이벤트를 모두 읽고, 감시 대상 파일에 대한 이벤트가 있었으면 true
+bool watcherConsume(void) {
+    char buffer[4096] __attribute__((aligned(__alignof__(struct inotify_event))));
+    bool changed = false;
+    ssize_t n;
+
+    if (watchFd < 0) return false;
+
+    while ((n = read(watchFd, buffer, sizeof(buffer))) > 0) {
+        for (char *p = buffer; p < buffer + n; ) {
+            const struct inotify_event *event = (const struct inotify_event *)p;
+            if (event->len > 0 && strcmp(event->name, watchName) == 0) changed = true;
+            // 감시 디렉터리 이벤트 큐가 넘치면 어떤 변경이 있었는지 알 수 없으므로 변경으로 간주
+            if (event->mask & IN_Q_OVERFLOW) changed = true;
+            p += sizeof(struct inotify_event) + event->len;
+        }
+    }
+    return changed;
+}
+
+void watcherStop(void) {
+    if (watchFd >= 0) close(watchFd);
+    watchFd = -1;
+}
@@ -0,0 +1,12 @@
+#ifndef WATCHER_H
+#define WATCHER_H
+
+#include <stdbool.h>
+
+// dpkg status 파일이 바뀌는지 inotify로 감시 (dpkg는 status-new를 rename 하므로 디렉터리를 감시)
+bool watcherStart(const char *path);
+int watcherFd(void);
+bool watcherConsume(void);
+void watcherStop(void);
+
+#endif // WATCHER_H